@@ -16,15 +16,20 @@
 #include <gip/Image.h>
 #include <gip/Pixel.h>
 #include <base/Iterator.h>
-#include <base/iterator/MatrixRowIterator.h>
+#include <gip/ImageBuffer.h>
+#include <gip/CopyOnWriteMonitor.h>
+#include <gip/StridedRowIterator.h>
 #include <base/iterator/MatrixColumnIterator.h>
-#include <base/mem/ReferenceCountedAllocator.h>
 #include <base/mem/Reference.h>
+#include <utility>
 
 namespace gip {
 
 /**
-  An image with the elements stored in an array.
+  An image with the elements stored in an array. The rows are stored one after
+  another. By default the rows are packed (i.e. the pitch equals the width of
+  the image) but the rows may be padded to let each row start at an aligned
+  address. Row i starts at getElements() + i * getPitch().
   
   @short Image containing the image elements in an array for random access.
   @ingroup images
@@ -37,17 +42,65 @@ public:
 
   /** The type of the pixels. */
   typedef typename Image<PIXEL>::Pixel Pixel;
+
+  /** The alignment in bytes suitable for vector loads and stores of full rows. */
+  static constexpr unsigned int ROW_ALIGNMENT = 64;
 private:
   
   /** The elements of the image. */
-  Reference<ReferenceCountedAllocator<Pixel> > elements;
+  Reference<ImageBuffer<Pixel> > elements;
+  /** The distance in elements between the first elements of consecutive rows. */
+  unsigned int pitch = 0;
+
+  /**
+    Returns the smallest pitch not less than the specified width for which
+    every row starts at a multiple of the specified alignment.
+  */
+  static inline unsigned int getAlignedPitch(unsigned int width, unsigned int alignment) noexcept {
+    if (alignment <= 1) {
+      return width;
+    }
+    const MemorySize lowestBit = sizeof(Pixel) & (~static_cast<MemorySize>(sizeof(Pixel)) + 1);
+    const unsigned int step = alignment/((lowestBit < alignment) ? lowestBit : alignment);
+    return (width + step - 1)/step * step;
+  }
+
+  /**
+    Prepares the elements for modifying access. Shared elements are copied.
+    External elements are copied into memory for copy-on-write data and raise
+    ImageException for read-only data. Copies are registered with
+    CopyOnWriteMonitor.
+
+    @param site The method requesting modifying access.
+  */
+  void detach(const char* site) {
+    const Pixel* previous = elements->getElements();
+    if (!elements->isWriteable()) {
+      bassert(
+        elements->getAccess() == RawImageData::COPY_ON_WRITE,
+        ImageException("Image is read-only", this)
+      );
+      elements = new ImageBuffer<Pixel>(*elements);
+    } else {
+      elements.copyOnWrite();
+    }
+    if (elements->getElements() != previous) {
+      CopyOnWriteMonitor::onCopy(elements->getSize() * sizeof(Pixel), site);
+    }
+  }
+
+  /**
+    Returns the pitch in elements of the external data. Raises ImageException
+    if the layout is incompatible with the pixel type.
+  */
+  static unsigned int getDataPitch(const RawImageData& data);
 public:
 
   template<class TRAITS = IteratorTraits<Pixel> >
   class RowsImpl : public Iterator<TRAITS> {
   public:
 
-    typedef MatrixRowIterator<TRAITS> RowIterator;
+    typedef StridedRowIterator<TRAITS> RowIterator;
     typedef typename Iterator<TRAITS>::Pointer Pointer;
   private:
 
@@ -58,6 +111,10 @@ public:
     inline RowsImpl(Pointer value, const Dimension& dimension) noexcept :
       first(value, dimension.getWidth()), rows(dimension.getHeight()) {
     }
+
+    inline RowsImpl(Pointer value, const Dimension& dimension, unsigned int pitch) noexcept :
+      first(value, dimension.getWidth(), pitch), rows(dimension.getHeight()) {
+    }
     
     inline RowsImpl(const RowsImpl& copy) noexcept
       : first(copy.first), rows(copy.rows) {
@@ -101,6 +158,14 @@ public:
     inline ColumnsImpl(Pointer value, const Dimension& dimension) noexcept :
       first(value, dimension), columns(dimension.getWidth()) {
     }
+
+    /**
+      The column iterator steps down by the width of the given dimension so the
+      pitch is used as the width here.
+    */
+    inline ColumnsImpl(Pointer value, const Dimension& dimension, unsigned int pitch) noexcept :
+      first(value, Dimension(pitch, dimension.getHeight())), columns(dimension.getWidth()) {
+    }
     
     inline ColumnsImpl(const ColumnsImpl& copy) noexcept
       : first(copy.first), columns(copy.columns) {
@@ -136,31 +201,110 @@ public:
   */
   ArrayImage(const Dimension& dimension);
 
+  /**
+    Initializes the image to the specified dimension with every row starting
+    at a multiple of the specified alignment. The rows are padded as required.
+    The elements are not initialized.
+
+    @param dimension The desired dimension of the image.
+    @param alignment The alignment of the rows in bytes (e.g. ROW_ALIGNMENT). Must be a power of 2.
+  */
+  ArrayImage(const Dimension& dimension, unsigned int alignment);
+
+  /**
+    Initializes the image to the specified dimension with the elements drawn
+    from the specified pool. The elements are returned to the pool when no
+    longer used by any image. The elements are not initialized.
+
+    @param dimension The desired dimension of the image.
+    @param alignment The alignment of the rows in bytes. Must be 0 or a power of 2.
+    @param pool The pool.
+  */
+  ArrayImage(const Dimension& dimension, unsigned int alignment, const Reference<ImageBufferPool>& pool);
+
+  /**
+    Initializes the image using external pixel data (e.g. a MappedImageFile).
+    The data is used in place as the elements and the pixels are not read
+    until accessed. Row i of the image is row i of the data so the image is
+    upside down for top-down data (see RawImageLayout::bottomUp). Modifying
+    access follows the access policy of the data. Raises ImageException if
+    the pixel size, pitch, or alignment of the pixel data does not suit the
+    pixel type.
+
+    @param data The pixel data.
+  */
+  ArrayImage(const Reference<RawImageData>& data);
+
   /**
     Initializes the image from other image.
   */
   ArrayImage(const ArrayImage& copy) noexcept;
 
+  /**
+    Initializes the image from other image without touching the reference
+    count of the elements. The other image may only be destroyed or assigned
+    afterwards.
+  */
+  ArrayImage(ArrayImage&& move) noexcept;
+
   ArrayImage& operator=(const ArrayImage& eq) noexcept {
     Image<Pixel>::operator=(eq);
     elements = eq.elements;
+    pitch = eq.pitch;
     return *this;
   }
+
+  /**
+    Takes over the elements of the other image. The other image may only be
+    destroyed or assigned afterwards.
+  */
+  ArrayImage& operator=(ArrayImage&& move) noexcept {
+    if (&move != this) {
+      Image<Pixel>::operator=(std::move(move));
+      elements = std::move(move.elements);
+      pitch = move.pitch;
+      move.pitch = 0;
+    }
+    return *this;
+  }
+
+  /**
+    Returns the distance in elements between the first elements of
+    consecutive rows. The pitch is never less than the width.
+  */
+  inline unsigned int getPitch() const noexcept {
+    return pitch;
+  }
+
+  /**
+    Returns true if the rows are stored without padding.
+  */
+  inline bool isPacked() const noexcept {
+    return pitch == Image<PIXEL>::getWidth();
+  }
+
+  /**
+    Returns the alignment in bytes of the first element.
+  */
+  inline unsigned int getAlignment() const noexcept {
+    return elements->getAlignment();
+  }
   
   /**
     Returns the rows of the image for modifying access. This will force the
-    image to be copied if shared by multiple image objects.
+    image to be copied if shared by multiple image objects (see
+    CopyOnWriteMonitor).
   */
   Rows getRows()  {
-    elements.copyOnWrite();
-    return Rows(elements->getElements(), Image<PIXEL>::getDimension());
+    detach("ArrayImage::getRows");
+    return Rows(elements->getElements(), Image<PIXEL>::getDimension(), pitch);
   }
 
   /**
     Returns the rows of the image for non-modifying access.
   */
   ReadableRows getRows() const noexcept {
-    return ReadableRows(elements->getElements(), Image<PIXEL>::getDimension());
+    return ReadableRows(elements->getElements(), Image<PIXEL>::getDimension(), pitch);
   }
 
   /**
@@ -168,20 +312,21 @@ public:
     image to be copied if shared by multiple image objects.
   */
   Columns getColumns()  {
-    elements.copyOnWrite();
-    return Columns(elements->getElements(), Image<PIXEL>::getDimension());
+    detach("ArrayImage::getColumns");
+    return Columns(elements->getElements(), Image<PIXEL>::getDimension(), pitch);
   }
 
   /**
     Returns the rows of the image for non-modifying access.
   */
   ReadableColumns getColumns() const noexcept {
-    return ReadableColumns(elements->getElements(), Image<PIXEL>::getDimension());
+    return ReadableColumns(elements->getElements(), Image<PIXEL>::getDimension(), pitch);
   }
 
   /**
     Returns the first element of the image for modifying access. This will
-    force the image to be copied if shared by multiple image objects.
+    force the image to be copied if shared by multiple image objects. Row i
+    starts at getElements() + i * getPitch().
   */
   Pixel* getElements();
 
@@ -193,22 +338,65 @@ public:
 
 template<class PIXEL>
 ArrayImage<PIXEL>::ArrayImage()  :
-  Image<PIXEL>(Dimension(0, 0)), elements(new ReferenceCountedAllocator<Pixel>(0)) {
+  Image<PIXEL>(Dimension(0, 0)), elements(new ImageBuffer<Pixel>(0)) {
 }
 
 template<class PIXEL>
 ArrayImage<PIXEL>::ArrayImage(const Dimension& dimension)  :
-  Image<Pixel>(dimension), elements(new ReferenceCountedAllocator<Pixel>(dimension.getSize())) {
+  Image<Pixel>(dimension), elements(new ImageBuffer<Pixel>(static_cast<MemorySize>(dimension.getWidth()) * dimension.getHeight())), pitch(dimension.getWidth()) {
+}
+
+template<class PIXEL>
+ArrayImage<PIXEL>::ArrayImage(const Dimension& dimension, unsigned int alignment)  :
+  Image<Pixel>(dimension), pitch(getAlignedPitch(dimension.getWidth(), alignment)) {
+  bassert((alignment & (alignment - 1)) == 0, ImageException("Invalid alignment", this));
+  elements = new ImageBuffer<Pixel>(static_cast<MemorySize>(pitch) * dimension.getHeight(), alignment);
+}
+
+template<class PIXEL>
+ArrayImage<PIXEL>::ArrayImage(const Dimension& dimension, unsigned int alignment, const Reference<ImageBufferPool>& pool)  :
+  Image<Pixel>(dimension), pitch(getAlignedPitch(dimension.getWidth(), alignment)) {
+  bassert((alignment & (alignment - 1)) == 0, ImageException("Invalid alignment", this));
+  elements = new ImageBuffer<Pixel>(static_cast<MemorySize>(pitch) * dimension.getHeight(), alignment, pool);
+}
+
+template<class PIXEL>
+unsigned int ArrayImage<PIXEL>::getDataPitch(const RawImageData& data) {
+  const RawImageLayout& layout = data.getLayout();
+  bassert(
+    (layout.bytesPerPixel == sizeof(Pixel)) &&
+    (layout.pitch % sizeof(Pixel) == 0) &&
+    (layout.pitch/sizeof(Pixel) <= PrimitiveTraits<unsigned int>::MAXIMUM) &&
+    (reinterpret_cast<MemorySize>(data.getBytes()) % alignof(Pixel) == 0),
+    ImageException("Incompatible image layout")
+  );
+  return static_cast<unsigned int>(layout.pitch/sizeof(Pixel));
+}
+
+template<class PIXEL>
+ArrayImage<PIXEL>::ArrayImage(const Reference<RawImageData>& data)  :
+  Image<Pixel>(data->getLayout().dimension), pitch(getDataPitch(*data)) {
+  const Dimension& dimension = Image<Pixel>::getDimension();
+  elements = new ImageBuffer<Pixel>(
+    data,
+    (dimension.getHeight() > 0) ? (static_cast<MemorySize>(pitch) * (dimension.getHeight() - 1) + dimension.getWidth()) : 0
+  );
 }
 
 template<class PIXEL>
 ArrayImage<PIXEL>::ArrayImage(const ArrayImage& copy) noexcept :
-  Image<Pixel>(copy), elements(copy.elements) {
+  Image<Pixel>(copy), elements(copy.elements), pitch(copy.pitch) {
+}
+
+template<class PIXEL>
+ArrayImage<PIXEL>::ArrayImage(ArrayImage&& move) noexcept :
+  Image<Pixel>(std::move(move)), elements(std::move(move.elements)), pitch(move.pitch) {
+  move.pitch = 0;
 }
 
 template<class PIXEL>
 typename ArrayImage<PIXEL>::Pixel* ArrayImage<PIXEL>::getElements()  {
-  elements.copyOnWrite();
+  detach("ArrayImage::getElements");
   return elements->getElements();
 }
 
@@ -218,6 +406,7 @@ const typename ArrayImage<PIXEL>::Pixel* ArrayImage<PIXEL>::getElements() const
 }
 
 typedef ArrayImage<GrayPixel> GrayImage;
+typedef ArrayImage<Gray8Pixel> Gray8Image;
 typedef ArrayImage<ColorPixel> ColorImage;
 typedef ArrayImage<ColorAlphaPixel> ColorAlphaImage;
 typedef ArrayImage<float> FloatImage;
@@ -0,0 +1,340 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#pragma once
+
+#include <gip/gip.h>
+#include <gip/Region.h>
+#include <gip/ImageException.h>
+#include <base/mem/Allocator.h>
+
+namespace gip {
+
+  /**
+    Specifies how neighborhood operations (e.g. Convolution3x3, Erode3x3,
+    Dilate, MedianFilter3x3 and Gradient) extend the source image beyond its
+    edges. With the mode NONE the pixels of the destination image closer to
+    the edges than the halo are not modified.
+
+    WRAP reads the opposite edge of the source image and must not be used
+    for a stage of a Pipeline which reads an intermediate image.
+
+    @short Border handling of neighborhood operations.
+    @ingroup transformations
+    @see BorderRows
+    @version 1.0
+  */
+
+  class Border {
+  public:
+
+    /** The border modes. */
+    enum Mode {
+      NONE, /**< The border of the destination image is not modified. */
+      CONSTANT, /**< Pixels outside the image have a constant value (e.g. iii|abcd|iii). */
+      REPLICATE, /**< The edge pixels are repeated (e.g. aaa|abcd|ddd). */
+      REFLECT, /**< The image is mirrored at the edge pixels (e.g. dcb|abcd|cba). */
+      WRAP /**< The image is periodic (e.g. bcd|abcd|abc). */
+    };
+
+    /**
+      Returns the index within [0; size) of the pixel used for the specified
+      row or column. The mode must be REPLICATE, REFLECT or WRAP.
+
+      @param index The row or column (may be outside the image).
+      @param size The number of rows or columns of the image (must be positive).
+      @param mode The border mode.
+    */
+    static inline int map(int index, int size, Mode mode) noexcept {
+      if ((index >= 0) && (index < size)) {
+        return index;
+      }
+      switch (mode) {
+      case REFLECT:
+        if (size == 1) {
+          return 0;
+        } else {
+          const int period = 2 * (size - 1);
+          index %= period;
+          if (index < 0) {
+            index += period;
+          }
+          return (index < size) ? index : (period - index);
+        }
+      case WRAP:
+        index %= size;
+        return (index < 0) ? (index + size) : index;
+      default: // REPLICATE
+        return (index < 0) ? 0 : (size - 1);
+      }
+    }
+
+    /**
+      Returns the rows and columns of the specified region of the destination
+      image which a neighborhood operation calculates. For NONE the region is
+      limited to the pixels at least halo pixels from the edges.
+    */
+    static inline Region getRegion(const Region& region, const Dimension& dimension, unsigned int halo, Mode mode) noexcept {
+      if (mode != NONE) {
+        return region;
+      }
+      const unsigned int width = dimension.getWidth();
+      const unsigned int height = dimension.getHeight();
+      if ((width <= 2 * halo) || (height <= 2 * halo)) {
+        return Region();
+      }
+      const unsigned int firstRow = maximum<unsigned int>(region.getOffset().getRow(), halo);
+      const unsigned int endRow = minimum<unsigned int>(region.getEndRow(), height - halo);
+      const unsigned int firstColumn = maximum<unsigned int>(region.getOffset().getColumn(), halo);
+      const unsigned int endColumn = minimum<unsigned int>(region.getEndColumn(), width - halo);
+      if ((firstRow >= endRow) || (firstColumn >= endColumn)) {
+        return Region();
+      }
+      return Region(Point2D(firstRow, firstColumn), Dimension(endColumn - firstColumn, endRow - firstRow));
+    }
+  };
+
+  /**
+    The rows around a row of an image extended by halo pixels on every side
+    according to a border mode. Each row of the window is copied from the
+    image once and padded with halo columns. Thus a neighborhood operation
+    reads the columns [-halo; columns + halo) relative to the first column of
+    the rows [-halo; halo] without any tests for the edges. Moving to the
+    next row copies a single row.
+
+    Only the columns of the range used by the operation (e.g. a tile) and
+    the halo around it are copied. The border mode is applied to the columns
+    outside the image only.
+
+    @code
+    BorderRows<SourceImage> rows(*source, firstColumn, endColumn, 1, Border::REPLICATE);
+    for (unsigned int row = firstRow; row < endRow; ++row) {
+      rows.seek(row);
+      const Pixel* previous = rows.getRow(-1); // column firstColumn of the row above
+      const Pixel* current = rows.getRow(0);
+      const Pixel* next = rows.getRow(1);
+      ...
+    }
+    @endcode
+
+    @short Padded rows of an image.
+    @ingroup transformations
+    @see Border
+    @version 1.0
+  */
+
+  template<class IMAGE>
+  class BorderRows {
+  public:
+
+    typedef typename IMAGE::Pixel Pixel;
+  private:
+
+    /** The rows of the image. */
+    typename IMAGE::ReadableRows rows;
+    /** The width of the image. */
+    const int width = 0;
+    /** The height of the image. */
+    const int height = 0;
+    /** The first column of the range. */
+    const int firstColumn = 0;
+    /** The end of the column range. */
+    const int endColumn = 0;
+    /** The number of rows and columns added on each side. */
+    const int halo = 0;
+    /** The border mode. */
+    const Border::Mode mode = Border::REPLICATE;
+    /** The value of the pixels outside the image for CONSTANT. */
+    const Pixel constant;
+    /** The number of elements per padded row. */
+    const MemorySize stride = 0;
+    /** The padded rows (the ring of 2 * halo + 1 rows followed by the constant row). */
+    Allocator<Pixel> buffer;
+    /** The padded rows of the window. */
+    Allocator<const Pixel*> window;
+    /** The current row. */
+    int current = 0;
+    /** Specifies that the window holds the rows around the current row. */
+    bool loaded = false;
+
+    /** Returns the padded row of the ring for the specified row. */
+    inline Pixel* getSlot(int row) noexcept {
+      const int size = 2 * halo + 1;
+      int slot = row % size;
+      if (slot < 0) {
+        slot += size;
+      }
+      return buffer.getElements() + slot * stride;
+    }
+
+    /** Copies and pads the column range of the specified row (which may be outside the image). */
+    const Pixel* load(int row) noexcept {
+      if ((mode == Border::CONSTANT) && ((row < 0) || (row >= height))) {
+        return buffer.getElements() + (2 * halo + 1) * stride;
+      }
+      Pixel* const result = getSlot(row);
+      Pixel* dest = result;
+      const int sourceRow = (mode == Border::CONSTANT) ? row : Border::map(row, height, mode);
+      typename IMAGE::ReadableRows::RowIterator::ElementIterator src = rows[sourceRow].getFirst();
+      const int begin = firstColumn - halo;
+      const int end = endColumn + halo;
+      const int first = maximum(begin, 0);
+      const int last = minimum(end, width);
+      for (int column = begin; column < first; ++column) { // crosses the left edge
+        *dest++ = (mode == Border::CONSTANT) ? constant : src[Border::map(column, width, mode)];
+      }
+      for (int column = first; column < last; ++column) {
+        *dest++ = src[column];
+      }
+      for (int column = last; column < end; ++column) { // crosses the right edge
+        *dest++ = (mode == Border::CONSTANT) ? constant : src[Border::map(column, width, mode)];
+      }
+      return result;
+    }
+  public:
+
+    /**
+      Initializes the rows for the specified range of columns.
+
+      @param image The image (must not be empty).
+      @param firstColumn The first column used by the operation.
+      @param endColumn The end of the columns used by the operation (at most the width).
+      @param halo The number of rows and columns added on each side.
+      @param mode The border mode. NONE is handled like REPLICATE.
+      @param constant The value of the pixels outside the image for CONSTANT.
+    */
+    BorderRows(
+      const IMAGE& image,
+      unsigned int _firstColumn,
+      unsigned int _endColumn,
+      unsigned int _halo,
+      Border::Mode _mode,
+      const Pixel& _constant = Pixel())
+      : rows(image.getRows()),
+        width(image.getWidth()),
+        height(image.getHeight()),
+        firstColumn(_firstColumn),
+        endColumn(_endColumn),
+        halo(_halo),
+        mode((_mode == Border::NONE) ? Border::REPLICATE : _mode),
+        constant(_constant),
+        stride((_endColumn - _firstColumn) + 2 * _halo),
+        buffer((2 * _halo + 2) * stride),
+        window(2 * _halo + 1) {
+      bassert((width > 0) && (height > 0), ImageException("Image is empty"));
+      bassert(
+        (_firstColumn < _endColumn) && (_endColumn <= image.getWidth()),
+        ImageException("Invalid column range")
+      );
+      Pixel* constantRow = buffer.getElements() + (2 * halo + 1) * stride;
+      for (MemorySize i = 0; i < stride; ++i) {
+        constantRow[i] = constant;
+      }
+    }
+
+    /**
+      Initializes the rows for all the columns of the image.
+
+      @param image The image (must not be empty).
+      @param halo The number of rows and columns added on each side.
+      @param mode The border mode. NONE is handled like REPLICATE.
+      @param constant The value of the pixels outside the image for CONSTANT.
+    */
+    inline BorderRows(const IMAGE& image, unsigned int halo, Border::Mode mode, const Pixel& constant = Pixel())
+      : BorderRows(image, 0, image.getWidth(), halo, mode, constant) {
+    }
+
+    /**
+      Returns the number of rows and columns added on each side.
+    */
+    inline unsigned int getHalo() const noexcept {
+      return halo;
+    }
+
+    /**
+      Moves the window to the specified row. Moving to the next row loads
+      one row only.
+    */
+    void seek(unsigned int row) noexcept {
+      const int size = 2 * halo + 1;
+      const Pixel** rows = window.getElements();
+      if (loaded && (static_cast<int>(row) == (current + 1))) {
+        for (int i = 1; i < size; ++i) {
+          rows[i - 1] = rows[i];
+        }
+        rows[size - 1] = load(static_cast<int>(row) + halo);
+      } else {
+        for (int i = 0; i < size; ++i) {
+          rows[i] = load(static_cast<int>(row) - halo + i);
+        }
+      }
+      current = row;
+      loaded = true;
+    }
+
+    /**
+      Returns the first column of the range of the row at the specified
+      offset within [-halo; halo] from the current row. The columns
+      [-halo; endColumn - firstColumn + halo) relative to the first column
+      are valid.
+    */
+    inline const Pixel* getRow(int offset) const noexcept {
+      return window.getElements()[halo + offset] + halo;
+    }
+  };
+
+  /**
+    Calculates the specified region of the destination image by a 3x3
+    neighborhood operation. The operation is invoked for each pixel with
+    pointers to the pixel in the padded rows above, at and below the pixel
+    (see BorderRows) and returns the destination pixel.
+
+    @param destination The destination image.
+    @param source The source image.
+    @param region The region of the destination image.
+    @param mode The border mode.
+    @param constant The value of the pixels outside the source image for Border::CONSTANT.
+    @param operation The operation.
+  */
+  template<class DEST, class SRC, class OPERATION>
+  void applyNeighborhood(
+    DEST& destination,
+    const SRC& source,
+    const Region& region,
+    Border::Mode mode,
+    const typename SRC::Pixel& constant,
+    const OPERATION& operation) {
+    const Region calculate = Border::getRegion(region, source.getDimension(), 1, mode);
+    if (!calculate.isProper()) {
+      return;
+    }
+    const unsigned int firstColumn = calculate.getOffset().getColumn();
+    const unsigned int columns = calculate.getDimension().getWidth();
+
+    typedef typename SRC::Pixel Pixel;
+    typename DEST::Rows::RowIterator destRow = destination.getRows().getFirst();
+    destRow += calculate.getOffset().getRow();
+    BorderRows<SRC> rows(source, firstColumn, calculate.getEndColumn(), 1, mode, constant);
+    for (unsigned int row = calculate.getOffset().getRow(); row < calculate.getEndRow(); ++row, ++destRow) {
+      rows.seek(row);
+      const Pixel* previous = rows.getRow(-1);
+      const Pixel* current = rows.getRow(0);
+      const Pixel* next = rows.getRow(1);
+      typename DEST::Rows::RowIterator::ElementIterator dest = destRow.getFirst() + firstColumn;
+      for (unsigned int count = columns; count > 0; --count) {
+        *dest++ = operation(previous++, current++, next++);
+      }
+    }
+  }
+
+}; // end of gip namespace
@@ -0,0 +1,235 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#include <gip/CPUDispatch.h>
+#include <gip/ImageException.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_COM_AZURE_DEV__GIP__SIMD_X86)
+#  if defined(_MSC_VER)
+#    include <intrin.h>
+#  else
+#    include <cpuid.h>
+#  endif
+#endif
+
+namespace gip {
+
+  namespace {
+
+#if defined(_COM_AZURE_DEV__GIP__SIMD_X86)
+    /** Executes CPUID for the specified leaf. The registers are EAX, EBX, ECX and EDX. */
+    void cpuid(unsigned int leaf, unsigned int subleaf, unsigned int* registers) noexcept {
+#  if defined(_MSC_VER)
+      int result[4];
+      __cpuidex(result, leaf, subleaf);
+      for (unsigned int i = 0; i < 4; ++i) {
+        registers[i] = static_cast<unsigned int>(result[i]);
+      }
+#  else
+      __cpuid_count(leaf, subleaf, registers[0], registers[1], registers[2], registers[3]);
+#  endif
+    }
+
+    /** Returns the register states enabled by the operating system (XCR0). */
+    uint64 getEnabledStates() noexcept {
+#  if defined(_MSC_VER)
+      return _xgetbv(0);
+#  else
+      unsigned int eax = 0;
+      unsigned int edx = 0;
+      __asm__ volatile ("xgetbv" : "=a" (eax), "=d" (edx) : "c" (0));
+      return (static_cast<uint64>(edx) << 32) | eax;
+#  endif
+    }
+#endif
+
+    unsigned int detectFeatures() noexcept {
+      unsigned int result = 0;
+#if defined(_COM_AZURE_DEV__GIP__SIMD_X86)
+      unsigned int registers[4];
+      cpuid(0, 0, registers);
+      const unsigned int maximumLeaf = registers[0];
+      if (maximumLeaf < 1) {
+        return result;
+      }
+      cpuid(1, 0, registers);
+      const unsigned int ecx1 = registers[2];
+      const unsigned int edx1 = registers[3];
+      if (edx1 & (1 << 26)) {
+        result |= CPUDispatch::FEATURE_SSE2;
+      }
+      if (ecx1 & (1 << 9)) {
+        result |= CPUDispatch::FEATURE_SSSE3;
+      }
+      if (ecx1 & (1 << 19)) {
+        result |= CPUDispatch::FEATURE_SSE41;
+      }
+      if (ecx1 & (1 << 20)) {
+        result |= CPUDispatch::FEATURE_SSE42;
+      }
+
+      // the wide registers must also be saved by the operating system
+      const bool osxsave = (ecx1 & (1 << 27)) != 0;
+      const uint64 states = osxsave ? getEnabledStates() : 0;
+      const bool ymm = (states & 0x06) == 0x06; // SSE and AVX state
+      const bool zmm = ymm && ((states & 0xe0) == 0xe0); // opmask and upper ZMM state
+      if (ymm && (ecx1 & (1 << 28))) {
+        result |= CPUDispatch::FEATURE_AVX;
+        if (ecx1 & (1 << 12)) {
+          result |= CPUDispatch::FEATURE_FMA;
+        }
+      }
+      if (maximumLeaf >= 7) {
+        cpuid(7, 0, registers);
+        const unsigned int ebx7 = registers[1];
+        const unsigned int ecx7 = registers[2];
+        if (ebx7 & (1 << 8)) {
+          result |= CPUDispatch::FEATURE_BMI2;
+        }
+        if (ymm && (ebx7 & (1 << 5))) {
+          result |= CPUDispatch::FEATURE_AVX2;
+        }
+        if (zmm) {
+          if (ebx7 & (1 << 16)) {
+            result |= CPUDispatch::FEATURE_AVX512F;
+          }
+          if (ebx7 & (1 << 17)) {
+            result |= CPUDispatch::FEATURE_AVX512DQ;
+          }
+          if (ebx7 & (1 << 30)) {
+            result |= CPUDispatch::FEATURE_AVX512BW;
+          }
+          if (ebx7 & (1U << 31)) {
+            result |= CPUDispatch::FEATURE_AVX512VL;
+          }
+          if (ecx7 & (1 << 1)) {
+            result |= CPUDispatch::FEATURE_AVX512VBMI;
+          }
+        }
+      }
+#endif
+      return result;
+    }
+
+    /** The detected features and the active level. */
+    class State {
+    public:
+
+      unsigned int features = 0;
+      CPUDispatch::Level supported = CPUDispatch::LEVEL_SCALAR;
+      CPUDispatch::Level active = CPUDispatch::LEVEL_SCALAR;
+
+      State() noexcept {
+        features = detectFeatures();
+        const unsigned int sse41 = CPUDispatch::FEATURE_SSE2 | CPUDispatch::FEATURE_SSSE3 | CPUDispatch::FEATURE_SSE41;
+        const unsigned int avx2 = sse41 | CPUDispatch::FEATURE_AVX | CPUDispatch::FEATURE_FMA | CPUDispatch::FEATURE_AVX2;
+        const unsigned int avx512 = avx2 | CPUDispatch::FEATURE_AVX512F | CPUDispatch::FEATURE_AVX512BW |
+          CPUDispatch::FEATURE_AVX512DQ | CPUDispatch::FEATURE_AVX512VL;
+        if ((features & avx512) == avx512) {
+          supported = CPUDispatch::LEVEL_AVX512;
+        } else if ((features & avx2) == avx2) {
+          supported = CPUDispatch::LEVEL_AVX2;
+        } else if ((features & sse41) == sse41) {
+          supported = CPUDispatch::LEVEL_SSE41;
+        } else if (features & CPUDispatch::FEATURE_SSE2) {
+          supported = CPUDispatch::LEVEL_SSE2;
+        }
+        active = supported;
+
+        const char* override = ::getenv("GIP_SIMD");
+        CPUDispatch::Level level = CPUDispatch::LEVEL_SCALAR;
+        if (override && CPUDispatch::parseLevel(override, level) && (level < supported)) {
+          active = level;
+        }
+      }
+    };
+
+    State& getState() noexcept {
+      static State state;
+      return state;
+    }
+  }
+
+  CPUDispatch::Binding::Binding(const char* _name) noexcept : name(_name) {
+    Binding*& bindings = CPUDispatch::getBindings();
+    next = bindings;
+    bindings = this;
+  }
+
+  CPUDispatch::Binding::~Binding() noexcept {
+    Binding** link = &CPUDispatch::getBindings();
+    while (*link) {
+      if (*link == this) {
+        *link = next;
+        break;
+      }
+      link = &(*link)->next;
+    }
+  }
+
+  CPUDispatch::Binding*& CPUDispatch::getBindings() noexcept {
+    static Binding* bindings = nullptr;
+    return bindings;
+  }
+
+  unsigned int CPUDispatch::getFeatures() noexcept {
+    return getState().features;
+  }
+
+  CPUDispatch::Level CPUDispatch::getSupportedLevel() noexcept {
+    return getState().supported;
+  }
+
+  CPUDispatch::Level CPUDispatch::getLevel() noexcept {
+    return getState().active;
+  }
+
+  void CPUDispatch::setLevel(Level level) {
+    State& state = getState();
+    bassert(level <= state.supported, ImageException("Level not supported by processor"));
+    state.active = level;
+    for (Binding* kernel = getBindings(); kernel; kernel = kernel->next) {
+      kernel->bind(level);
+    }
+  }
+
+  const char* CPUDispatch::getLevelName(Level level) noexcept {
+    switch (level) {
+    case LEVEL_SCALAR:
+      return "scalar";
+    case LEVEL_SSE2:
+      return "sse2";
+    case LEVEL_SSE41:
+      return "sse4.1";
+    case LEVEL_AVX2:
+      return "avx2";
+    case LEVEL_AVX512:
+      return "avx512";
+    default:
+      return "unknown";
+    }
+  }
+
+  bool CPUDispatch::parseLevel(const char* name, Level& level) noexcept {
+    for (unsigned int i = 0; i < LEVELS; ++i) {
+      if (::strcmp(name, getLevelName(static_cast<Level>(i))) == 0) {
+        level = static_cast<Level>(i);
+        return true;
+      }
+    }
+    return false;
+  }
+
+}; // end of gip namespace
@@ -0,0 +1,258 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#pragma once
+
+#include <gip/features.h>
+#include <base/Object.h>
+#include <base/Primitives.h>
+
+/**
+  Defined if SIMD kernels for x86 are compiled. A kernel is compiled for its
+  instruction set with _COM_AZURE_DEV__GIP__TARGET (e.g. "avx2") and must
+  only be bound through CPUDispatch.
+*/
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#  define _COM_AZURE_DEV__GIP__SIMD_X86
+#  define _COM_AZURE_DEV__GIP__TARGET(features) __attribute__((target(features)))
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#  define _COM_AZURE_DEV__GIP__SIMD_X86
+#  define _COM_AZURE_DEV__GIP__TARGET(features)
+#endif
+
+namespace gip {
+
+  /**
+    Selects the implementation of the SIMD kernels at runtime. The processor
+    features are detected on first use and every kernel is bound to the best
+    implementation for the active level. Thus one binary of the library runs
+    on any host and uses the wider instructions where available. The kernels
+    are compiled with per-function target attributes and must not be invoked
+    above the detected level.
+
+    The level may be limited with the environment variable GIP_SIMD (scalar,
+    sse2, sse4.1, avx2 or avx512) for benchmarking and for reproducing
+    issues. setLevel() changes the level programmatically.
+
+    @code
+    typedef void (*Sum)(uint32*, const uint8*, MemorySize);
+    static CPUDispatch::Kernel<Sum> sum("sum", sumScalar);
+    ...
+    sum.set(CPUDispatch::LEVEL_AVX2, sumAVX2);
+    sum.get()(dest, src, size);
+    @endcode
+
+    @short Runtime CPU dispatch of SIMD kernels.
+    @version 1.0
+  */
+
+  class _COM_AZURE_DEV__GIP__API CPUDispatch : public Object {
+  public:
+
+    /** The instruction set levels. Each level includes the lower levels. */
+    enum Level {
+      LEVEL_SCALAR, /**< Portable code only. */
+      LEVEL_SSE2, /**< SSE2. */
+      LEVEL_SSE41, /**< SSSE3 and SSE4.1. */
+      LEVEL_AVX2, /**< AVX, AVX2 and FMA. */
+      LEVEL_AVX512 /**< AVX-512 F, BW, DQ and VL. */
+    };
+
+    /** The number of levels. */
+    static constexpr unsigned int LEVELS = LEVEL_AVX512 + 1;
+
+    /** Individual processor features. */
+    enum Feature {
+      FEATURE_SSE2 = 1 << 0,
+      FEATURE_SSSE3 = 1 << 1,
+      FEATURE_SSE41 = 1 << 2,
+      FEATURE_SSE42 = 1 << 3,
+      FEATURE_AVX = 1 << 4,
+      FEATURE_FMA = 1 << 5,
+      FEATURE_AVX2 = 1 << 6,
+      FEATURE_BMI2 = 1 << 7,
+      FEATURE_AVX512F = 1 << 8,
+      FEATURE_AVX512BW = 1 << 9,
+      FEATURE_AVX512DQ = 1 << 10,
+      FEATURE_AVX512VL = 1 << 11,
+      FEATURE_AVX512VBMI = 1 << 12
+    };
+
+    /**
+      A kernel with one implementation per level. The kernel is bound to the
+      implementation of the highest level which does not exceed the active
+      level. Kernels must have static storage duration.
+    */
+    class _COM_AZURE_DEV__GIP__API Binding {
+      friend class CPUDispatch;
+    private:
+
+      /** The next registered kernel. */
+      Binding* next = nullptr;
+      /** The name of the kernel. */
+      const char* name = nullptr;
+    protected:
+
+      /**
+        Registers the kernel.
+      */
+      Binding(const char* name) noexcept;
+
+      /**
+        Binds the implementation for the specified level.
+      */
+      virtual void bind(Level level) noexcept = 0;
+
+      /**
+        Returns the level of the bound implementation.
+      */
+      virtual Level getBoundLevel() const noexcept = 0;
+    public:
+
+      /**
+        Returns the name of the kernel.
+      */
+      inline const char* getName() const noexcept {
+        return name;
+      }
+
+      /**
+        Unregisters the kernel.
+      */
+      virtual ~Binding() noexcept;
+    };
+
+    /**
+      Kernel implemented by functions of type FUNCTION.
+    */
+    template<class FUNCTION>
+    class Kernel : public Binding {
+    private:
+
+      /** The implementations (nullptr if not available). */
+      FUNCTION implementations[LEVELS];
+      /** The bound implementation. */
+      FUNCTION function = nullptr;
+      /** The level of the bound implementation. */
+      Level bound = LEVEL_SCALAR;
+
+      void bind(Level level) noexcept {
+        for (int i = level; i >= 0; --i) {
+          if (implementations[i]) {
+            function = implementations[i];
+            bound = static_cast<Level>(i);
+            return;
+          }
+        }
+      }
+
+      Level getBoundLevel() const noexcept {
+        return bound;
+      }
+    public:
+
+      /**
+        Initializes the kernel with the portable implementation.
+      */
+      Kernel(const char* name, FUNCTION scalar) noexcept
+        : Binding(name), function(scalar) {
+        for (unsigned int i = 0; i < LEVELS; ++i) {
+          implementations[i] = nullptr;
+        }
+        implementations[LEVEL_SCALAR] = scalar;
+      }
+
+      /**
+        Sets the implementation for the specified level and rebinds the kernel.
+      */
+      Kernel& set(Level level, FUNCTION implementation) noexcept {
+        implementations[level] = implementation;
+        bind(CPUDispatch::getLevel());
+        return *this;
+      }
+
+      /**
+        Returns the bound implementation.
+      */
+      inline FUNCTION get() const noexcept {
+        return function;
+      }
+
+      /**
+        Returns the level of the bound implementation.
+      */
+      inline Level getLevel() const noexcept {
+        return bound;
+      }
+    };
+  private:
+
+    /** Returns the first registered kernel. */
+    static Binding*& getBindings() noexcept;
+  public:
+
+    /**
+      Returns the features of the processor (see Feature).
+    */
+    static unsigned int getFeatures() noexcept;
+
+    /**
+      Returns true if the processor has all the specified features.
+    */
+    static inline bool hasFeatures(unsigned int features) noexcept {
+      return (getFeatures() & features) == features;
+    }
+
+    /**
+      Returns the highest level supported by the processor and the operating
+      system.
+    */
+    static Level getSupportedLevel() noexcept;
+
+    /**
+      Returns the active level. This is the supported level limited by GIP_SIMD
+      unless set by setLevel().
+    */
+    static Level getLevel() noexcept;
+
+    /**
+      Sets the active level and rebinds all the kernels. Raises
+      ImageException if the level is not supported. Must not be invoked
+      while kernels are executing.
+    */
+    static void setLevel(Level level);
+
+    /**
+      Returns the name of the specified level (the GIP_SIMD value).
+    */
+    static const char* getLevelName(Level level) noexcept;
+
+    /**
+      Parses the specified level name. Returns false if not recognized.
+    */
+    static bool parseLevel(const char* name, Level& level) noexcept;
+
+    /**
+      Invokes the specified function with the name and bound level of each
+      kernel.
+    */
+    template<class FUNCTION>
+    static void forEachKernel(FUNCTION function) {
+      getLevel(); // make sure the kernels are bound
+      for (const Binding* kernel = getBindings(); kernel; kernel = kernel->next) {
+        function(kernel->getName(), kernel->getBoundLevel());
+      }
+    }
+  };
+
+}; // end of gip namespace
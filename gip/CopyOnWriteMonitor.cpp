@@ -0,0 +1,118 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#include <gip/CopyOnWriteMonitor.h>
+#include <gip/ImageException.h>
+#include <base/concurrency/MutualExclusion.h>
+
+namespace gip {
+
+  namespace {
+
+    class State {
+    public:
+
+      MutualExclusion guard;
+      CopyOnWriteMonitor::Statistics statistics;
+      CopyOnWriteMonitor::Listener listener = nullptr;
+      unsigned int forbidden = 0;
+      /** The number of copies made while copies were forbidden. Not reset with the statistics. */
+      uint64 forbiddenCopies = 0;
+    };
+
+    State& getState() noexcept {
+      static State state;
+      return state;
+    }
+  }
+
+  CopyOnWriteMonitor::Forbid::Forbid() noexcept {
+    State& state = getState();
+    state.guard.exclusiveLock();
+    ++state.forbidden;
+    first = state.forbiddenCopies;
+    state.guard.releaseLock();
+  }
+
+  uint64 CopyOnWriteMonitor::Forbid::getCopies() const noexcept {
+    State& state = getState();
+    state.guard.exclusiveLock();
+    const uint64 result = state.forbiddenCopies - first;
+    state.guard.releaseLock();
+    return result;
+  }
+
+  void CopyOnWriteMonitor::Forbid::verify() const {
+    bassert(getCopies() == 0, ImageException("Unexpected copy of shared image elements"));
+  }
+
+  CopyOnWriteMonitor::Forbid::~Forbid() noexcept {
+    State& state = getState();
+    state.guard.exclusiveLock();
+    --state.forbidden;
+    state.guard.releaseLock();
+  }
+
+  void CopyOnWriteMonitor::onCopy(MemorySize bytes, const char* site) noexcept {
+    State& state = getState();
+    state.guard.exclusiveLock();
+    ++state.statistics.copies;
+    state.statistics.bytes += bytes;
+    state.statistics.lastSite = site;
+    if (state.forbidden > 0) {
+      ++state.forbiddenCopies;
+    }
+    const Listener listener = state.listener;
+    state.guard.releaseLock();
+
+    if (listener) {
+      Event event;
+      event.bytes = bytes;
+      event.site = site;
+      listener(event);
+    }
+  }
+
+  CopyOnWriteMonitor::Statistics CopyOnWriteMonitor::getStatistics() noexcept {
+    State& state = getState();
+    state.guard.exclusiveLock();
+    const Statistics result = state.statistics;
+    state.guard.releaseLock();
+    return result;
+  }
+
+  void CopyOnWriteMonitor::resetStatistics() noexcept {
+    State& state = getState();
+    state.guard.exclusiveLock();
+    state.statistics = Statistics();
+    state.guard.releaseLock();
+  }
+
+  CopyOnWriteMonitor::Listener CopyOnWriteMonitor::setListener(Listener listener) noexcept {
+    State& state = getState();
+    state.guard.exclusiveLock();
+    const Listener result = state.listener;
+    state.listener = listener;
+    state.guard.releaseLock();
+    return result;
+  }
+
+  bool CopyOnWriteMonitor::isForbidden() noexcept {
+    State& state = getState();
+    state.guard.exclusiveLock();
+    const bool result = state.forbidden > 0;
+    state.guard.releaseLock();
+    return result;
+  }
+
+}; // end of gip namespace
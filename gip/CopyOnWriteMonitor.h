@@ -0,0 +1,138 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#pragma once
+
+#include <gip/features.h>
+#include <base/Primitives.h>
+
+namespace gip {
+
+  /**
+    Counts the copies of image elements made when modifying access is
+    requested for an image which shares its elements with other images (i.e.
+    copy-on-write). Such copies are usually unintended and caused by a missing
+    const qualifier. The counters are always maintained since the cost is
+    negligible compared to the copy itself. Copies are made within noexcept
+    code (e.g. the transformations) so the monitor never raises an exception
+    itself. Instead, Forbid counts the copies made while it exists and
+    raises ImageException when verified which lets performance tests fail on
+    unexpected copies. A listener may be installed to record the call sites
+    (e.g. a stack trace).
+
+    @code
+    {
+      CopyOnWriteMonitor::Forbid forbid; // frame loop must not copy
+      processFrame(frame);
+      forbid.verify();
+    }
+    CopyOnWriteMonitor::Statistics statistics = CopyOnWriteMonitor::getStatistics();
+    @endcode
+
+    @short Copy-on-write monitor.
+    @ingroup images
+    @version 1.0
+  */
+
+  class _COM_AZURE_DEV__GIP__API CopyOnWriteMonitor {
+  public:
+
+    /** Description of a copy. */
+    class Event {
+    public:
+
+      /** The number of bytes copied. */
+      MemorySize bytes = 0;
+      /** The method requesting modifying access (e.g. "ArrayImage::getRows"). */
+      const char* site = nullptr;
+    };
+
+    /** The counters. */
+    class Statistics {
+    public:
+
+      /** The number of copies. */
+      uint64 copies = 0;
+      /** The total number of bytes copied. */
+      uint64 bytes = 0;
+      /** The method which caused the last copy. Null if no copies. */
+      const char* lastSite = nullptr;
+    };
+
+    /** Function invoked for each copy. */
+    typedef void (*Listener)(const Event& event);
+
+    /**
+      Counts the copies made while the object exists. The copies of all
+      threads are counted.
+    */
+    class _COM_AZURE_DEV__GIP__API Forbid {
+    private:
+
+      /** The number of forbidden copies when the object was created. */
+      uint64 first = 0;
+    public:
+
+      Forbid() noexcept;
+
+      /**
+        Returns the number of copies made since the object was created.
+      */
+      uint64 getCopies() const noexcept;
+
+      /**
+        Raises ImageException if any copy has been made since the object was
+        created.
+      */
+      void verify() const;
+
+      ~Forbid() noexcept;
+    private:
+
+      Forbid(const Forbid& copy) = delete;
+      Forbid& operator=(const Forbid& eq) = delete;
+    };
+
+    /**
+      Registers a copy.
+
+      @param bytes The number of bytes copied.
+      @param site The method requesting modifying access.
+    */
+    static void onCopy(MemorySize bytes, const char* site) noexcept;
+
+    /**
+      Returns a snapshot of the counters.
+    */
+    static Statistics getStatistics() noexcept;
+
+    /**
+      Resets the counters.
+    */
+    static void resetStatistics() noexcept;
+
+    /**
+      Installs the listener. Null disables the listener. The listener must
+      not raise exceptions.
+
+      @return The previous listener.
+    */
+    static Listener setListener(Listener listener) noexcept;
+
+    /**
+      Returns true if copies are currently forbidden.
+    */
+    static bool isForbidden() noexcept;
+  };
+
+}; // end of gip namespace
@@ -14,6 +14,7 @@
 #pragma once
 
 #include <base/Object.h>
+#include <base/Primitives.h>
 #include <base/Dimension.h>
 #include <gip/Pixel.h>
 #include <gip/ImageException.h>
@@ -63,10 +64,25 @@ namespace gip {
     inline Image(const Image& copy) noexcept : dimension(copy.dimension) {
     }
 
+    /**
+      Initializes image from other image. The other image is left empty.
+    */
+    inline Image(Image&& move) noexcept : dimension(move.dimension) {
+      move.dimension = Dimension(0, 0);
+    }
+
     Image& operator=(const Image& eq) noexcept {
       dimension = eq.dimension;
       return *this;
     }
+
+    Image& operator=(Image&& move) noexcept {
+      dimension = move.dimension;
+      if (&move != this) {
+        move.dimension = Dimension(0, 0);
+      }
+      return *this;
+    }
     
     /**
       Returns the dimension of the image.
@@ -88,12 +104,22 @@ namespace gip {
     inline unsigned int getWidth() const noexcept {
       return dimension.getWidth();
     }
+
+    /**
+      Returns the number of pixels of the image. Unlike Dimension::getSize()
+      the result does not overflow for images with more than 2^32 pixels.
+    */
+    inline MemorySize getNumberOfPixels() const noexcept {
+      return static_cast<MemorySize>(dimension.getWidth()) * dimension.getHeight();
+    }
   };
 
   template<class PIXEL>
   inline Image<PIXEL>::Image(const Dimension& _dimension)  : dimension(_dimension) {
+    // the number of pixels must be representable (only relevant on 32 bit platforms)
     bassert(
-      (dimension.getWidth() <= 0xffff) && (dimension.getHeight() <= 0xffff),
+      (dimension.getHeight() == 0) ||
+      (dimension.getWidth() <= PrimitiveTraits<MemorySize>::MAXIMUM/dimension.getHeight()),
       ImageException("Image dimension limit exceeded", this)
     );
   }
@@ -0,0 +1,206 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#pragma once
+
+#include <gip/features.h>
+#include <gip/ImageBufferPool.h>
+#include <gip/RawImageData.h>
+#include <base/mem/ReferenceCountedObject.h>
+#include <base/mem/Allocator.h>
+#include <base/mem/Reference.h>
+#include <base/Functor.h>
+#include <base/Primitives.h>
+#include <base/MemoryException.h>
+
+namespace gip {
+
+  /**
+    Reference counted storage of the elements of an image. The first element
+    is aligned to the requested number of bytes. The elements are not
+    initialized. The storage is drawn from an ImageBufferPool if specified
+    and returned to the pool on destruction. Alternatively, the elements are
+    the RawImageData of another object (e.g. a MappedImageFile) used in place
+    in which case the buffer is not writeable and a copy of the buffer is
+    stored in memory.
+
+    @short Storage of image elements.
+    @ingroup images
+    @version 1.0
+  */
+
+  template<class PIXEL>
+  class ImageBuffer : public ReferenceCountedObject {
+  public:
+
+    /** The type of the elements. */
+    typedef PIXEL Pixel;
+  private:
+
+    /** The raw storage when not pooled. */
+    Allocator<uint8> storage;
+    /** The pool of the storage. May be invalid. */
+    Reference<ImageBufferPool> pool;
+    /** The raw storage when pooled. */
+    ImageBufferPool::Block* block = nullptr;
+    /** The data holding the elements. May be invalid. */
+    Reference<RawImageData> data;
+    /** The behavior of modifying access. */
+    RawImageData::Access access = RawImageData::COPY_ON_WRITE;
+    /** Specifies that the elements may be modified. */
+    bool writeable = true;
+    /** The number of elements. */
+    MemorySize size = 0;
+    /** The alignment of the first element in bytes. */
+    MemorySize alignment = 0;
+    /** The first element. */
+    Pixel* elements = nullptr;
+
+    /**
+      Allocates the storage and aligns the first element.
+    */
+    void allocate() {
+      const MemorySize bytes = size * sizeof(Pixel) + ((alignment > 1) ? (alignment - 1) : 0);
+      uint8* first = nullptr;
+      if (pool.isValid()) {
+        block = pool->acquire(bytes);
+        first = block->getElements();
+      } else {
+        storage.setSize(bytes);
+        first = storage.getElements();
+      }
+      MemorySize address = reinterpret_cast<MemorySize>(first);
+      if (alignment > 1) {
+        address = (address + alignment - 1) & ~static_cast<MemorySize>(alignment - 1);
+      }
+      elements = reinterpret_cast<Pixel*>(address);
+    }
+  public:
+
+    /**
+      Initializes the buffer.
+
+      @param size The number of elements.
+      @param alignment The alignment of the first element in bytes. Must be 0 or a power of 2.
+      @param pool The pool to draw the storage from. The default is the heap.
+    */
+    ImageBuffer(
+      MemorySize _size,
+      MemorySize _alignment = 0,
+      const Reference<ImageBufferPool>& _pool = Reference<ImageBufferPool>())
+      : pool(_pool), size(_size), alignment(_alignment) {
+      BASSERT((alignment & (alignment - 1)) == 0);
+      bassert(
+        size <= (PrimitiveTraits<MemorySize>::MAXIMUM - alignment)/sizeof(Pixel),
+        MemoryException("Image buffer size limit exceeded", this)
+      );
+      allocate();
+    }
+
+    /**
+      Initializes the buffer using the pixel data in place.
+
+      @param data The pixel data.
+      @param size The number of elements. Must not exceed the pixel data.
+    */
+    ImageBuffer(const Reference<RawImageData>& _data, MemorySize _size)
+      : data(_data), access(_data->getAccess()), writeable(false), size(_size) {
+      BASSERT(size * sizeof(Pixel) <= data->getLayout().getDataSize());
+      elements = reinterpret_cast<Pixel*>(const_cast<uint8*>(data->getBytes())); // never modified
+    }
+
+    /**
+      Initializes the buffer from other buffer. The elements are copied and the
+      alignment and the pool are preserved. The copy of a mapped buffer is
+      stored in memory.
+    */
+    ImageBuffer(const ImageBuffer& copy)
+      : ReferenceCountedObject(), pool(copy.pool), size(copy.size), alignment(copy.alignment) {
+      allocate();
+      base::copy<uint8>(
+        reinterpret_cast<uint8*>(elements),
+        reinterpret_cast<const uint8*>(copy.elements),
+        size * sizeof(Pixel)
+      );
+    }
+
+    ImageBuffer& operator=(const ImageBuffer& eq) = delete;
+
+    /**
+      Returns the first element for modifying access.
+    */
+    inline Pixel* getElements() noexcept {
+      return elements;
+    }
+
+    /**
+      Returns the first element for non-modifying access.
+    */
+    inline const Pixel* getElements() const noexcept {
+      return elements;
+    }
+
+    /**
+      Returns the number of elements.
+    */
+    inline MemorySize getSize() const noexcept {
+      return size;
+    }
+
+    /**
+      Returns the alignment of the first element in bytes.
+    */
+    inline MemorySize getAlignment() const noexcept {
+      return alignment;
+    }
+
+    /**
+      Returns true if the elements may be modified (i.e. the buffer is not
+      external data or a read-only copy of external data).
+    */
+    inline bool isWriteable() const noexcept {
+      return writeable;
+    }
+
+    /**
+      Returns the behavior of modifying access if the buffer is not writeable.
+    */
+    inline RawImageData::Access getAccess() const noexcept {
+      return access;
+    }
+
+    /**
+      Returns the data holding the elements. Invalid if the elements are not used in place.
+    */
+    inline const Reference<RawImageData>& getData() const noexcept {
+      return data;
+    }
+
+    /**
+      Returns the pool of the storage. Invalid if the storage is not pooled.
+    */
+    inline const Reference<ImageBufferPool>& getPool() const noexcept {
+      return pool;
+    }
+
+    /**
+      Returns the storage to the pool if pooled.
+    */
+    ~ImageBuffer() noexcept {
+      if (block) {
+        pool->release(block);
+      }
+    }
+  };
+
+}; // end of gip namespace
@@ -0,0 +1,135 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#include <gip/ImageBufferPool.h>
+
+namespace gip {
+
+  ImageBufferPool::ImageBufferPool(MemorySize _capacity)
+    : capacity(_capacity) {
+  }
+
+  ImageBufferPool::Bucket* ImageBufferPool::getBucket(MemorySize size) noexcept {
+    for (Bucket* bucket = buckets; bucket; bucket = bucket->next) {
+      if (bucket->size == size) {
+        return bucket;
+      }
+    }
+    return nullptr;
+  }
+
+  ImageBufferPool::Block* ImageBufferPool::acquire(MemorySize size) {
+    guard.exclusiveLock();
+    Bucket* bucket = getBucket(size);
+    if (bucket && bucket->free) { // hit
+      Block* block = bucket->free;
+      bucket->free = block->next;
+      block->next = nullptr;
+      statistics.pooledBytes -= size;
+      ++statistics.hits;
+      ++statistics.blocksInUse;
+      guard.releaseLock();
+      return block;
+    }
+    ++statistics.misses;
+    guard.releaseLock();
+
+    // allocate without holding the guard
+    if (!bucket) { // make sure the block can be returned later
+      Bucket* candidate = new Bucket();
+      candidate->size = size;
+      guard.exclusiveLock();
+      if (!getBucket(size)) {
+        candidate->next = buckets;
+        buckets = candidate;
+        candidate = nullptr;
+      }
+      guard.releaseLock();
+      delete candidate;
+    }
+    Block* block = new Block(size);
+    guard.exclusiveLock();
+    ++statistics.blocksInUse;
+    guard.releaseLock();
+    return block;
+  }
+
+  void ImageBufferPool::release(Block* block) noexcept {
+    if (!block) {
+      return;
+    }
+    const MemorySize size = block->getSize();
+    guard.exclusiveLock();
+    ++statistics.releases;
+    --statistics.blocksInUse;
+    Bucket* bucket = getBucket(size);
+    if (bucket && (size <= capacity - statistics.pooledBytes)) {
+      block->next = bucket->free;
+      bucket->free = block;
+      statistics.pooledBytes += size;
+      block = nullptr;
+    } else {
+      ++statistics.discards;
+    }
+    guard.releaseLock();
+    delete block;
+  }
+
+  void ImageBufferPool::clear() noexcept {
+    guard.exclusiveLock();
+    Block* blocks = nullptr; // all the free blocks
+    for (Bucket* bucket = buckets; bucket; bucket = bucket->next) {
+      while (bucket->free) {
+        Block* block = bucket->free;
+        bucket->free = block->next;
+        block->next = blocks;
+        blocks = block;
+      }
+    }
+    statistics.pooledBytes = 0;
+    guard.releaseLock();
+
+    while (blocks) { // free without holding the guard
+      Block* block = blocks;
+      blocks = block->next;
+      delete block;
+    }
+  }
+
+  ImageBufferPool::Statistics ImageBufferPool::getStatistics() noexcept {
+    guard.exclusiveLock();
+    const Statistics result = statistics;
+    guard.releaseLock();
+    return result;
+  }
+
+  void ImageBufferPool::resetStatistics() noexcept {
+    guard.exclusiveLock();
+    statistics.hits = 0;
+    statistics.misses = 0;
+    statistics.releases = 0;
+    statistics.discards = 0;
+    guard.releaseLock();
+  }
+
+  ImageBufferPool::~ImageBufferPool() noexcept {
+    BASSERT(statistics.blocksInUse == 0);
+    clear();
+    while (buckets) {
+      Bucket* bucket = buckets;
+      buckets = bucket->next;
+      delete bucket;
+    }
+  }
+
+}; // end of gip namespace
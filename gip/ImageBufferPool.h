@@ -0,0 +1,173 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#pragma once
+
+#include <gip/features.h>
+#include <base/mem/ReferenceCountedObject.h>
+#include <base/mem/Allocator.h>
+#include <base/concurrency/MutualExclusion.h>
+#include <base/Primitives.h>
+
+namespace gip {
+
+  /**
+    Pool of image storage blocks keyed by the size in bytes. Images which are
+    created with a pool draw their storage from the pool and return it when
+    destroyed. A released block is handed out again to the next request of the
+    exact same size (a hit) and a new block is only allocated on a miss. Thus
+    a pipeline which repeatedly creates temporaries of the same dimensions
+    does no heap allocation once the pool has been warmed up. The pool may be
+    shared by several threads.
+
+    @code
+    Reference<ImageBufferPool> pool = new ImageBufferPool();
+    for (;;) { // frame loop
+      ColorImage temporary(dimension, ColorImage::ROW_ALIGNMENT, pool);
+      ...
+    }
+    ImageBufferPool::Statistics statistics = pool->getStatistics();
+    @endcode
+
+    @short Pool of image storage.
+    @ingroup images
+    @see ImageBuffer
+    @version 1.0
+  */
+
+  class _COM_AZURE_DEV__GIP__API ImageBufferPool : public ReferenceCountedObject {
+  public:
+
+    /**
+      A block of storage owned by the pool.
+    */
+    class Block {
+      friend class ImageBufferPool;
+    private:
+
+      /** The storage. */
+      Allocator<uint8> storage;
+      /** The next free block of the same size. */
+      Block* next = nullptr;
+
+      inline Block(MemorySize size) {
+        storage.setSize(size);
+      }
+    public:
+
+      /**
+        Returns the first byte of the block.
+      */
+      inline uint8* getElements() noexcept {
+        return storage.getElements();
+      }
+
+      /**
+        Returns the size of the block in bytes.
+      */
+      inline MemorySize getSize() const noexcept {
+        return storage.getSize();
+      }
+    };
+
+    /**
+      The counters of the pool.
+    */
+    class Statistics {
+    public:
+
+      /** The number of requests served by a released block. */
+      uint64 hits = 0;
+      /** The number of requests which required a new block. */
+      uint64 misses = 0;
+      /** The number of blocks returned to the pool. */
+      uint64 releases = 0;
+      /** The number of returned blocks freed since the pool was full. */
+      uint64 discards = 0;
+      /** The number of blocks currently in use. */
+      MemorySize blocksInUse = 0;
+      /** The number of bytes currently held for reuse. */
+      MemorySize pooledBytes = 0;
+    };
+  private:
+
+    /** The free blocks of a given size. */
+    class Bucket {
+    public:
+
+      MemorySize size = 0;
+      Block* free = nullptr;
+      Bucket* next = nullptr;
+    };
+
+    /** Guards the buckets and the counters. */
+    MutualExclusion guard;
+    /** The buckets. */
+    Bucket* buckets = nullptr;
+    /** The maximum number of bytes held for reuse. */
+    MemorySize capacity = 0;
+    /** The counters. */
+    Statistics statistics;
+
+    /** Returns the bucket for the given size. The guard must be held. */
+    Bucket* getBucket(MemorySize size) noexcept;
+  public:
+
+    /**
+      Initializes an empty pool.
+
+      @param capacity The maximum number of bytes held for reuse. Blocks
+      returned beyond this limit are freed. The default is unlimited.
+    */
+    ImageBufferPool(MemorySize capacity = PrimitiveTraits<MemorySize>::MAXIMUM);
+
+    /**
+      Returns a block of the specified size in bytes. The block must be
+      returned using release().
+    */
+    Block* acquire(MemorySize size);
+
+    /**
+      Returns the block to the pool.
+    */
+    void release(Block* block) noexcept;
+
+    /**
+      Frees all the blocks held for reuse. Blocks in use are not affected.
+    */
+    void clear() noexcept;
+
+    /**
+      Returns the maximum number of bytes held for reuse.
+    */
+    inline MemorySize getCapacity() const noexcept {
+      return capacity;
+    }
+
+    /**
+      Returns a snapshot of the counters.
+    */
+    Statistics getStatistics() noexcept;
+
+    /**
+      Resets the hit, miss, release, and discard counters.
+    */
+    void resetStatistics() noexcept;
+
+    /**
+      Destroys the pool. All blocks must have been returned.
+    */
+    ~ImageBufferPool() noexcept;
+  };
+
+}; // end of gip namespace
@@ -0,0 +1,229 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#pragma once
+
+#include <gip/ArrayImage.h>
+#include <gip/Region.h>
+
+namespace gip {
+
+/**
+  A rectangular region of an array image which shares the elements of the
+  image (i.e. no elements are copied). The view provides the same row and
+  column interface as ArrayImage and may thus be used directly with the
+  templated transformations and traversal functions (e.g. forEach and
+  fillWithUnary). The image must outlive the view. Modifying access through
+  the view follows the copy-on-write semantics of the image (i.e. the image
+  is detached from any other image sharing its elements).
+
+  @short View of a region of an array image.
+  @ingroup images
+  @version 1.0
+*/
+
+template<class PIXEL>
+class ImageView : public Image<PIXEL> {
+public:
+
+  /** The type of the pixels. */
+  typedef typename Image<PIXEL>::Pixel Pixel;
+  typedef typename ArrayImage<PIXEL>::Rows Rows;
+  typedef typename ArrayImage<PIXEL>::ReadableRows ReadableRows;
+  typedef typename ArrayImage<PIXEL>::Columns Columns;
+  typedef typename ArrayImage<PIXEL>::ReadableColumns ReadableColumns;
+private:
+
+  /** The image for modifying access. Null for a read-only view. */
+  ArrayImage<PIXEL>* image = nullptr;
+  /** The image for non-modifying access. */
+  const ArrayImage<PIXEL>* readable = nullptr;
+  /** The offset of the view within the image. */
+  Point2D offset;
+
+  /**
+    Raises ImageException if the region is not within the image.
+  */
+  void validate(const Region& region) const;
+
+  /**
+    Returns the distance in elements from the first element of the image to
+    the first element of the view.
+  */
+  inline MemorySize getDisplacement() const noexcept {
+    return static_cast<MemorySize>(offset.getRow()) * readable->getPitch() + offset.getColumn();
+  }
+public:
+
+  /**
+    Initializes the view for modifying access.
+
+    @param image The image.
+    @param region The region of the image. Must be within the image.
+  */
+  ImageView(ArrayImage<PIXEL>* image, const Region& region);
+
+  /**
+    Initializes the view for non-modifying access only.
+
+    @param image The image.
+    @param region The region of the image. Must be within the image.
+  */
+  ImageView(const ArrayImage<PIXEL>* image, const Region& region);
+
+  /**
+    Initializes the view of a region of another view.
+
+    @param view The view.
+    @param region The region of the view. Must be within the view.
+  */
+  ImageView(const ImageView& view, const Region& region);
+
+  /**
+    Initializes the view from other view.
+  */
+  inline ImageView(const ImageView& copy) noexcept
+    : Image<PIXEL>(copy), image(copy.image), readable(copy.readable), offset(copy.offset) {
+  }
+
+  ImageView& operator=(const ImageView& eq) noexcept {
+    Image<PIXEL>::operator=(eq);
+    image = eq.image;
+    readable = eq.readable;
+    offset = eq.offset;
+    return *this;
+  }
+
+  /**
+    Returns the offset of the view within the image.
+  */
+  inline const Point2D& getOffset() const noexcept {
+    return offset;
+  }
+
+  /**
+    Returns the region of the image covered by the view.
+  */
+  inline Region getRegion() const noexcept {
+    return Region(offset, Image<PIXEL>::getDimension());
+  }
+
+  /**
+    Returns true if the view only permits non-modifying access.
+  */
+  inline bool isReadOnly() const noexcept {
+    return !image;
+  }
+
+  /**
+    Returns the distance in elements between the first elements of
+    consecutive rows (i.e. the pitch of the image).
+  */
+  inline unsigned int getPitch() const noexcept {
+    return readable->getPitch();
+  }
+
+  /**
+    Returns the rows of the view for modifying access. Raises ImageException
+    if the view is read-only.
+  */
+  Rows getRows() {
+    return Rows(getElements(), Image<PIXEL>::getDimension(), getPitch());
+  }
+
+  /**
+    Returns the rows of the view for non-modifying access.
+  */
+  inline ReadableRows getRows() const noexcept {
+    return ReadableRows(getElements(), Image<PIXEL>::getDimension(), getPitch());
+  }
+
+  /**
+    Returns the columns of the view for modifying access. Raises
+    ImageException if the view is read-only.
+  */
+  Columns getColumns() {
+    return Columns(getElements(), Image<PIXEL>::getDimension(), getPitch());
+  }
+
+  /**
+    Returns the columns of the view for non-modifying access.
+  */
+  inline ReadableColumns getColumns() const noexcept {
+    return ReadableColumns(getElements(), Image<PIXEL>::getDimension(), getPitch());
+  }
+
+  /**
+    Returns the first element of the view for modifying access. Row i starts
+    at getElements() + i * getPitch(). Raises ImageException if the view is
+    read-only.
+  */
+  Pixel* getElements() {
+    bassert(image, ImageException("Image view is read-only", this));
+    return image->getElements() + getDisplacement();
+  }
+
+  /**
+    Returns the first element of the view for non-modifying access.
+  */
+  inline const Pixel* getElements() const noexcept {
+    return readable->getElements() + getDisplacement();
+  }
+};
+
+template<class PIXEL>
+void ImageView<PIXEL>::validate(const Region& region) const {
+  const Dimension& dimension = region.getDimension();
+  const Point2D& position = region.getOffset();
+  bassert(
+    (position.getColumn() <= readable->getWidth()) &&
+    (dimension.getWidth() <= readable->getWidth() - position.getColumn()) &&
+    (position.getRow() <= readable->getHeight()) &&
+    (dimension.getHeight() <= readable->getHeight() - position.getRow()),
+    ImageException("Region exceeds image", this)
+  );
+}
+
+template<class PIXEL>
+ImageView<PIXEL>::ImageView(ArrayImage<PIXEL>* _image, const Region& region)
+  : Image<PIXEL>(region.getDimension()), image(_image), readable(_image), offset(region.getOffset()) {
+  validate(region);
+}
+
+template<class PIXEL>
+ImageView<PIXEL>::ImageView(const ArrayImage<PIXEL>* _image, const Region& region)
+  : Image<PIXEL>(region.getDimension()), readable(_image), offset(region.getOffset()) {
+  validate(region);
+}
+
+template<class PIXEL>
+ImageView<PIXEL>::ImageView(const ImageView& view, const Region& region)
+  : Image<PIXEL>(region.getDimension()),
+    image(view.image),
+    readable(view.readable),
+    offset(
+      view.offset.getRow() + region.getOffset().getRow(),
+      view.offset.getColumn() + region.getOffset().getColumn()
+    ) {
+  const Dimension& dimension = view.getDimension();
+  const Point2D& position = region.getOffset();
+  bassert(
+    (position.getColumn() <= dimension.getWidth()) &&
+    (region.getDimension().getWidth() <= dimension.getWidth() - position.getColumn()) &&
+    (position.getRow() <= dimension.getHeight()) &&
+    (region.getDimension().getHeight() <= dimension.getHeight() - position.getRow()),
+    ImageException("Region exceeds view", this)
+  );
+}
+
+}; // end of gip namespace
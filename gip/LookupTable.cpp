@@ -0,0 +1,286 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#include <gip/LookupTable.h>
+#include <gip/analysis/traverse.h>
+#include <gip/ImageException.h>
+
+#if defined(_COM_AZURE_DEV__GIP__SIMD_X86)
+#  include <immintrin.h>
+#endif
+
+namespace gip {
+
+  namespace {
+
+    typedef void (*MapGray)(uint8*, const uint8*, MemorySize, const uint8*);
+    typedef void (*MapColor)(ColorPixel*, const ColorPixel*, MemorySize, const LookupTable::ColorTable&);
+
+    void mapGrayScalar(uint8* dest, const uint8* src, MemorySize size, const uint8* table) noexcept {
+      const uint8* end = src + size;
+      for (; (end - src) >= 4; src += 4, dest += 4) {
+        const uint8 a = table[src[0]];
+        const uint8 b = table[src[1]];
+        const uint8 c = table[src[2]];
+        const uint8 d = table[src[3]];
+        dest[0] = a;
+        dest[1] = b;
+        dest[2] = c;
+        dest[3] = d;
+      }
+      for (; src < end; ++src, ++dest) {
+        *dest = table[*src];
+      }
+    }
+
+    void mapColorScalar(
+      ColorPixel* dest, const ColorPixel* src, MemorySize size, const LookupTable::ColorTable& table) noexcept {
+      const ColorPixel* end = src + size;
+      for (; src < end; ++src, ++dest) {
+        const ColorPixel value = *src;
+        dest->rgb = table.red[value.red] | table.green[value.green] | table.blue[value.blue];
+      }
+    }
+
+#if defined(_COM_AZURE_DEV__GIP__SIMD_X86)
+
+    /*
+      Sample v is within sub-table k if v - 16 * k is in [0; 15]. Adding 0x70
+      with saturation keeps these indices below 0x80 and moves all other
+      indices to 0x80 or above for which the shuffle returns 0. Hence the
+      lookup is the bitwise or of the 16 shuffles.
+    */
+
+    _COM_AZURE_DEV__GIP__TARGET("ssse3")
+    void mapGraySSSE3(uint8* dest, const uint8* src, MemorySize size, const uint8* table) noexcept {
+      __m128i tables[16];
+      for (unsigned int k = 0; k < 16; ++k) {
+        tables[k] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(table + 16 * k));
+      }
+      const __m128i step = _mm_set1_epi8(16);
+      const __m128i bias = _mm_set1_epi8(0x70);
+      for (; size >= 16; size -= 16, src += 16, dest += 16) {
+        __m128i index = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+        __m128i result = _mm_setzero_si128();
+        for (unsigned int k = 0; k < 16; ++k) {
+          result = _mm_or_si128(result, _mm_shuffle_epi8(tables[k], _mm_adds_epu8(index, bias)));
+          index = _mm_sub_epi8(index, step);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest), result);
+      }
+      mapGrayScalar(dest, src, size, table);
+    }
+
+    _COM_AZURE_DEV__GIP__TARGET("avx2")
+    void mapGrayAVX2(uint8* dest, const uint8* src, MemorySize size, const uint8* table) noexcept {
+      __m256i tables[16];
+      for (unsigned int k = 0; k < 16; ++k) {
+        tables[k] = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(table + 16 * k)));
+      }
+      const __m256i step = _mm256_set1_epi8(16);
+      const __m256i bias = _mm256_set1_epi8(0x70);
+      for (; size >= 32; size -= 32, src += 32, dest += 32) {
+        __m256i index = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+        __m256i result = _mm256_setzero_si256();
+        for (unsigned int k = 0; k < 16; ++k) {
+          result = _mm256_or_si256(result, _mm256_shuffle_epi8(tables[k], _mm256_adds_epu8(index, bias)));
+          index = _mm256_sub_epi8(index, step);
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest), result);
+      }
+      mapGrayScalar(dest, src, size, table);
+    }
+
+    _COM_AZURE_DEV__GIP__TARGET("avx2")
+    void mapColorAVX2(
+      ColorPixel* dest, const ColorPixel* src, MemorySize size, const LookupTable::ColorTable& table) noexcept {
+      const int* red = reinterpret_cast<const int*>(table.red);
+      const int* green = reinterpret_cast<const int*>(table.green);
+      const int* blue = reinterpret_cast<const int*>(table.blue);
+      const __m256i mask = _mm256_set1_epi32(0xff);
+      for (; size >= 8; size -= 8, src += 8, dest += 8) {
+        const __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+        const __m256i r = _mm256_i32gather_epi32(red, _mm256_and_si256(value, mask), 4);
+        const __m256i g = _mm256_i32gather_epi32(green, _mm256_and_si256(_mm256_srli_epi32(value, 8), mask), 4);
+        const __m256i b = _mm256_i32gather_epi32(blue, _mm256_and_si256(_mm256_srli_epi32(value, 16), mask), 4);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest), _mm256_or_si256(_mm256_or_si256(r, g), b));
+      }
+      mapColorScalar(dest, src, size, table);
+    }
+
+#if defined(__GNUC__) && !defined(__clang__)
+#  pragma GCC diagnostic push
+#  pragma GCC diagnostic ignored "-Wmaybe-uninitialized" // _mm512_undefined_epi32() within the intrinsics
+#endif
+
+    /* The low 7 bits of a sample select one of 128 entries and bit 7 selects the half. */
+    _COM_AZURE_DEV__GIP__TARGET("avx512f,avx512bw,avx512vbmi")
+    void mapGrayAVX512(uint8* dest, const uint8* src, MemorySize size, const uint8* table) noexcept {
+      const __m512i t0 = _mm512_loadu_si512(table);
+      const __m512i t1 = _mm512_loadu_si512(table + 64);
+      const __m512i t2 = _mm512_loadu_si512(table + 128);
+      const __m512i t3 = _mm512_loadu_si512(table + 192);
+      while (size > 0) {
+        const __mmask64 active = (size >= 64) ? ~static_cast<__mmask64>(0) : ((static_cast<__mmask64>(1) << size) - 1);
+        const __m512i index = _mm512_maskz_loadu_epi8(active, src);
+        const __m512i low = _mm512_permutex2var_epi8(t0, index, t1);
+        const __m512i high = _mm512_permutex2var_epi8(t2, index, t3);
+        _mm512_mask_storeu_epi8(dest, active, _mm512_mask_blend_epi8(_mm512_movepi8_mask(index), low, high));
+        const MemorySize count = (size >= 64) ? 64 : size;
+        size -= count;
+        src += count;
+        dest += count;
+      }
+    }
+
+    _COM_AZURE_DEV__GIP__TARGET("avx512f")
+    void mapColorAVX512(
+      ColorPixel* dest, const ColorPixel* src, MemorySize size, const LookupTable::ColorTable& table) noexcept {
+      const __m512i mask = _mm512_set1_epi32(0xff);
+      for (; size >= 16; size -= 16, src += 16, dest += 16) {
+        const __m512i value = _mm512_loadu_si512(src);
+        const __m512i r = _mm512_i32gather_epi32(_mm512_and_si512(value, mask), table.red, 4);
+        const __m512i g = _mm512_i32gather_epi32(_mm512_and_si512(_mm512_srli_epi32(value, 8), mask), table.green, 4);
+        const __m512i b = _mm512_i32gather_epi32(_mm512_and_si512(_mm512_srli_epi32(value, 16), mask), table.blue, 4);
+        _mm512_storeu_si512(dest, _mm512_or_si512(_mm512_or_si512(r, g), b));
+      }
+      mapColorScalar(dest, src, size, table);
+    }
+
+#if defined(__GNUC__) && !defined(__clang__)
+#  pragma GCC diagnostic pop
+#endif
+#endif
+
+    CPUDispatch::Kernel<MapGray> mapGray("lookup8", mapGrayScalar);
+    CPUDispatch::Kernel<MapColor> mapColor("lookupColor", mapColorScalar);
+
+    /** Registers the SIMD implementations. */
+    class Registration {
+    public:
+
+      Registration() noexcept {
+#if defined(_COM_AZURE_DEV__GIP__SIMD_X86)
+        mapGray.set(CPUDispatch::LEVEL_SSE41, mapGraySSSE3);
+        mapGray.set(CPUDispatch::LEVEL_AVX2, mapGrayAVX2);
+        if (CPUDispatch::hasFeatures(CPUDispatch::FEATURE_AVX512VBMI)) {
+          mapGray.set(CPUDispatch::LEVEL_AVX512, mapGrayAVX512);
+        }
+        mapColor.set(CPUDispatch::LEVEL_AVX2, mapColorAVX2);
+        mapColor.set(CPUDispatch::LEVEL_AVX512, mapColorAVX512);
+#endif
+      }
+    };
+
+    Registration registration;
+
+    /** Parallel lookup task. TABLE is the table argument of LookupTable::map(). */
+    template<class PIXEL, class TABLE>
+    class LookupBands : public ThreadPool::Task {
+    private:
+
+      PIXEL* dest = nullptr;
+      const PIXEL* src = nullptr;
+      const unsigned int destPitch = 0;
+      const unsigned int srcPitch = 0;
+      const unsigned int width = 0;
+      const unsigned int height = 0;
+      const unsigned int grain = 0;
+      const TABLE& table;
+    public:
+
+      LookupBands(ArrayImage<PIXEL>& destination, const ArrayImage<PIXEL>& source, unsigned int _grain, const TABLE& _table)
+        : dest(destination.getElements()), // detach before source is read
+          src(source.getElements()),
+          destPitch(destination.getPitch()),
+          srcPitch(source.getPitch()),
+          width(destination.getWidth()),
+          height(destination.getHeight()),
+          grain(_grain),
+          table(_table) {
+      }
+
+      void execute(unsigned int band) {
+        const unsigned int begin = band * grain;
+        const unsigned int end = (height - begin > grain) ? (begin + grain) : height;
+        PIXEL* d = dest + static_cast<MemorySize>(begin) * destPitch;
+        const PIXEL* s = src + static_cast<MemorySize>(begin) * srcPitch;
+        if ((destPitch == width) && (srcPitch == width)) { // map the band at once
+          LookupTable::map(d, s, static_cast<MemorySize>(end - begin) * width, table);
+          return;
+        }
+        for (unsigned int count = end - begin; count > 0; --count, d += destPitch, s += srcPitch) {
+          LookupTable::map(d, s, width, table);
+        }
+      }
+    };
+
+    template<class PIXEL, class TABLE>
+    void parallelLookup(
+      ArrayImage<PIXEL>& destination,
+      const ArrayImage<PIXEL>& source,
+      const TABLE& table,
+      unsigned int grain,
+      ThreadPool& pool) {
+      bassert(
+        destination.getDimension() == source.getDimension(),
+        ImageException("Images must have identical dimension")
+      );
+      if (!destination.getDimension().isProper()) {
+        return;
+      }
+      grain = RowBands::getGrain(destination.getDimension(), grain, pool);
+      LookupBands<PIXEL, TABLE> task(destination, source, grain, table);
+      pool.execute(task, RowBands::getBands(destination.getHeight(), grain));
+    }
+  }
+
+  LookupTable::ColorTable::ColorTable(const uint8* _red, const uint8* _green, const uint8* _blue) noexcept {
+    for (unsigned int i = 0; i < 256; ++i) {
+      ColorPixel pixel;
+      pixel.rgb = 0;
+      pixel.red = _red[i];
+      red[i] = pixel.rgb;
+      pixel.rgb = 0;
+      pixel.green = _green[i];
+      green[i] = pixel.rgb;
+      pixel.rgb = 0;
+      pixel.blue = _blue[i];
+      blue[i] = pixel.rgb;
+    }
+  }
+
+  void LookupTable::map(uint8* destination, const uint8* source, MemorySize size, const uint8* table) noexcept {
+    mapGray.get()(destination, source, size, table);
+  }
+
+  void LookupTable::map(
+    ColorPixel* destination, const ColorPixel* source, MemorySize size, const ColorTable& table) noexcept {
+    mapColor.get()(destination, source, size, table);
+  }
+
+  void applyLookup(
+    Gray8Image& destination, const Gray8Image& source, const uint8* table, unsigned int grain, ThreadPool& pool) {
+    parallelLookup(destination, source, table, grain, pool);
+  }
+
+  void applyLookup(
+    ColorImage& destination,
+    const ColorImage& source,
+    const LookupTable::ColorTable& table,
+    unsigned int grain,
+    ThreadPool& pool) {
+    parallelLookup(destination, source, table, grain, pool);
+  }
+
+}; // end of gip namespace
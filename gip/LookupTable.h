@@ -0,0 +1,121 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#pragma once
+
+#include <gip/ArrayImage.h>
+#include <gip/ThreadPool.h>
+#include <gip/CPUDispatch.h>
+#include <base/Primitives.h>
+
+namespace gip {
+
+  /**
+    Engine for mapping 8-bit samples through a table of 256 entries. This is
+    the inner loop of point operations like contrast stretching, histogram
+    equalization and tone mapping. Instead of looking up one pixel per
+    iteration the engine maps whole rows using the SIMD instructions of the
+    processor:
+
+    <ul>
+      <li>SSSE3 and AVX2 split the table into 16 sub-tables of 16 entries
+        which are looked up with byte shuffles (16 and 32 samples per step).</li>
+      <li>AVX-512 VBMI looks up 128 entries per byte permutation (64 samples
+        per step).</li>
+      <li>Color pixels are mapped per component with 32-bit gathers (AVX2 and
+        AVX-512).</li>
+    </ul>
+
+    The implementation is selected by CPUDispatch (kernels "lookup8" and
+    "lookupColor") and the portable implementation is used otherwise. All the
+    implementations produce identical results.
+
+    @short 8-bit lookup table engine.
+    @ingroup transformations
+    @see CPUDispatch
+    @version 1.0
+  */
+
+  class _COM_AZURE_DEV__GIP__API LookupTable : public Object {
+  public:
+
+    /**
+      Per-component table for ColorPixel. Each entry holds the mapped
+      component at its position within ColorPixel::rgb so a pixel is mapped
+      by combining three entries. The unused bits of the result are 0.
+    */
+    class _COM_AZURE_DEV__GIP__API ColorTable {
+    public:
+
+      /** The red entries. */
+      uint32 red[256];
+      /** The green entries. */
+      uint32 green[256];
+      /** The blue entries. */
+      uint32 blue[256];
+
+      /**
+        Initializes the table from one table of 256 entries per component.
+      */
+      ColorTable(const uint8* red, const uint8* green, const uint8* blue) noexcept;
+    };
+
+    /**
+      Maps the specified samples. The destination may be the source.
+
+      @param destination The destination samples.
+      @param source The source samples.
+      @param size The number of samples.
+      @param table The table of 256 entries.
+    */
+    static void map(uint8* destination, const uint8* source, MemorySize size, const uint8* table) noexcept;
+
+    /**
+      Maps the components of the specified pixels. The destination may be the
+      source.
+    */
+    static void map(
+      ColorPixel* destination, const ColorPixel* source, MemorySize size, const ColorTable& table) noexcept;
+  };
+
+  /**
+    Maps every pixel of the source image through the specified table of 256
+    entries and stores the result in the destination image using several
+    threads. The destination may be the source.
+
+    @param destination The destination image.
+    @param source The source image.
+    @param table The table.
+    @param grain The number of rows per band. 0 selects automatically.
+    @param pool The thread pool. The default pool if not specified.
+  */
+  _COM_AZURE_DEV__GIP__API void applyLookup(
+    Gray8Image& destination,
+    const Gray8Image& source,
+    const uint8* table,
+    unsigned int grain = 0,
+    ThreadPool& pool = ThreadPool::getDefault());
+
+  /**
+    Maps every component of the pixels of the source image through the
+    specified table and stores the result in the destination image using
+    several threads. The destination may be the source.
+  */
+  _COM_AZURE_DEV__GIP__API void applyLookup(
+    ColorImage& destination,
+    const ColorImage& source,
+    const LookupTable::ColorTable& table,
+    unsigned int grain = 0,
+    ThreadPool& pool = ThreadPool::getDefault());
+
+}; // end of gip namespace
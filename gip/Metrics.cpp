@@ -0,0 +1,202 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#include <gip/Metrics.h>
+#include <base/Timer.h>
+#include <base/collection/Array.h>
+#include <base/string/StringOutputStream.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace gip {
+
+  namespace {
+
+    /** Returns true if enabled by the environment. */
+    bool isEnabledByEnvironment() noexcept {
+      const char* value = ::getenv("GIP_METRICS");
+      return value && (value[0] != 0) && (::strcmp(value, "0") != 0);
+    }
+
+    /** Guards the list of counters. */
+    MutualExclusion& getRegistryGuard() noexcept {
+      static MutualExclusion guard;
+      return guard;
+    }
+
+    /** Writes the name with the JSON special characters escaped. */
+    void writeEscaped(FormatOutputStream& stream, const char* name) {
+      for (; *name; ++name) {
+        if ((*name == '"') || (*name == '\\')) {
+          stream << '\\';
+        }
+        stream << *name;
+      }
+    }
+  }
+
+  std::atomic<bool> Metrics::enabled(isEnabledByEnvironment());
+
+  Metrics::Counter::Counter(const char* _name) noexcept : name(_name) {
+    MutualExclusion& registryGuard = getRegistryGuard();
+    registryGuard.exclusiveLock();
+    Counter*& counters = Metrics::getCounters();
+    next = counters;
+    counters = this;
+    registryGuard.releaseLock();
+  }
+
+  void Metrics::Counter::record(uint64 _microseconds, uint64 _pixels, uint64 _bytes) noexcept {
+    guard.exclusiveLock();
+    ++calls;
+    microseconds += _microseconds;
+    pixels += _pixels;
+    bytes += _bytes;
+    guard.releaseLock();
+  }
+
+  Metrics::Counter::~Counter() noexcept {
+    MutualExclusion& registryGuard = getRegistryGuard();
+    registryGuard.exclusiveLock();
+    Counter** link = &Metrics::getCounters();
+    while (*link) {
+      if (*link == this) {
+        *link = next;
+        break;
+      }
+      link = &(*link)->next;
+    }
+    registryGuard.releaseLock();
+  }
+
+  Metrics::Counter*& Metrics::getCounters() noexcept {
+    static Counter* counters = nullptr;
+    return counters;
+  }
+
+  void Metrics::setEnabled(bool enabled) noexcept {
+    Metrics::enabled.store(enabled, std::memory_order_relaxed);
+  }
+
+  uint64 Metrics::getMicroseconds() noexcept {
+    static Timer timer; // started on first use
+    return timer.getLiveMicroseconds();
+  }
+
+  void Metrics::reset() noexcept {
+    MutualExclusion& registryGuard = getRegistryGuard();
+    registryGuard.exclusiveLock();
+    for (Counter* counter = getCounters(); counter; counter = counter->next) {
+      counter->guard.exclusiveLock();
+      counter->calls = 0;
+      counter->microseconds = 0;
+      counter->pixels = 0;
+      counter->bytes = 0;
+      counter->guard.releaseLock();
+    }
+    registryGuard.releaseLock();
+  }
+
+  Array<Metrics::Entry> Metrics::getEntries() {
+    Array<Entry> result;
+    MutualExclusion& registryGuard = getRegistryGuard();
+    registryGuard.exclusiveLock();
+    try {
+      for (Counter* counter = getCounters(); counter; counter = counter->next) {
+        counter->guard.exclusiveLock();
+        Entry entry;
+        entry.name = counter->name;
+        entry.calls = counter->calls;
+        entry.microseconds = counter->microseconds;
+        entry.pixels = counter->pixels;
+        entry.bytes = counter->bytes;
+        counter->guard.releaseLock();
+
+        bool found = false;
+        Entry* existing = result.getElements();
+        for (MemorySize i = 0; i < result.getSize(); ++i, ++existing) {
+          if (::strcmp(existing->name, entry.name) == 0) {
+            existing->calls += entry.calls;
+            existing->microseconds += entry.microseconds;
+            existing->pixels += entry.pixels;
+            existing->bytes += entry.bytes;
+            found = true;
+            break;
+          }
+        }
+        if (!found) {
+          result.append(entry);
+        }
+      }
+    } catch (...) {
+      registryGuard.releaseLock();
+      throw;
+    }
+    registryGuard.releaseLock();
+
+    // the list is in reverse order of registration
+    const MemorySize size = result.getSize();
+    Entry* elements = result.getElements();
+    for (MemorySize i = 0; i < size/2; ++i) {
+      const Entry temp = elements[i];
+      elements[i] = elements[size - 1 - i];
+      elements[size - 1 - i] = temp;
+    }
+    return result;
+  }
+
+  String Metrics::getText() {
+    const Array<Entry> entries = getEntries();
+    StringOutputStream stream;
+    stream << "name calls microseconds pixels bytes Mpix/s MB/s" << EOL;
+    for (MemorySize i = 0; i < entries.getSize(); ++i) {
+      const Entry& entry = entries[i];
+      if (entry.calls == 0) {
+        continue;
+      }
+      const double elapsed = (entry.microseconds > 0) ? static_cast<double>(entry.microseconds) : 1.0;
+      stream << entry.name << ' ' << entry.calls << ' ' << entry.microseconds << ' '
+             << entry.pixels << ' ' << entry.bytes << ' '
+             << static_cast<double>(entry.pixels)/elapsed << ' '
+             << static_cast<double>(entry.bytes)/elapsed << EOL;
+    }
+    stream << FLUSH;
+    return stream.getString();
+  }
+
+  String Metrics::getJSON() {
+    const Array<Entry> entries = getEntries();
+    StringOutputStream stream;
+    stream << '[';
+    bool first = true;
+    for (MemorySize i = 0; i < entries.getSize(); ++i) {
+      const Entry& entry = entries[i];
+      if (entry.calls == 0) {
+        continue;
+      }
+      if (!first) {
+        stream << ',';
+      }
+      first = false;
+      stream << "{\"name\":\"";
+      writeEscaped(stream, entry.name);
+      stream << "\",\"calls\":" << entry.calls
+             << ",\"microseconds\":" << entry.microseconds
+             << ",\"pixels\":" << entry.pixels
+             << ",\"bytes\":" << entry.bytes << '}';
+    }
+    stream << ']' << FLUSH;
+    return stream.getString();
+  }
+
+}; // end of gip namespace
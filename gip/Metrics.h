@@ -0,0 +1,248 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#pragma once
+
+#include <gip/features.h>
+#include <gip/build.h>
+#include <base/Object.h>
+#include <base/Primitives.h>
+#include <base/string/String.h>
+#include <base/collection/Array.h>
+#include <base/concurrency/MutualExclusion.h>
+#include <atomic>
+
+namespace gip {
+
+  /**
+    Process-wide registry of timing and throughput counters. Transformations
+    and image encoders record the number of calls, the elapsed time and the
+    number of pixels and bytes processed per call. The registry is exported
+    as text or JSON (e.g. for scraping by a service).
+
+    Recording is disabled at runtime unless the environment variable
+    GIP_METRICS is set (to anything but 0) or setEnabled() is invoked. A
+    disabled scope costs a single test. Recording is compiled out if the
+    library is configured without _COM_AZURE_DEV__GIP__USE_METRICS.
+
+    @code
+    void operator()() noexcept {
+      static Metrics::Counter counter("Convolution3x3");
+      Metrics::Scope scope(counter, *destination, *source);
+      ...
+    }
+    @endcode
+
+    @short Timing and throughput metrics.
+    @version 1.0
+  */
+
+  class _COM_AZURE_DEV__GIP__API Metrics : public Object {
+  public:
+
+    /**
+      The accumulated measurements of a named operation. Counters must have
+      static storage duration and are registered on construction. Counters
+      with the same name are combined on export.
+    */
+    class _COM_AZURE_DEV__GIP__API Counter {
+      friend class Metrics;
+    private:
+
+      /** The next registered counter. */
+      Counter* next = nullptr;
+      /** The name of the operation. */
+      const char* name = nullptr;
+      /** Guards the measurements. */
+      MutualExclusion guard;
+      /** The number of calls. */
+      uint64 calls = 0;
+      /** The accumulated time in microseconds. */
+      uint64 microseconds = 0;
+      /** The accumulated number of pixels. */
+      uint64 pixels = 0;
+      /** The accumulated number of bytes read and written. */
+      uint64 bytes = 0;
+
+      Counter(const Counter& copy) = delete;
+      Counter& operator=(const Counter& assign) = delete;
+    public:
+
+      /**
+        Registers the counter.
+      */
+      Counter(const char* name) noexcept;
+
+      /**
+        Returns the name of the operation.
+      */
+      inline const char* getName() const noexcept {
+        return name;
+      }
+
+      /**
+        Adds a measurement.
+      */
+      void record(uint64 microseconds, uint64 pixels, uint64 bytes) noexcept;
+
+      /**
+        Unregisters the counter.
+      */
+      ~Counter() noexcept;
+    };
+
+    /**
+      Measures the lifetime of the scope (i.e. one call) into a counter.
+    */
+    class Scope {
+    private:
+
+#if defined(_COM_AZURE_DEV__GIP__USE_METRICS)
+      Counter* counter = nullptr;
+      uint64 begin = 0;
+      uint64 pixels = 0;
+      uint64 bytes = 0;
+#endif
+
+      Scope(const Scope& copy) = delete;
+      Scope& operator=(const Scope& assign) = delete;
+    public:
+
+      /**
+        Starts a measurement. The number of pixels and bytes is set by
+        setProcessed() (e.g. after decoding).
+      */
+      inline explicit Scope(Counter& _counter) noexcept {
+#if defined(_COM_AZURE_DEV__GIP__USE_METRICS)
+        if (Metrics::isEnabled()) {
+          counter = &_counter;
+          begin = Metrics::getMicroseconds();
+        }
+#endif
+      }
+
+      /**
+        Starts a measurement for a transformation which writes the
+        destination image and reads the source image.
+      */
+      template<class DEST, class SRC>
+      inline Scope(Counter& _counter, const DEST& destination, const SRC& source) noexcept
+        : Scope(_counter) {
+        setProcessed(
+          destination.getNumberOfPixels(),
+          static_cast<uint64>(destination.getNumberOfPixels()) * sizeof(typename DEST::Pixel) +
+            static_cast<uint64>(source.getNumberOfPixels()) * sizeof(typename SRC::Pixel)
+        );
+      }
+
+      /**
+        Starts a measurement for an operation which updates the specified
+        image in place.
+      */
+      template<class IMAGE>
+      inline Scope(Counter& _counter, const IMAGE& image) noexcept
+        : Scope(_counter) {
+        setProcessed(
+          image.getNumberOfPixels(),
+          2 * static_cast<uint64>(image.getNumberOfPixels()) * sizeof(typename IMAGE::Pixel)
+        );
+      }
+
+      /**
+        Sets the number of pixels and bytes processed.
+      */
+      inline void setProcessed(uint64 _pixels, uint64 _bytes) noexcept {
+#if defined(_COM_AZURE_DEV__GIP__USE_METRICS)
+        pixels = _pixels;
+        bytes = _bytes;
+#endif
+      }
+
+      /**
+        Sets the number of pixels and bytes processed to the size of the
+        specified image (e.g. a decoded or encoded image).
+      */
+      template<class IMAGE>
+      inline void setProcessed(const IMAGE& image) noexcept {
+        setProcessed(
+          image.getNumberOfPixels(),
+          static_cast<uint64>(image.getNumberOfPixels()) * sizeof(typename IMAGE::Pixel)
+        );
+      }
+
+      inline ~Scope() noexcept {
+#if defined(_COM_AZURE_DEV__GIP__USE_METRICS)
+        if (counter) {
+          counter->record(Metrics::getMicroseconds() - begin, pixels, bytes);
+        }
+#endif
+      }
+    };
+  private:
+
+    /** The combined measurements of the counters with the same name. */
+    class Entry {
+    public:
+
+      const char* name = nullptr;
+      uint64 calls = 0;
+      uint64 microseconds = 0;
+      uint64 pixels = 0;
+      uint64 bytes = 0;
+    };
+
+    /** Set if recording is enabled. */
+    static std::atomic<bool> enabled;
+
+    /** Returns the first registered counter. */
+    static Counter*& getCounters() noexcept;
+
+    /** Returns the measurements combined by name in order of first registration. */
+    static Array<Entry> getEntries();
+  public:
+
+    /**
+      Returns true if recording is enabled.
+    */
+    static inline bool isEnabled() noexcept {
+      return enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+      Enables or disables recording.
+    */
+    static void setEnabled(bool enabled) noexcept;
+
+    /**
+      Returns a monotonic time stamp in microseconds.
+    */
+    static uint64 getMicroseconds() noexcept;
+
+    /**
+      Resets all the counters.
+    */
+    static void reset() noexcept;
+
+    /**
+      Returns the counters as text with one line per operation (name, calls,
+      time in microseconds, pixels, bytes and throughput in Mpix/s and MB/s).
+    */
+    static String getText();
+
+    /**
+      Returns the counters as a JSON array with one object per operation.
+    */
+    static String getJSON();
+  };
+
+}; // end of gip namespace
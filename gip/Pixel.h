@@ -28,12 +28,21 @@ namespace gip {
 
   /**
     Image element wrapper for a single intensity (e.g. gray level) with the
-    intensity represented by one byte.
+    intensity in the range of one byte. The intensity is stored in an int for
+    compatibility. Use Gray8Pixel for compact storage.
 
     @short Achromatic image element
     @ingroup pixels
   */
   typedef int GrayPixel;
+
+  /**
+    Image element for a single intensity (e.g. gray level) stored in one byte.
+
+    @short Compact achromatic image element
+    @ingroup pixels
+  */
+  typedef uint8 Gray8Pixel;
   
   template<>
   class PixelTraits<GrayPixel> {
@@ -57,6 +66,28 @@ namespace gip {
     };
   };
 
+  template<>
+  class PixelTraits<Gray8Pixel> {
+  public:
+    
+    typedef Gray8Pixel Component;
+    typedef Gray8Pixel Pixel;
+    typedef PixelComponent<Component>::Arithmetic Arithmetic;
+    
+    enum {
+      MINIMUM = 0x00,
+      MAXIMUM = 0xff
+    };
+
+    class GetOrder : public UnaryOperation<Pixel, Arithmetic> {
+    public:
+      
+      inline Arithmetic operator()(const Pixel& pixel) const noexcept {
+        return pixel;
+      }
+    };
+  };
+
 
 
   /**
@@ -112,6 +143,24 @@ namespace gip {
     return (GrayPixel)((static_cast<unsigned int>(value.red) + value.green + value.blue + 1)/3); // looses information
   }
 
+  template<>
+  inline float convertPixel<float, Gray8Pixel>(const Gray8Pixel& value) noexcept
+  {
+    return float(value);
+  }
+
+  template<>
+  inline Gray8Pixel convertPixel<Gray8Pixel, ColorPixel>(const ColorPixel& value) noexcept
+  {
+    return static_cast<Gray8Pixel>((static_cast<unsigned int>(value.red) + value.green + value.blue + 1)/3); // looses information
+  }
+
+  template<>
+  inline Gray8Pixel convertPixel<Gray8Pixel, GrayPixel>(const GrayPixel& value) noexcept
+  {
+    return static_cast<Gray8Pixel>((value < 0x00) ? 0x00 : ((value > 0xff) ? 0xff : value)); // clamp
+  }
+
 //   template<>
 //   inline GrayPixel convertPixel<GrayPixel, ColorAlphaPixel>(const ColorAlphaPixel& value) noexcept
 //   {
@@ -184,6 +233,15 @@ namespace gip {
      return result;
    }
 
+   template<>
+   inline ColorPixel convertPixel<ColorPixel, Gray8Pixel>(const Gray8Pixel& value) noexcept {
+     ColorPixel result;
+     result.red = value;
+     result.green = value;
+     result.blue = value;
+     return result;
+   }
+
    template<>
    inline ColorAlphaPixel convertPixel<ColorAlphaPixel, GrayPixel>(const GrayPixel& value) noexcept {
      ColorAlphaPixel result;
@@ -239,6 +297,21 @@ namespace gip {
      }
    };
 
+   template<>
+   class ConvertPixel<ColorAlphaPixel, Gray8Pixel> {
+   private:
+
+     const unsigned char alpha;
+   public:
+
+     inline ConvertPixel(unsigned char _alpha = 0xff /*ALPHA_OPAQUE_INTENSITY*/) noexcept : alpha(_alpha) {
+     }
+     
+     inline ColorAlphaPixel operator()(const Gray8Pixel& value) const noexcept {
+       return makeColorAlphaPixel(value, value, value, alpha);
+     }
+   };
+
   template<>
   class ConvertPixel<ColorAlphaPixel, ColorPixel> {
   private:
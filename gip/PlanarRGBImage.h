@@ -0,0 +1,202 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#pragma once
+
+#include <gip/ArrayImage.h>
+#include <gip/ImageView.h>
+
+namespace gip {
+
+/**
+  Color image with the red, green, and blue components stored in separate
+  planes (structure of arrays). The planes are stored one after another in a
+  single allocation with the rows aligned to ArrayImage::ROW_ALIGNMENT. Each
+  plane is accessed as a gray image view which may be used directly with the
+  templated transformations. The views must not outlive the image.
+
+  @short Planar RGB image.
+  @ingroup images
+  @version 1.0
+*/
+
+template<class COMPONENT>
+class PlanarRGBImage : public Image<RGBPixel<COMPONENT> > {
+public:
+
+  /** The type of the pixels. */
+  typedef typename Image<RGBPixel<COMPONENT> >::Pixel Pixel;
+  /** The type of the components. */
+  typedef COMPONENT Component;
+  /** The type of a single plane. */
+  typedef ImageView<Component> Plane;
+
+  /** The planes. */
+  enum PlaneIndex {
+    RED,
+    GREEN,
+    BLUE,
+    NUMBER_OF_PLANES
+  };
+private:
+
+  /** The planes stored as one image with the planes stacked vertically. */
+  ArrayImage<Component> planes;
+
+  /**
+    Returns the dimension of the image holding all the planes.
+  */
+  static Dimension getPlanesDimension(const Dimension& dimension) {
+    bassert(
+      dimension.getHeight() <= PrimitiveTraits<unsigned int>::MAXIMUM/NUMBER_OF_PLANES,
+      ImageException("Image dimension limit exceeded")
+    );
+    return Dimension(dimension.getWidth(), NUMBER_OF_PLANES * dimension.getHeight());
+  }
+public:
+
+  /**
+    Initializes empty image.
+  */
+  PlanarRGBImage()
+    : Image<Pixel>(Dimension(0, 0)) {
+  }
+
+  /**
+    Initializes the image to the specified dimension. The elements are not
+    initialized.
+
+    @param dimension The desired dimension of the image.
+  */
+  PlanarRGBImage(const Dimension& dimension)
+    : Image<Pixel>(dimension),
+      planes(getPlanesDimension(dimension), ArrayImage<Component>::ROW_ALIGNMENT) {
+  }
+
+  /**
+    Initializes the image from other image. The planes are shared until modified.
+  */
+  PlanarRGBImage(const PlanarRGBImage& copy) noexcept
+    : Image<Pixel>(copy), planes(copy.planes) {
+  }
+
+  /**
+    Initializes the image from other image. The planes are taken over.
+  */
+  PlanarRGBImage(PlanarRGBImage&& move) noexcept
+    : Image<Pixel>(std::move(move)), planes(std::move(move.planes)) {
+  }
+
+  PlanarRGBImage& operator=(const PlanarRGBImage& eq) noexcept {
+    Image<Pixel>::operator=(eq);
+    planes = eq.planes;
+    return *this;
+  }
+
+  PlanarRGBImage& operator=(PlanarRGBImage&& move) noexcept {
+    Image<Pixel>::operator=(std::move(move));
+    planes = std::move(move.planes);
+    return *this;
+  }
+
+  /**
+    Returns the distance in components between consecutive rows of a plane.
+  */
+  inline unsigned int getPitch() const noexcept {
+    return planes.getPitch();
+  }
+
+  /**
+    Returns the specified plane for modifying access.
+  */
+  Plane getPlane(PlaneIndex index) {
+    BASSERT(index < NUMBER_OF_PLANES);
+    return Plane(
+      &planes,
+      Region(Point2D(index * Image<Pixel>::getHeight(), 0), Image<Pixel>::getDimension())
+    );
+  }
+
+  /**
+    Returns the specified plane for non-modifying access.
+  */
+  const Plane getPlane(PlaneIndex index) const {
+    BASSERT(index < NUMBER_OF_PLANES);
+    return Plane(
+      &planes,
+      Region(Point2D(index * Image<Pixel>::getHeight(), 0), Image<Pixel>::getDimension())
+    );
+  }
+
+  /**
+    Returns the red plane for modifying access.
+  */
+  inline Plane getRed() {
+    return getPlane(RED);
+  }
+
+  /**
+    Returns the red plane for non-modifying access.
+  */
+  inline const Plane getRed() const {
+    return getPlane(RED);
+  }
+
+  /**
+    Returns the green plane for modifying access.
+  */
+  inline Plane getGreen() {
+    return getPlane(GREEN);
+  }
+
+  /**
+    Returns the green plane for non-modifying access.
+  */
+  inline const Plane getGreen() const {
+    return getPlane(GREEN);
+  }
+
+  /**
+    Returns the blue plane for modifying access.
+  */
+  inline Plane getBlue() {
+    return getPlane(BLUE);
+  }
+
+  /**
+    Returns the blue plane for non-modifying access.
+  */
+  inline const Plane getBlue() const {
+    return getPlane(BLUE);
+  }
+
+  /**
+    Returns all planes as one image with the red, green, and blue planes
+    stacked vertically (i.e. with three times the height of this image). This
+    is useful for operations which treat all components alike.
+  */
+  inline ArrayImage<Component>& getPlanes() noexcept {
+    return planes;
+  }
+
+  /**
+    Returns all planes as one image for non-modifying access.
+  */
+  inline const ArrayImage<Component>& getPlanes() const noexcept {
+    return planes;
+  }
+};
+
+typedef PlanarRGBImage<PixelTraits<ColorPixel>::Component> PlanarColorImage;
+
+}; // end of gip namespace
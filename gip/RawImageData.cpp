@@ -0,0 +1,43 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#include <gip/RawImageData.h>
+
+namespace gip {
+
+  RawImageLayout::RawImageLayout(
+    uint64 _offset,
+    const Dimension& _dimension,
+    unsigned int _bytesPerPixel,
+    MemorySize _pitch,
+    bool _bottomUp) noexcept
+    : offset(_offset),
+      dimension(_dimension),
+      bytesPerPixel(_bytesPerPixel),
+      pitch(_pitch ? _pitch : static_cast<MemorySize>(_dimension.getWidth()) * _bytesPerPixel),
+      bottomUp(_bottomUp) {
+  }
+
+  uint64 RawImageLayout::getDataSize() const noexcept {
+    if (dimension.getHeight() == 0) {
+      return 0;
+    }
+    return static_cast<uint64>(pitch) * (dimension.getHeight() - 1) +
+      static_cast<uint64>(dimension.getWidth()) * bytesPerPixel;
+  }
+
+  RawImageData::RawImageData(Access _access) noexcept
+    : access(_access) {
+  }
+
+}; // end of gip namespace
@@ -0,0 +1,130 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#pragma once
+
+#include <gip/features.h>
+#include <base/mem/ReferenceCountedObject.h>
+#include <base/Dimension.h>
+#include <base/Primitives.h>
+
+namespace gip {
+
+  /**
+    Description of uncompressed pixel data. Row i of the data starts at byte
+    offset + i * pitch. Unless bottomUp is set, the first row of the data is
+    the top row of the image whereas row 0 of an image is the bottom row. The
+    data is never reordered so an image using top-down data is upside down.
+
+    @short Layout of uncompressed image data.
+    @ingroup images
+    @version 1.0
+  */
+
+  class _COM_AZURE_DEV__GIP__API RawImageLayout {
+  public:
+
+    /** The offset in bytes of the first row (i.e. the size of the header). */
+    uint64 offset = 0;
+    /** The dimension of the image. */
+    Dimension dimension;
+    /** The size of a pixel in bytes. */
+    unsigned int bytesPerPixel = 0;
+    /** The distance in bytes between the first bytes of consecutive rows. */
+    MemorySize pitch = 0;
+    /** Specifies that the first row of the data is the bottom row of the image. */
+    bool bottomUp = false;
+
+    RawImageLayout() noexcept {
+    }
+
+    /**
+      Initializes the layout.
+
+      @param offset The size of the header in bytes.
+      @param dimension The dimension of the image.
+      @param bytesPerPixel The size of a pixel in bytes.
+      @param pitch The distance in bytes between rows. 0 for packed rows.
+      @param bottomUp Specifies that the first row is the bottom row. The default is top-down.
+    */
+    RawImageLayout(
+      uint64 offset,
+      const Dimension& dimension,
+      unsigned int bytesPerPixel,
+      MemorySize pitch = 0,
+      bool bottomUp = false) noexcept;
+
+    /**
+      Returns the number of bytes spanned by the pixel data.
+    */
+    uint64 getDataSize() const noexcept;
+  };
+
+  /**
+    Uncompressed pixel data held outside of the image (e.g. by a memory
+    mapped file) which may be used as the elements of an ArrayImage. The data
+    is never modified and the access policy specifies the behavior of
+    modifying access to the images using the data.
+
+    @short Externally held pixel data.
+    @ingroup images
+    @see ArrayImage
+    @version 1.0
+  */
+
+  class _COM_AZURE_DEV__GIP__API RawImageData : public ReferenceCountedObject {
+  public:
+
+    /** Specifies the behavior of modifying access to images using the data. */
+    enum Access {
+      READ_ONLY, /**< Modifying access raises ImageException. */
+      COPY_ON_WRITE /**< Modifying access copies the pixels into private memory. */
+    };
+  protected:
+
+    /** The layout of the pixel data. */
+    RawImageLayout layout;
+    /** The behavior of modifying access. */
+    Access access = READ_ONLY;
+    /** The first byte of the pixel data. */
+    const uint8* bytes = nullptr;
+
+    /**
+      Initializes the data. The layout and the first byte are set by the derived class.
+    */
+    RawImageData(Access access) noexcept;
+  public:
+
+    /**
+      Returns the layout of the pixel data.
+    */
+    inline const RawImageLayout& getLayout() const noexcept {
+      return layout;
+    }
+
+    /**
+      Returns the behavior of modifying access.
+    */
+    inline Access getAccess() const noexcept {
+      return access;
+    }
+
+    /**
+      Returns the first byte of the pixel data.
+    */
+    inline const uint8* getBytes() const noexcept {
+      return bytes;
+    }
+  };
+
+}; // end of gip namespace
@@ -98,6 +98,28 @@ namespace gip {
     inline bool isProper() const noexcept {
       return dimension.isProper();
     }
+
+    /**
+      Returns the first row after the region.
+    */
+    inline unsigned int getEndRow() const noexcept {
+      return offset.getRow() + dimension.getHeight();
+    }
+
+    /**
+      Returns the first column after the region.
+    */
+    inline unsigned int getEndColumn() const noexcept {
+      return offset.getColumn() + dimension.getWidth();
+    }
+
+    /**
+      Returns true if the region is within the specified dimension.
+    */
+    inline bool isWithin(const Dimension& _dimension) const noexcept {
+      return (getEndRow() <= _dimension.getHeight()) && (getEndColumn() <= _dimension.getWidth()) &&
+        (offset.getRow() <= getEndRow()) && (offset.getColumn() <= getEndColumn()); // no overflow
+    }
   };
 
   inline Region::Region(const Point2D& _offset, const Dimension& _dimension) noexcept
@@ -0,0 +1,181 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#pragma once
+
+#include <gip/features.h>
+#include <base/Iterator.h>
+#include <base/iterator/MatrixRowIterator.h>
+
+namespace gip {
+
+  /**
+    Row iterator for images where the distance between the first elements of
+    consecutive rows (the pitch) may exceed the number of columns. The
+    elements of a row are accessed exactly as for MatrixRowIterator.
+
+    @short Row iterator with independent row pitch.
+    @version 1.0
+  */
+
+  template<class TRAITS>
+  class StridedRowIterator : public Iterator<TRAITS> {
+  public:
+
+    typedef typename Iterator<TRAITS>::Pointer Pointer;
+    /** The iterator used to access the elements of a single row. */
+    typedef MatrixRowIterator<TRAITS> Row;
+    typedef typename Row::ElementIterator ElementIterator;
+  private:
+
+    /** The first element of the current row. */
+    Pointer element = nullptr;
+    /** The number of columns. */
+    unsigned int columns = 0;
+    /** The distance between the first elements of consecutive rows. */
+    MemoryDiff pitch = 0;
+  public:
+
+    /**
+      Initializes the iterator.
+
+      @param value The first element of the row.
+      @param columns The number of columns.
+      @param pitch The distance in elements between consecutive rows.
+    */
+    inline StridedRowIterator(Pointer value, unsigned int _columns, MemoryDiff _pitch) noexcept
+      : element(value), columns(_columns), pitch(_pitch) {
+    }
+
+    /**
+      Initializes the iterator for rows without padding.
+    */
+    inline StridedRowIterator(Pointer value, unsigned int _columns) noexcept
+      : element(value), columns(_columns), pitch(_columns) {
+    }
+
+    inline StridedRowIterator(const StridedRowIterator& copy) noexcept
+      : element(copy.element), columns(copy.columns), pitch(copy.pitch) {
+    }
+
+    inline StridedRowIterator& operator=(const StridedRowIterator& eq) noexcept {
+      element = eq.element;
+      columns = eq.columns;
+      pitch = eq.pitch;
+      return *this;
+    }
+
+    /**
+      Returns the first element of the current row.
+    */
+    inline Pointer getPointer() const noexcept {
+      return element;
+    }
+
+    /**
+      Returns the distance in elements between consecutive rows.
+    */
+    inline MemoryDiff getPitch() const noexcept {
+      return pitch;
+    }
+
+    inline ElementIterator getFirst() const noexcept {
+      return Row(element, columns).getFirst();
+    }
+
+    inline ElementIterator getEnd() const noexcept {
+      return Row(element, columns).getEnd();
+    }
+
+    inline auto operator[](unsigned int index) const noexcept -> decltype(Row(Pointer(), 0)[index]) {
+      BASSERT(index < columns);
+      return Row(element, columns)[index];
+    }
+
+    inline StridedRowIterator& operator++() noexcept {
+      element += pitch;
+      return *this;
+    }
+
+    inline StridedRowIterator operator++(int) noexcept {
+      StridedRowIterator result(*this);
+      element += pitch;
+      return result;
+    }
+
+    inline StridedRowIterator& operator--() noexcept {
+      element -= pitch;
+      return *this;
+    }
+
+    inline StridedRowIterator operator--(int) noexcept {
+      StridedRowIterator result(*this);
+      element -= pitch;
+      return result;
+    }
+
+    inline StridedRowIterator& operator+=(MemoryDiff distance) noexcept {
+      element += distance * pitch;
+      return *this;
+    }
+
+    inline StridedRowIterator& operator-=(MemoryDiff distance) noexcept {
+      element -= distance * pitch;
+      return *this;
+    }
+
+    inline StridedRowIterator operator+(MemoryDiff distance) const noexcept {
+      StridedRowIterator result(*this);
+      result += distance;
+      return result;
+    }
+
+    inline StridedRowIterator operator-(MemoryDiff distance) const noexcept {
+      StridedRowIterator result(*this);
+      result -= distance;
+      return result;
+    }
+
+    /**
+      Returns the number of rows between the iterators.
+    */
+    inline MemoryDiff operator-(const StridedRowIterator& right) const noexcept {
+      return pitch ? (element - right.element)/pitch : 0;
+    }
+
+    inline bool operator==(const StridedRowIterator& right) const noexcept {
+      return element == right.element;
+    }
+
+    inline bool operator!=(const StridedRowIterator& right) const noexcept {
+      return element != right.element;
+    }
+
+    inline bool operator<(const StridedRowIterator& right) const noexcept {
+      return element < right.element;
+    }
+
+    inline bool operator<=(const StridedRowIterator& right) const noexcept {
+      return element <= right.element;
+    }
+
+    inline bool operator>(const StridedRowIterator& right) const noexcept {
+      return element > right.element;
+    }
+
+    inline bool operator>=(const StridedRowIterator& right) const noexcept {
+      return element >= right.element;
+    }
+  };
+
+}; // end of gip namespace
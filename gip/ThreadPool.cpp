@@ -0,0 +1,179 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#include <gip/ThreadPool.h>
+#include <gip/ImageException.h>
+#include <thread>
+
+namespace gip {
+
+  namespace {
+
+    /** The index of the current thread within the pool executing the current part. */
+    thread_local unsigned int threadIndex = 0;
+
+    /** Sets the index of the current thread while executing a part. */
+    class ThreadIndexScope {
+    private:
+
+      const unsigned int previous = 0;
+    public:
+
+      inline ThreadIndexScope(unsigned int index) noexcept : previous(threadIndex) {
+        threadIndex = index;
+      }
+
+      inline ~ThreadIndexScope() noexcept {
+        threadIndex = previous;
+      }
+    };
+  }
+
+  void ThreadPool::Worker::run() noexcept {
+    while (true) {
+      pool->started.wait();
+      pool->guard.exclusiveLock();
+      const bool terminated = pool->terminated;
+      pool->guard.releaseLock();
+      if (terminated) {
+        break;
+      }
+      pool->drain(index);
+      pool->completed.post();
+    }
+  }
+
+  unsigned int ThreadPool::getNumberOfProcessors() noexcept {
+    const unsigned int result = std::thread::hardware_concurrency();
+    return (result > 0) ? result : 1;
+  }
+
+  unsigned int ThreadPool::getThreadIndex() noexcept {
+    return threadIndex;
+  }
+
+  ThreadPool& ThreadPool::getDefault() {
+    static ThreadPool pool;
+    return pool;
+  }
+
+  ThreadPool::ThreadPool(unsigned int threads) {
+    startWorkers(((threads > 0) ? threads : getNumberOfProcessors()) - 1);
+  }
+
+  void ThreadPool::startWorkers(unsigned int count) {
+    terminated = false;
+    workers.setSize(count);
+    threads.setSize(count);
+    for (unsigned int i = 0; i < count; ++i) {
+      workers.getElements()[i] = new Worker(this, i + 1);
+      threads.getElements()[i] = new Thread(workers.getElements()[i]);
+      threads.getElements()[i]->start();
+    }
+  }
+
+  void ThreadPool::stopWorkers() noexcept {
+    guard.exclusiveLock();
+    terminated = true;
+    guard.releaseLock();
+    const MemorySize count = threads.getSize();
+    for (MemorySize i = 0; i < count; ++i) {
+      started.post();
+    }
+    for (MemorySize i = 0; i < count; ++i) {
+      threads.getElements()[i]->join();
+      delete threads.getElements()[i];
+      delete workers.getElements()[i];
+    }
+    threads.setSize(0);
+    workers.setSize(0);
+  }
+
+  void ThreadPool::setNumberOfThreads(unsigned int count) {
+    guard.exclusiveLock();
+    const bool wasBusy = busy;
+    guard.releaseLock();
+    bassert(!wasBusy, ImageException("Thread pool is busy", this));
+    stopWorkers();
+    startWorkers(((count > 0) ? count : getNumberOfProcessors()) - 1);
+  }
+
+  void ThreadPool::drain(unsigned int thread) noexcept {
+    ThreadIndexScope scope(thread);
+    while (true) {
+      guard.exclusiveLock();
+      const unsigned int part = next++;
+      const bool done = part >= parts;
+      guard.releaseLock();
+      if (done) {
+        break;
+      }
+      try {
+        task->execute(part);
+      } catch (...) {
+        guard.exclusiveLock();
+        failed = true;
+        next = parts; // skip remaining parts
+        guard.releaseLock();
+      }
+    }
+  }
+
+  void ThreadPool::execute(Task& _task, unsigned int _parts) {
+    guard.exclusiveLock();
+    const bool serial = busy || (_parts <= 1) || (threads.getSize() == 0);
+    if (!serial) {
+      busy = true;
+      failed = false;
+      task = &_task;
+      parts = _parts;
+      next = 0;
+    }
+    guard.releaseLock();
+
+    if (serial) { // nested or trivial task
+      ThreadIndexScope scope(0);
+      bool result = false;
+      try {
+        for (unsigned int part = 0; part < _parts; ++part) {
+          _task.execute(part);
+        }
+      } catch (...) {
+        result = true;
+      }
+      bassert(!result, ImageException("Parallel task failed", this));
+      return;
+    }
+
+    const MemorySize count = threads.getSize();
+    for (MemorySize i = 0; i < count; ++i) {
+      started.post();
+    }
+    drain(0);
+    for (MemorySize i = 0; i < count; ++i) {
+      completed.wait();
+    }
+
+    guard.exclusiveLock();
+    const bool result = failed;
+    task = nullptr;
+    busy = false;
+    guard.releaseLock();
+    bassert(!result, ImageException("Parallel task failed", this));
+  }
+
+  ThreadPool::~ThreadPool() noexcept {
+    stopWorkers();
+  }
+
+}; // end of gip namespace
@@ -0,0 +1,170 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#pragma once
+
+#include <gip/features.h>
+#include <base/Object.h>
+#include <base/mem/Allocator.h>
+#include <base/concurrency/Thread.h>
+#include <base/concurrency/Runnable.h>
+#include <base/concurrency/Semaphore.h>
+#include <base/concurrency/MutualExclusion.h>
+
+namespace gip {
+
+  /**
+    A fixed set of worker threads executing the parts of a task concurrently.
+    The calling thread executes parts too and returns when all the parts have
+    been executed. Only one task is executed at a time; a task submitted while
+    the pool is busy (e.g. from within a task) is executed by the calling
+    thread alone.
+
+    @short Pool of worker threads.
+    @see forEach transform fillWithUnary
+    @version 1.0
+  */
+
+  class _COM_AZURE_DEV__GIP__API ThreadPool : public Object {
+  public:
+
+    /**
+      A task consisting of independent parts.
+    */
+    class _COM_AZURE_DEV__GIP__API Task {
+    public:
+
+      /**
+        Executes the specified part. Invoked concurrently for different parts.
+      */
+      virtual void execute(unsigned int part) = 0;
+
+      virtual ~Task() noexcept {
+      }
+    };
+  private:
+
+    /** Worker thread entry. */
+    class Worker : public virtual Runnable {
+    private:
+
+      ThreadPool* pool = nullptr;
+      /** The index of the thread within the pool. */
+      unsigned int index = 0;
+    public:
+
+      inline Worker(ThreadPool* _pool, unsigned int _index) noexcept
+        : pool(_pool), index(_index) {
+      }
+
+      void run() noexcept;
+    };
+
+    /** Guards the task state. */
+    MutualExclusion guard;
+    /** Signaled once per worker when a task is available. */
+    Semaphore started;
+    /** Signaled once by each worker when done with the task. */
+    Semaphore completed;
+    /** The workers. */
+    Allocator<Worker*> workers;
+    /** The threads of the workers. */
+    Allocator<Thread*> threads;
+    /** The current task. */
+    Task* task = nullptr;
+    /** The number of parts of the current task. */
+    unsigned int parts = 0;
+    /** The next part to execute. */
+    unsigned int next = 0;
+    /** True while a task is executed. */
+    bool busy = false;
+    /** True if a part of the current task raised an exception. */
+    bool failed = false;
+    /** True when the workers must exit. */
+    bool terminated = false;
+
+    /**
+      Executes parts of the current task until none are left.
+
+      @param thread The index of the calling thread within the pool.
+    */
+    void drain(unsigned int thread) noexcept;
+
+    /**
+      Starts the specified number of worker threads.
+    */
+    void startWorkers(unsigned int count);
+
+    /**
+      Stops and releases the worker threads.
+    */
+    void stopWorkers() noexcept;
+  public:
+
+    /**
+      Returns the number of processors available (at least 1).
+    */
+    static unsigned int getNumberOfProcessors() noexcept;
+
+    /**
+      Returns the index of the calling thread within the pool executing the
+      current part in the range [0; getNumberOfThreads()). The thread which
+      submitted the task has index 0. A thread may execute several parts of
+      a task, one after the other, whereas a part is executed by one thread.
+    */
+    static unsigned int getThreadIndex() noexcept;
+
+    /**
+      Returns the pool used by default by the parallel traversals. The pool
+      uses one thread per processor unless changed with setNumberOfThreads().
+    */
+    static ThreadPool& getDefault();
+
+    /**
+      Initializes the pool.
+
+      @param threads The total number of threads including the calling
+      thread. 0 selects the number of processors.
+    */
+    ThreadPool(unsigned int threads = 0);
+
+    /**
+      Returns the total number of threads including the calling thread.
+    */
+    inline unsigned int getNumberOfThreads() const noexcept {
+      return static_cast<unsigned int>(threads.getSize()) + 1;
+    }
+
+    /**
+      Sets the total number of threads including the calling thread. Must not
+      be invoked while a task is executed.
+
+      @param threads The number of threads. 0 selects the number of processors.
+    */
+    void setNumberOfThreads(unsigned int threads);
+
+    /**
+      Executes the parts [0; parts) of the specified task and returns when
+      all have been executed. Raises ImageException if any part raised an
+      exception whether the parts are executed concurrently or by the calling
+      thread alone.
+    */
+    void execute(Task& task, unsigned int parts);
+
+    /**
+      Stops the worker threads.
+    */
+    ~ThreadPool() noexcept;
+  };
+
+}; // end of gip namespace
@@ -0,0 +1,174 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#include <gip/TileScheduler.h>
+#include <gip/ImageException.h>
+#include <gip/Metrics.h>
+#include <base/Timer.h>
+
+namespace gip {
+
+  void TileScheduler::Schedule::execute(unsigned int part) {
+    // the deque and statistics belong to the executing thread, not to the part
+    const unsigned int worker = ThreadPool::getThreadIndex();
+    WorkerStatistics& statistics = scheduler.statistics.getElements()[worker];
+    Timer timer;
+    MemorySize tile = 0;
+    while (true) {
+      if (!scheduler.take(worker, tile)) {
+        if (!scheduler.steal(worker)) {
+          break; // all tiles taken
+        }
+        ++statistics.steals;
+        continue;
+      }
+      const uint64 begin = timer.getLiveMicroseconds();
+      task.execute(scheduler.getTile(tile));
+      statistics.busyMicroseconds += timer.getLiveMicroseconds() - begin;
+      ++statistics.tiles;
+    }
+  }
+
+  TileScheduler::TileScheduler(ThreadPool& _pool, const Dimension& _tileDimension)
+    : pool(_pool), tileDimension(_tileDimension) {
+    bassert(tileDimension.isProper(), ImageException("Invalid tile dimension", this));
+  }
+
+  void TileScheduler::setTileDimension(const Dimension& tileDimension) {
+    bassert(tileDimension.isProper(), ImageException("Invalid tile dimension", this));
+    this->tileDimension = tileDimension;
+  }
+
+  Region TileScheduler::getTile(MemorySize index) const noexcept {
+    const unsigned int row = static_cast<unsigned int>(index/tilesPerRow) * tileDimension.getHeight();
+    const unsigned int column = static_cast<unsigned int>(index % tilesPerRow) * tileDimension.getWidth();
+    return Region(
+      Point2D(row, column),
+      Dimension(
+        minimum(tileDimension.getWidth(), dimension.getWidth() - column),
+        minimum(tileDimension.getHeight(), dimension.getHeight() - row)
+      )
+    );
+  }
+
+  bool TileScheduler::take(unsigned int worker, MemorySize& tile) noexcept {
+    Deque& deque = *deques.getElements()[worker];
+    deque.guard.exclusiveLock();
+    const bool result = deque.begin < deque.end;
+    if (result) {
+      tile = deque.begin++;
+    }
+    deque.guard.releaseLock();
+    return result;
+  }
+
+  bool TileScheduler::steal(unsigned int worker) noexcept {
+    const unsigned int workers = static_cast<unsigned int>(deques.getSize());
+    Deque& own = *deques.getElements()[worker];
+    for (unsigned int i = 1; i < workers; ++i) {
+      Deque& victim = *deques.getElements()[(worker + i) % workers];
+      victim.guard.exclusiveLock();
+      const MemorySize remaining = victim.end - victim.begin;
+      if (remaining == 0) {
+        victim.guard.releaseLock();
+        continue;
+      }
+      const MemorySize count = (remaining + 1)/2; // back half
+      const MemorySize end = victim.end;
+      victim.end -= count;
+      victim.guard.releaseLock();
+
+      own.guard.exclusiveLock();
+      own.begin = end - count;
+      own.end = end;
+      own.guard.releaseLock();
+      return true;
+    }
+    return false;
+  }
+
+  void TileScheduler::prepareWorkers(unsigned int workers) {
+    if (deques.getSize() == workers) {
+      return;
+    }
+    for (MemorySize i = 0; i < deques.getSize(); ++i) {
+      delete deques.getElements()[i];
+    }
+    deques.setSize(0);
+    deques.setSize(workers);
+    fill<Deque*>(deques.getElements(), workers, nullptr);
+    for (unsigned int i = 0; i < workers; ++i) {
+      deques.getElements()[i] = new Deque();
+    }
+    statistics.setSize(workers);
+    resetStatistics();
+  }
+
+  void TileScheduler::execute(const Dimension& _dimension, Task& task) {
+    if (!_dimension.isProper()) {
+      return;
+    }
+    const unsigned int workers = pool.getNumberOfThreads();
+    prepareWorkers(workers);
+
+    dimension = _dimension;
+    tilesPerRow = (dimension.getWidth() + tileDimension.getWidth() - 1)/tileDimension.getWidth();
+    const unsigned int tilesPerColumn = (dimension.getHeight() + tileDimension.getHeight() - 1)/tileDimension.getHeight();
+    const MemorySize tiles = static_cast<MemorySize>(tilesPerRow) * tilesPerColumn;
+
+    // contiguous runs of tiles for locality
+    for (unsigned int i = 0; i < workers; ++i) {
+      Deque& deque = *deques.getElements()[i];
+      deque.begin = tiles * i/workers;
+      deque.end = tiles * (i + 1)/workers;
+    }
+
+    WorkerStatistics* worker = statistics.getElements();
+    Allocator<uint64> busy(workers);
+    for (unsigned int i = 0; i < workers; ++i) {
+      busy.getElements()[i] = worker[i].busyMicroseconds;
+    }
+
+    static Metrics::Counter counter("TileScheduler");
+    Metrics::Scope scope(counter);
+    scope.setProcessed(static_cast<uint64>(dimension.getWidth()) * dimension.getHeight(), 0);
+
+    Schedule schedule(*this, task);
+    Timer timer;
+    pool.execute(schedule, workers);
+    const uint64 elapsed = timer.getLiveMicroseconds();
+
+    for (unsigned int i = 0; i < workers; ++i) {
+      const uint64 delta = worker[i].busyMicroseconds - busy.getElements()[i];
+      worker[i].idleMicroseconds += (elapsed > delta) ? (elapsed - delta) : 0;
+    }
+  }
+
+  TileScheduler::WorkerStatistics TileScheduler::getStatistics(unsigned int worker) const noexcept {
+    if (worker < statistics.getSize()) {
+      return statistics.getElements()[worker];
+    }
+    return WorkerStatistics();
+  }
+
+  void TileScheduler::resetStatistics() noexcept {
+    fill<WorkerStatistics>(statistics.getElements(), statistics.getSize(), WorkerStatistics());
+  }
+
+  TileScheduler::~TileScheduler() noexcept {
+    for (MemorySize i = 0; i < deques.getSize(); ++i) {
+      delete deques.getElements()[i];
+    }
+  }
+
+}; // end of gip namespace
@@ -0,0 +1,259 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#pragma once
+
+#include <gip/ThreadPool.h>
+#include <gip/Region.h>
+#include <base/mem/Allocator.h>
+#include <base/concurrency/MutualExclusion.h>
+#include <base/Primitives.h>
+
+namespace gip {
+
+  /**
+    Work-stealing scheduler of tile-granular image tasks. The image is split
+    into tiles which are initially distributed in contiguous runs over one
+    deque per worker. A worker takes tiles from the front of its own deque
+    and, when it runs out, steals the back half of the deque of another
+    worker. Thus tasks with varying cost per tile (e.g. sparse voting or
+    anti-aliased drawing) stay balanced while neighboring tiles are mostly
+    processed by the same worker.
+
+    A worker is a thread of the pool identified by
+    ThreadPool::getThreadIndex(). The tiles of a worker which executes no
+    part of the schedule are stolen by the others. The busy and idle time of
+    each worker is recorded for tuning the tile dimension. A scheduler
+    executes one image at a time.
+
+    @code
+    TileScheduler scheduler;
+    scheduler.apply(transformation); // uses operator()(const Region&)
+    scheduler.forEachTile(dimension, [&](const Region& tile) {...});
+    @endcode
+
+    @short Work-stealing tile scheduler.
+    @see ThreadPool Region
+    @version 1.0
+  */
+
+  class _COM_AZURE_DEV__GIP__API TileScheduler : public Object {
+  public:
+
+    /** The default tile dimension. */
+    static constexpr unsigned int DEFAULT_TILE_SIZE = 64;
+
+    /**
+      A task executed for each tile. Invoked concurrently for different tiles.
+    */
+    class _COM_AZURE_DEV__GIP__API Task {
+    public:
+
+      /**
+        Executes the task for the specified tile.
+      */
+      virtual void execute(const Region& tile) = 0;
+
+      virtual ~Task() noexcept {
+      }
+    };
+
+    /**
+      The statistics of a worker for the last execution(s).
+    */
+    class WorkerStatistics {
+    public:
+
+      /** The number of tiles executed. */
+      MemorySize tiles = 0;
+      /** The number of successful steals. */
+      MemorySize steals = 0;
+      /** The time spent executing tiles in microseconds. */
+      uint64 busyMicroseconds = 0;
+      /** The time spent without tiles in microseconds. */
+      uint64 idleMicroseconds = 0;
+    };
+  private:
+
+    /** The tiles owned by a worker. The owner takes from the front. */
+    class Deque {
+    public:
+
+      MutualExclusion guard;
+      /** The first remaining tile. */
+      MemorySize begin = 0;
+      /** The end of the remaining tiles. */
+      MemorySize end = 0;
+    };
+
+    /** Executes the work loop of each worker. */
+    class Schedule : public ThreadPool::Task {
+    private:
+
+      TileScheduler& scheduler;
+      Task& task;
+    public:
+
+      inline Schedule(TileScheduler& _scheduler, Task& _task) noexcept
+        : scheduler(_scheduler), task(_task) {
+      }
+
+      void execute(unsigned int part);
+    };
+
+    /** Adapter for functions and lambdas. */
+    template<class FUNCTION>
+    class FunctionTask : public Task {
+    private:
+
+      FUNCTION& function;
+    public:
+
+      inline FunctionTask(FUNCTION& _function) noexcept : function(_function) {
+      }
+
+      void execute(const Region& tile) {
+        function(tile);
+      }
+    };
+
+    /** Adapter for transformations with operator()(const Region&). */
+    template<class TRANSFORMATION>
+    class TransformationTask : public Task {
+    private:
+
+      TRANSFORMATION& transformation;
+    public:
+
+      inline TransformationTask(TRANSFORMATION& _transformation) noexcept
+        : transformation(_transformation) {
+      }
+
+      void execute(const Region& tile) {
+        transformation(tile);
+      }
+    };
+
+    /** The pool executing the workers. */
+    ThreadPool& pool;
+    /** The tile dimension. */
+    Dimension tileDimension;
+    /** The deques of the workers. */
+    Allocator<Deque*> deques;
+    /** The statistics of the workers. */
+    Allocator<WorkerStatistics> statistics;
+    /** The dimension of the current image. */
+    Dimension dimension;
+    /** The number of tiles per row of the current image. */
+    unsigned int tilesPerRow = 0;
+
+    /**
+      Returns the region of the specified tile.
+    */
+    Region getTile(MemorySize index) const noexcept;
+
+    /**
+      Takes the next tile of the specified worker. Returns false if none.
+    */
+    bool take(unsigned int worker, MemorySize& tile) noexcept;
+
+    /**
+      Moves tiles from another worker to the specified worker. Returns false
+      if all the deques are empty.
+    */
+    bool steal(unsigned int worker) noexcept;
+
+    /**
+      Makes sure there is a deque and statistics for each worker.
+    */
+    void prepareWorkers(unsigned int workers);
+
+    TileScheduler(const TileScheduler& copy) = delete;
+    TileScheduler& operator=(const TileScheduler& assign) = delete;
+  public:
+
+    /**
+      Initializes the scheduler.
+
+      @param pool The thread pool. The default pool if not specified.
+      @param tileDimension The tile dimension. 64x64 if not specified.
+    */
+    TileScheduler(
+      ThreadPool& pool = ThreadPool::getDefault(),
+      const Dimension& tileDimension = Dimension(DEFAULT_TILE_SIZE, DEFAULT_TILE_SIZE));
+
+    /**
+      Returns the tile dimension.
+    */
+    inline const Dimension& getTileDimension() const noexcept {
+      return tileDimension;
+    }
+
+    /**
+      Sets the tile dimension. Raises ImageException if the dimension is not proper.
+    */
+    void setTileDimension(const Dimension& tileDimension);
+
+    /**
+      Executes the task for all the tiles of an image of the specified
+      dimension. Raises ImageException if the task raised an exception.
+    */
+    void execute(const Dimension& dimension, Task& task);
+
+    /**
+      Invokes the specified function (e.g. a lambda) with the region of each
+      tile. The function is invoked concurrently.
+    */
+    template<class FUNCTION>
+    inline void forEachTile(const Dimension& dimension, FUNCTION function) {
+      FunctionTask<FUNCTION> task(function);
+      execute(dimension, task);
+    }
+
+    /**
+      Executes the specified transformation tile by tile. The transformation
+      must provide operator()(const Region&) (e.g. Convolution3x3,
+      MedianFilter3x3 and Scale). The destination is detached from any
+      shared elements before the tiles are executed concurrently.
+    */
+    template<class TRANSFORMATION>
+    inline void apply(TRANSFORMATION& transformation) {
+      transformation.getDestination()->getElements(); // copy-on-write happens here and not within the workers
+      TransformationTask<TRANSFORMATION> task(transformation);
+      execute(transformation.getDestination()->getDimension(), task);
+    }
+
+    /**
+      Returns the number of workers (the number of threads of the pool).
+    */
+    inline unsigned int getNumberOfWorkers() const noexcept {
+      return pool.getNumberOfThreads();
+    }
+
+    /**
+      Returns the accumulated statistics of the specified worker.
+    */
+    WorkerStatistics getStatistics(unsigned int worker) const noexcept;
+
+    /**
+      Resets the statistics of all the workers.
+    */
+    void resetStatistics() noexcept;
+
+    /**
+      Releases the scheduler.
+    */
+    ~TileScheduler() noexcept;
+  };
+
+}; // end of gip namespace
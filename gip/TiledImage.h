@@ -0,0 +1,355 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#pragma once
+
+#include <gip/Image.h>
+#include <gip/ImageBuffer.h>
+#include <gip/CopyOnWriteMonitor.h>
+#include <gip/Point2D.h>
+#include <base/mem/Allocator.h>
+#include <base/mem/Reference.h>
+#include <utility>
+
+namespace gip {
+
+/**
+  An image with the elements stored in square tiles. The elements of a tile
+  are stored row by row (i.e. element (row, column) of a tile is at row *
+  TILE_SIZE + column) and the tiles are stored in Z-order (Morton order).
+  Thus both horizontal and vertical neighbors are usually within the same
+  few pages and cache lines which benefits column-oriented and rotating
+  transformations of large images. The tiles at the right and bottom edges
+  are padded. Tiles are accessed in storage order using getTiles() and at
+  random using getTile().
+
+  @short Image stored in Morton-ordered tiles.
+  @ingroup images
+  @see Tiling
+  @version 1.0
+*/
+
+template<class PIXEL, unsigned int TILE_SIZE = 64>
+class TiledImage : public Image<PIXEL> {
+public:
+
+  /** The type of the pixels. */
+  typedef typename Image<PIXEL>::Pixel Pixel;
+
+  static_assert((TILE_SIZE > 0) && ((TILE_SIZE & (TILE_SIZE - 1)) == 0), "Tile size must be a power of 2.");
+
+  /** The number of rows and columns of a tile. */
+  static constexpr unsigned int TILE_DIMENSION = TILE_SIZE;
+  /** The number of elements of a tile. */
+  static constexpr unsigned int TILE_ELEMENTS = TILE_SIZE * TILE_SIZE;
+  /** The alignment of the tiles in bytes. */
+  static constexpr unsigned int TILE_ALIGNMENT = 64;
+
+  /**
+    Iterator of the tiles in storage order.
+  */
+  template<class POINTER>
+  class TileIteratorImpl {
+  private:
+
+    /** The first element of the image. */
+    POINTER elements = nullptr;
+    /** The tile coordinates in storage order. */
+    const Point2D* positions = nullptr;
+    /** The dimension of the image. */
+    Dimension dimension;
+  public:
+
+    inline TileIteratorImpl(POINTER _elements, const Point2D* _positions, const Dimension& _dimension) noexcept
+      : elements(_elements), positions(_positions), dimension(_dimension) {
+    }
+
+    /**
+      Returns the row and column of the tile (in units of tiles).
+    */
+    inline const Point2D& getTilePosition() const noexcept {
+      return *positions;
+    }
+
+    /**
+      Returns the position of the first element of the tile within the image.
+    */
+    inline Point2D getOffset() const noexcept {
+      return Point2D(positions->getRow() * TILE_SIZE, positions->getColumn() * TILE_SIZE);
+    }
+
+    /**
+      Returns the dimension of the part of the tile within the image. This is
+      less than a full tile at the right and bottom edges.
+    */
+    inline Dimension getDimension() const noexcept {
+      const unsigned int row = positions->getRow() * TILE_SIZE;
+      const unsigned int column = positions->getColumn() * TILE_SIZE;
+      const unsigned int width = dimension.getWidth() - column;
+      const unsigned int height = dimension.getHeight() - row;
+      return Dimension((width < TILE_SIZE) ? width : TILE_SIZE, (height < TILE_SIZE) ? height : TILE_SIZE);
+    }
+
+    /**
+      Returns the first element of the tile. Row i of the tile starts at
+      getElements() + i * TILE_SIZE.
+    */
+    inline POINTER getElements() const noexcept {
+      return elements;
+    }
+
+    inline TileIteratorImpl& operator++() noexcept {
+      elements += TILE_ELEMENTS;
+      ++positions;
+      return *this;
+    }
+
+    inline bool operator==(const TileIteratorImpl& right) const noexcept {
+      return positions == right.positions;
+    }
+
+    inline bool operator!=(const TileIteratorImpl& right) const noexcept {
+      return positions != right.positions;
+    }
+  };
+
+  typedef TileIteratorImpl<Pixel*> TileIterator;
+  typedef TileIteratorImpl<const Pixel*> ReadableTileIterator;
+private:
+
+  /** The elements of the image. */
+  Reference<ImageBuffer<Pixel> > elements;
+  /** The number of tiles per row of tiles. */
+  unsigned int tileColumns = 0;
+  /** The number of rows of tiles. */
+  unsigned int tileRows = 0;
+  /** The storage index of each tile (row-major by tile position). */
+  Allocator<unsigned int> indices;
+  /** The position of each tile in storage order. */
+  Allocator<Point2D> positions;
+
+  /**
+    Returns the number of tiles required along the specified length.
+  */
+  static inline unsigned int getTiles(unsigned int length) noexcept {
+    return length/TILE_SIZE + ((length % TILE_SIZE) ? 1 : 0);
+  }
+
+  /**
+    Returns the number of tiles of the image. Raises ImageException if the
+    number of tiles is not representable.
+  */
+  static MemorySize getNumberOfTiles(const Dimension& dimension);
+
+  /**
+    Assigns storage indices to the tiles within the square of tiles at the
+    specified position in Z-order. Returns the next free index.
+  */
+  unsigned int order(unsigned int row, unsigned int column, unsigned int size, unsigned int index) noexcept;
+public:
+
+  /**
+    Initializes empty image.
+  */
+  TiledImage()
+    : Image<Pixel>(Dimension(0, 0)), elements(new ImageBuffer<Pixel>(0)) {
+  }
+
+  /**
+    Initializes the image to the specified dimension. The elements are not
+    initialized.
+
+    @param dimension The desired dimension of the image.
+  */
+  TiledImage(const Dimension& dimension);
+
+  /**
+    Initializes the image from other image. The elements are shared until
+    modified.
+  */
+  TiledImage(const TiledImage& copy)
+    : Image<Pixel>(copy),
+      elements(copy.elements),
+      tileColumns(copy.tileColumns),
+      tileRows(copy.tileRows),
+      indices(copy.indices),
+      positions(copy.positions) {
+  }
+
+  /**
+    Initializes the image from other image. The elements and the tile order
+    are taken over.
+  */
+  TiledImage(TiledImage&& move) noexcept
+    : Image<Pixel>(std::move(move)),
+      elements(std::move(move.elements)),
+      tileColumns(move.tileColumns),
+      tileRows(move.tileRows),
+      indices(std::move(move.indices)),
+      positions(std::move(move.positions)) {
+  }
+
+  TiledImage& operator=(const TiledImage& eq) {
+    Image<Pixel>::operator=(eq);
+    elements = eq.elements;
+    tileColumns = eq.tileColumns;
+    tileRows = eq.tileRows;
+    indices = eq.indices;
+    positions = eq.positions;
+    return *this;
+  }
+
+  /**
+    Returns the number of tiles per row of tiles.
+  */
+  inline unsigned int getTileColumns() const noexcept {
+    return tileColumns;
+  }
+
+  /**
+    Returns the number of rows of tiles.
+  */
+  inline unsigned int getTileRows() const noexcept {
+    return tileRows;
+  }
+
+  /**
+    Returns the first element of the specified tile for modifying access.
+    This will force the image to be copied if shared by multiple image
+    objects.
+
+    @param row The row of the tile (in units of tiles).
+    @param column The column of the tile (in units of tiles).
+  */
+  inline Pixel* getTile(unsigned int row, unsigned int column) {
+    BASSERT((row < tileRows) && (column < tileColumns));
+    return getElements() + static_cast<MemorySize>(indices.getElements()[row * tileColumns + column]) * TILE_ELEMENTS;
+  }
+
+  /**
+    Returns the first element of the specified tile for non-modifying access.
+  */
+  inline const Pixel* getTile(unsigned int row, unsigned int column) const noexcept {
+    BASSERT((row < tileRows) && (column < tileColumns));
+    return getElements() + static_cast<MemorySize>(indices.getElements()[row * tileColumns + column]) * TILE_ELEMENTS;
+  }
+
+  /**
+    Returns the specified element for non-modifying access. Use the tiles
+    directly for bulk access.
+  */
+  inline const Pixel& getElement(unsigned int row, unsigned int column) const noexcept {
+    return getTile(row/TILE_SIZE, column/TILE_SIZE)[(row % TILE_SIZE) * TILE_SIZE + column % TILE_SIZE];
+  }
+
+  /**
+    Returns the first tile in storage order for modifying access. This will
+    force the image to be copied if shared by multiple image objects.
+  */
+  inline TileIterator getTiles() {
+    return TileIterator(getElements(), positions.getElements(), Image<Pixel>::getDimension());
+  }
+
+  /**
+    Returns the first tile in storage order for non-modifying access.
+  */
+  inline ReadableTileIterator getTiles() const noexcept {
+    return ReadableTileIterator(getElements(), positions.getElements(), Image<Pixel>::getDimension());
+  }
+
+  /**
+    Returns the end of the tiles for modifying access.
+  */
+  inline TileIterator getEndOfTiles() {
+    return TileIterator(nullptr, positions.getElements() + positions.getSize(), Image<Pixel>::getDimension());
+  }
+
+  /**
+    Returns the end of the tiles for non-modifying access.
+  */
+  inline ReadableTileIterator getEndOfTiles() const noexcept {
+    return ReadableTileIterator(nullptr, positions.getElements() + positions.getSize(), Image<Pixel>::getDimension());
+  }
+
+  /**
+    Returns the elements of the image for modifying access. This will force
+    the image to be copied if shared by multiple image objects.
+  */
+  inline Pixel* getElements() {
+    const Pixel* previous = elements->getElements();
+    elements.copyOnWrite();
+    if (elements->getElements() != previous) {
+      CopyOnWriteMonitor::onCopy(elements->getSize() * sizeof(Pixel), "TiledImage::getElements");
+    }
+    return elements->getElements();
+  }
+
+  /**
+    Returns the elements of the image for non-modifying access.
+  */
+  inline const Pixel* getElements() const noexcept {
+    return elements->getElements();
+  }
+};
+
+template<class PIXEL, unsigned int TILE_SIZE>
+MemorySize TiledImage<PIXEL, TILE_SIZE>::getNumberOfTiles(const Dimension& dimension) {
+  const MemorySize count = static_cast<MemorySize>(getTiles(dimension.getWidth())) * getTiles(dimension.getHeight());
+  bassert(
+    (count <= PrimitiveTraits<unsigned int>::MAXIMUM) &&
+    (count <= PrimitiveTraits<MemorySize>::MAXIMUM/TILE_ELEMENTS),
+    ImageException("Image dimension limit exceeded")
+  );
+  return count;
+}
+
+template<class PIXEL, unsigned int TILE_SIZE>
+unsigned int TiledImage<PIXEL, TILE_SIZE>::order(
+  unsigned int row, unsigned int column, unsigned int size, unsigned int index) noexcept {
+  if ((row >= tileRows) || (column >= tileColumns)) {
+    return index; // outside image
+  }
+  if (size == 1) {
+    indices.getElements()[row * tileColumns + column] = index;
+    positions.getElements()[index] = Point2D(row, column);
+    return index + 1;
+  }
+  const unsigned int half = size/2;
+  index = order(row, column, half, index);
+  index = order(row, column + half, half, index);
+  index = order(row + half, column, half, index);
+  return order(row + half, column + half, half, index);
+}
+
+template<class PIXEL, unsigned int TILE_SIZE>
+TiledImage<PIXEL, TILE_SIZE>::TiledImage(const Dimension& dimension)
+  : Image<Pixel>(dimension),
+    elements(new ImageBuffer<Pixel>(getNumberOfTiles(dimension) * TILE_ELEMENTS, TILE_ALIGNMENT)),
+    tileColumns(getTiles(dimension.getWidth())),
+    tileRows(getTiles(dimension.getHeight())) {
+  const MemorySize count = static_cast<MemorySize>(tileColumns) * tileRows;
+  indices.setSize(count);
+  positions.setSize(count);
+  unsigned int size = 1;
+  while ((size < tileColumns) || (size < tileRows)) {
+    size *= 2;
+  }
+  order(0, 0, size, 0);
+}
+
+typedef TiledImage<GrayPixel> TiledGrayImage;
+typedef TiledImage<Gray8Pixel> TiledGray8Image;
+typedef TiledImage<ColorPixel> TiledColorImage;
+typedef TiledImage<float> TiledFloatImage;
+
+}; // end of gip namespace
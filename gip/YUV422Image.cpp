@@ -12,6 +12,7 @@
  ***************************************************************************/
 
 #include <gip/YUV422Image.h>
+#include <utility>
 
 namespace gip {
 
@@ -26,37 +27,50 @@ namespace gip {
   }
 
   YUV422Image::YUV422Image(const YUV422Image& copy) noexcept
-          : y(copy.y), u(copy.u), v(copy.v) {
+          : Image<uint8>(copy), y(copy.y), u(copy.u), v(copy.v) {
+  }
+
+  YUV422Image::YUV422Image(YUV422Image&& move) noexcept
+          : Image<uint8>(std::move(move)), y(std::move(move.y)), u(std::move(move.u)), v(std::move(move.v)) {
   }
 
   YUV422Image& YUV422Image::operator=(const YUV422Image& eq) noexcept {
+    Image<uint8>::operator=(eq);
     y = eq.y;
     u = eq.u;
     v = eq.v;
     return *this;
   }
 
-  ArrayImage<uint8> YUV422Image::getY() noexcept {
+  YUV422Image& YUV422Image::operator=(YUV422Image&& move) noexcept {
+    Image<uint8>::operator=(std::move(move));
+    y = std::move(move.y);
+    u = std::move(move.u);
+    v = std::move(move.v);
+    return *this;
+  }
+
+  ArrayImage<uint8>& YUV422Image::getY() noexcept {
     return y;
   }
 
-  const ArrayImage<uint8> YUV422Image::getY() const noexcept {
+  const ArrayImage<uint8>& YUV422Image::getY() const noexcept {
     return y;
   }
 
-  ArrayImage<uint8> YUV422Image::getU() noexcept {
+  ArrayImage<uint8>& YUV422Image::getU() noexcept {
     return u;
   }
 
-  const ArrayImage<uint8> YUV422Image::getU() const noexcept {
+  const ArrayImage<uint8>& YUV422Image::getU() const noexcept {
     return u;
   }
 
-  ArrayImage<uint8> YUV422Image::getV() noexcept {
+  ArrayImage<uint8>& YUV422Image::getV() noexcept {
     return v;
   }
   
-  const ArrayImage<uint8> YUV422Image::getV() const noexcept {
+  const ArrayImage<uint8>& YUV422Image::getV() const noexcept {
     return v;
   }
   
@@ -52,40 +52,52 @@ namespace gip {
     */
     YUV422Image(const YUV422Image& copy) noexcept;
 
+    /**
+      Initialization of image by image. The components are taken over from
+      the other image.
+    */
+    YUV422Image(YUV422Image&& move) noexcept;
+
     /**
       Default assigment of image.
     */
     YUV422Image& operator=(const YUV422Image& eq) noexcept;
 
+    /**
+      Assignment of image by image. The components are taken over from the
+      other image.
+    */
+    YUV422Image& operator=(YUV422Image&& move) noexcept;
+
     /**
       Returns the Y component frame.
     */
-    ArrayImage<uint8> getY() noexcept;
+    ArrayImage<uint8>& getY() noexcept;
 
     /**
       Returns the Y component frame.
     */
-    const ArrayImage<uint8> getY() const noexcept;
+    const ArrayImage<uint8>& getY() const noexcept;
 
     /**
       Returns the U component frame.
     */
-    ArrayImage<uint8> getU() noexcept;
+    ArrayImage<uint8>& getU() noexcept;
     
     /**
       Returns the U component frame.
     */
-    const ArrayImage<uint8> getU() const noexcept;
+    const ArrayImage<uint8>& getU() const noexcept;
 
     /**
       Returns the V component frame.
     */
-    ArrayImage<uint8> getV() noexcept;
+    ArrayImage<uint8>& getV() noexcept;
     
     /**
       Returns the V component frame.
     */
-    const ArrayImage<uint8> getV() const noexcept;
+    const ArrayImage<uint8>& getV() const noexcept;
   };
   
 }; // end of namespace gip
@@ -27,9 +27,9 @@ namespace gip {
   private:
 
     /** The gray histogram. */
-    Array<unsigned int> histogram;
+    Array<MemorySize> histogram;
     /** The histogram elements. */
-    unsigned int* elements = nullptr;
+    MemorySize* elements = nullptr;
   public:
 
     Histogram()
@@ -38,6 +38,18 @@ namespace gip {
       reset();
     }
 
+    Histogram(const Histogram& copy)
+      : histogram(copy.histogram), elements(histogram.getElements()) // detach from copy
+    {
+    }
+
+    Histogram& operator=(const Histogram& assign)
+    {
+      histogram = assign.histogram;
+      elements = histogram.getElements(); // detach from assign
+      return *this;
+    }
+
     inline void operator()(const GrayPixel& value) noexcept
     {
       ++elements[value];
@@ -45,10 +57,91 @@ namespace gip {
 
     void reset() noexcept
     {
-      fill<unsigned int>(histogram.getElements(), histogram.getSize(), 0);
+      fill<MemorySize>(histogram.getElements(), histogram.getSize(), 0);
+    }
+
+    /**
+      Returns an empty histogram for accumulating a part of the pixels.
+    */
+    Histogram clone() const
+    {
+      return Histogram();
     }
 
-    const Array<unsigned int>& getHistogram() const noexcept {
+    /**
+      Adds the frequencies of the specified histogram.
+    */
+    void merge(const Histogram& partial) noexcept
+    {
+      const MemorySize* src = partial.histogram.getElements();
+      for (MemorySize i = 0; i < histogram.getSize(); ++i) {
+        elements[i] += src[i];
+      }
+    }
+
+    const Array<MemorySize>& getHistogram() const noexcept {
+      return histogram;
+    }
+  };
+
+  template<>
+  class Histogram<Gray8Pixel> : public UnaryOperation<Gray8Pixel, void> {
+  private:
+
+    /** The gray histogram. */
+    Array<MemorySize> histogram;
+    /** The histogram elements. */
+    MemorySize* elements = nullptr;
+  public:
+
+    Histogram()
+      : histogram(PixelTraits<Gray8Pixel>::MAXIMUM + 1, 0), elements(histogram.getElements())
+    {
+      reset();
+    }
+
+    Histogram(const Histogram& copy)
+      : histogram(copy.histogram), elements(histogram.getElements()) // detach from copy
+    {
+    }
+
+    Histogram& operator=(const Histogram& assign)
+    {
+      histogram = assign.histogram;
+      elements = histogram.getElements(); // detach from assign
+      return *this;
+    }
+
+    inline void operator()(const Gray8Pixel& value) noexcept
+    {
+      ++elements[value];
+    }
+
+    void reset() noexcept
+    {
+      fill<MemorySize>(histogram.getElements(), histogram.getSize(), 0);
+    }
+
+    /**
+      Returns an empty histogram for accumulating a part of the pixels.
+    */
+    Histogram clone() const
+    {
+      return Histogram();
+    }
+
+    /**
+      Adds the frequencies of the specified histogram.
+    */
+    void merge(const Histogram& partial) noexcept
+    {
+      const MemorySize* src = partial.histogram.getElements();
+      for (MemorySize i = 0; i < histogram.getSize(); ++i) {
+        elements[i] += src[i];
+      }
+    }
+
+    const Array<MemorySize>& getHistogram() const noexcept {
       return histogram;
     }
   };
@@ -64,26 +157,57 @@ namespace gip {
   class _COM_AZURE_DEV__GIP__API GrayHistogram : public UnaryOperation<GrayPixel, void> {
   public:
 
-    typedef Array<unsigned int> Histogram;
+    typedef Array<MemorySize> Histogram;
   private:
 
     /** The gray histogram. */
     Histogram gray;
     /** The histogram elements. */
-    unsigned int* elements = nullptr;
+    MemorySize* elements = nullptr;
   public:
 
     GrayHistogram()
       : gray(PixelTraits<GrayPixel>::MAXIMUM + 1, 0), elements(gray.getElements()) {
       reset();
     }
+
+    GrayHistogram(const GrayHistogram& copy)
+      : gray(copy.gray), elements(gray.getElements()) { // detach from copy
+    }
+
+    GrayHistogram& operator=(const GrayHistogram& assign) {
+      gray = assign.gray;
+      elements = gray.getElements(); // detach from assign
+      return *this;
+    }
  
     inline void operator()(const Argument& value) noexcept {
       ++elements[static_cast<unsigned char>(value)];
     }
 
+    inline void operator()(const Gray8Pixel& value) noexcept {
+      ++elements[value];
+    }
+
     void reset() noexcept {
-      fill<unsigned int>(gray.getElements(), gray.getSize(), 0);
+      fill<MemorySize>(gray.getElements(), gray.getSize(), 0);
+    }
+
+    /**
+      Returns an empty histogram for accumulating a part of the pixels.
+    */
+    GrayHistogram clone() const {
+      return GrayHistogram();
+    }
+
+    /**
+      Adds the frequencies of the specified histogram.
+    */
+    void merge(const GrayHistogram& partial) noexcept {
+      const MemorySize* src = partial.gray.getElements();
+      for (MemorySize i = 0; i < gray.getSize(); ++i) {
+        elements[i] += src[i];
+      }
     }
     
     const Histogram& getHistogram() const noexcept {
@@ -103,7 +227,7 @@ namespace gip {
   class _COM_AZURE_DEV__GIP__API ColorHistogram : public UnaryOperation<ColorPixel, void> {
   public:
 
-    typedef Array<unsigned int> Histogram;
+    typedef Array<MemorySize> Histogram;
   private:
 
     /** The red histogram. */
@@ -113,11 +237,11 @@ namespace gip {
     /** The blue histogram. */
     Histogram blue;
     /** The red histogram elements. */
-    unsigned int* redElements = nullptr;
+    MemorySize* redElements = nullptr;
     /** The green histogram elements. */
-    unsigned int* greenElements = nullptr;
+    MemorySize* greenElements = nullptr;
     /** The blue histogram elements. */
-    unsigned int* blueElements = nullptr;
+    MemorySize* blueElements = nullptr;
   public:
 
     ColorHistogram()
@@ -129,6 +253,25 @@ namespace gip {
         blueElements(blue.getElements()) { // TAG: #intensities depends on pixel type
       reset();
     }
+
+    ColorHistogram(const ColorHistogram& copy)
+      : red(copy.red),
+        green(copy.green),
+        blue(copy.blue),
+        redElements(red.getElements()),
+        greenElements(green.getElements()),
+        blueElements(blue.getElements()) { // detach from copy
+    }
+
+    ColorHistogram& operator=(const ColorHistogram& assign) {
+      red = assign.red;
+      green = assign.green;
+      blue = assign.blue;
+      redElements = red.getElements(); // detach from assign
+      greenElements = green.getElements();
+      blueElements = blue.getElements();
+      return *this;
+    }
     
     inline void operator()(const Argument& value) noexcept {
       ++redElements[static_cast<unsigned char>(value.red)];
@@ -137,9 +280,30 @@ namespace gip {
     }
 
     void reset() noexcept {
-      fill<unsigned int>(red.getElements(), red.getSize(), 0);
-      fill<unsigned int>(green.getElements(), green.getSize(), 0);
-      fill<unsigned int>(blue.getElements(), blue.getSize(), 0);
+      fill<MemorySize>(red.getElements(), red.getSize(), 0);
+      fill<MemorySize>(green.getElements(), green.getSize(), 0);
+      fill<MemorySize>(blue.getElements(), blue.getSize(), 0);
+    }
+
+    /**
+      Returns an empty histogram for accumulating a part of the pixels.
+    */
+    ColorHistogram clone() const {
+      return ColorHistogram();
+    }
+
+    /**
+      Adds the frequencies of the specified histogram.
+    */
+    void merge(const ColorHistogram& partial) noexcept {
+      const MemorySize* redSrc = partial.red.getElements();
+      const MemorySize* greenSrc = partial.green.getElements();
+      const MemorySize* blueSrc = partial.blue.getElements();
+      for (MemorySize i = 0; i < red.getSize(); ++i) {
+        redElements[i] += redSrc[i];
+        greenElements[i] += greenSrc[i];
+        blueElements[i] += blueSrc[i];
+      }
     }
 
     const Histogram& getBlueHistogram() const noexcept {
@@ -0,0 +1,283 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#pragma once
+
+#include <gip/ArrayImage.h>
+#include <gip/Region.h>
+#include <gip/ImageException.h>
+#include <base/mem/Allocator.h>
+
+namespace gip {
+
+  /**
+    The channels of a pixel and the type of their sums within an
+    IntegralImage. Integer samples are summed exactly in 64 bits (the
+    squares of GrayPixel values are intended for samples of up to 16 bits).
+  */
+  template<class PIXEL>
+  class IntegralImageTraits {
+  public:
+
+    enum {CHANNELS = 1};
+    typedef long long Sum;
+
+    static inline Sum get(const PIXEL& pixel, unsigned int) noexcept {
+      return static_cast<Sum>(pixel);
+    }
+  };
+
+  template<>
+  class IntegralImageTraits<float> {
+  public:
+
+    enum {CHANNELS = 1};
+    typedef double Sum;
+
+    static inline Sum get(const float& pixel, unsigned int) noexcept {
+      return pixel;
+    }
+  };
+
+  template<>
+  class IntegralImageTraits<ColorPixel> {
+  public:
+
+    enum {CHANNELS = 3};
+    typedef long long Sum;
+
+    static inline Sum get(const ColorPixel& pixel, unsigned int channel) noexcept {
+      return (channel == 0) ? pixel.red : ((channel == 1) ? pixel.green : pixel.blue);
+    }
+  };
+
+  /**
+    Summed-area table of an image. The table is built in one pass and
+    returns the sum, mean and variance of the pixels of any region in
+    constant time. Color images have a table per component (red, green and
+    blue). The table of squared pixels required for the variance is
+    optional.
+
+    @code
+    IntegralImage<Gray8Image> table(image, true);
+    double mean = table.getMean(region);
+    double variance = table.getVariance(region);
+    @endcode
+
+    @short Summed-area table.
+    @ingroup analysis
+    @see BoxFilter
+    @version 1.0
+  */
+
+  template<class IMAGE>
+  class IntegralImage : public Object {
+  public:
+
+    /** The type of the source image. */
+    typedef IMAGE Image;
+    /** The pixel type. */
+    typedef typename Image::Pixel Pixel;
+    /** The traits of the pixel. */
+    typedef IntegralImageTraits<Pixel> Traits;
+    /** The type of the sums. */
+    typedef typename Traits::Sum Sum;
+
+    /** The number of channels. */
+    enum {CHANNELS = Traits::CHANNELS};
+  private:
+
+    /** The dimension of the source image. */
+    Dimension dimension;
+    /** The number of entries per row of the tables. */
+    MemorySize stride = 0;
+    /** The sums of the pixels above and to the left (with a leading row and column of zeros). */
+    Allocator<Sum> sums;
+    /** The sums of the squared pixels (empty if not kept). */
+    Allocator<Sum> squares;
+    /** Specifies that the squared sums are kept. */
+    bool squared = false;
+
+    /** Returns the sum of the specified table over the rows [firstRow; endRow) and columns [firstColumn; endColumn). */
+    inline Sum getBox(
+      const Sum* table,
+      unsigned int firstRow,
+      unsigned int firstColumn,
+      unsigned int endRow,
+      unsigned int endColumn,
+      unsigned int channel) const noexcept {
+      const Sum* top = table + firstRow * stride + channel;
+      const Sum* bottom = table + endRow * stride + channel;
+      const MemorySize left = firstColumn * CHANNELS;
+      const MemorySize right = endColumn * CHANNELS;
+      return bottom[right] - bottom[left] - top[right] + top[left];
+    }
+
+    /** Fills the tables. */
+    template<bool SQUARED>
+    void build(const Image& image) noexcept {
+      Sum* sum = sums.getElements();
+      Sum* square = squares.getElements();
+      for (MemorySize i = 0; i < stride; ++i) {
+        sum[i] = 0;
+        if (SQUARED) {
+          square[i] = 0;
+        }
+      }
+
+      typename Image::ReadableRows::RowIterator row = image.getRows().getFirst();
+      for (unsigned int y = 0; y < dimension.getHeight(); ++y, ++row) {
+        const Sum* previousSum = sum;
+        const Sum* previousSquare = square;
+        sum += stride;
+        if (SQUARED) {
+          square += stride;
+        }
+        Sum rowSum[CHANNELS];
+        Sum rowSquare[CHANNELS];
+        for (unsigned int channel = 0; channel < CHANNELS; ++channel) {
+          rowSum[channel] = 0;
+          rowSquare[channel] = 0;
+          sum[channel] = 0;
+          if (SQUARED) {
+            square[channel] = 0;
+          }
+        }
+
+        typename Image::ReadableRows::RowIterator::ElementIterator src = row.getFirst();
+        for (MemorySize i = CHANNELS; i < stride; i += CHANNELS, ++src) {
+          for (unsigned int channel = 0; channel < CHANNELS; ++channel) {
+            const Sum value = Traits::get(*src, channel);
+            rowSum[channel] += value;
+            sum[i + channel] = previousSum[i + channel] + rowSum[channel];
+            if (SQUARED) {
+              rowSquare[channel] += value * value;
+              square[i + channel] = previousSquare[i + channel] + rowSquare[channel];
+            }
+          }
+        }
+      }
+    }
+
+    /** Raises an exception if the region is empty or exceeds the image. */
+    inline void validate(const Region& region, unsigned int channel) const {
+      bassert(
+        region.isProper() && region.isWithin(dimension) && (channel < CHANNELS),
+        ImageException("Invalid region", this)
+      );
+    }
+  public:
+
+    /**
+      Builds the table.
+
+      @param image The source image.
+      @param squared Specifies that the sums of the squared pixels are kept (required for the variance).
+    */
+    IntegralImage(const Image& image, bool _squared = false)
+      : dimension(image.getDimension()),
+        stride((static_cast<MemorySize>(image.getWidth()) + 1) * CHANNELS),
+        sums(stride * (image.getHeight() + 1)),
+        squares(_squared ? (stride * (image.getHeight() + 1)) : 0),
+        squared(_squared) {
+      if (squared) {
+        build<true>(image);
+      } else {
+        build<false>(image);
+      }
+    }
+
+    /**
+      Returns the dimension of the source image.
+    */
+    inline const Dimension& getDimension() const noexcept {
+      return dimension;
+    }
+
+    /**
+      Returns true if the sums of the squared pixels are kept.
+    */
+    inline bool hasSquares() const noexcept {
+      return squared;
+    }
+
+    /**
+      Returns the sum of the pixels of the rows [firstRow; endRow) and the
+      columns [firstColumn; endColumn). The bounds are not checked.
+    */
+    inline Sum getSum(
+      unsigned int firstRow,
+      unsigned int firstColumn,
+      unsigned int endRow,
+      unsigned int endColumn,
+      unsigned int channel = 0) const noexcept {
+      return getBox(sums.getElements(), firstRow, firstColumn, endRow, endColumn, channel);
+    }
+
+    /**
+      Returns the sum of the pixels within the specified region.
+
+      @param region The region (must be proper and within the image).
+      @param channel The channel (the component for color images).
+    */
+    Sum getSum(const Region& region, unsigned int channel = 0) const {
+      validate(region, channel);
+      return getBox(
+        sums.getElements(),
+        region.getOffset().getRow(),
+        region.getOffset().getColumn(),
+        region.getEndRow(),
+        region.getEndColumn(),
+        channel
+      );
+    }
+
+    /**
+      Returns the sum of the squared pixels within the specified region.
+      Raises ImageException if the squared sums are not kept.
+    */
+    Sum getSquaredSum(const Region& region, unsigned int channel = 0) const {
+      validate(region, channel);
+      bassert(squared, ImageException("Squared sums are not available", this));
+      return getBox(
+        squares.getElements(),
+        region.getOffset().getRow(),
+        region.getOffset().getColumn(),
+        region.getEndRow(),
+        region.getEndColumn(),
+        channel
+      );
+    }
+
+    /**
+      Returns the mean of the pixels within the specified region.
+    */
+    double getMean(const Region& region, unsigned int channel = 0) const {
+      const Dimension dimension = region.getDimension();
+      return static_cast<double>(getSum(region, channel))/(static_cast<double>(dimension.getWidth()) * dimension.getHeight());
+    }
+
+    /**
+      Returns the (population) variance of the pixels within the specified
+      region. Raises ImageException if the squared sums are not kept.
+    */
+    double getVariance(const Region& region, unsigned int channel = 0) const {
+      const Dimension dimension = region.getDimension();
+      const double size = static_cast<double>(dimension.getWidth()) * dimension.getHeight(); // avoids overflow of getSize()
+      const double mean = getSum(region, channel)/size;
+      const double variance = getSquaredSum(region, channel)/size - mean * mean;
+      return (variance > 0) ? variance : 0; // cancellation may give a tiny negative value
+    }
+  };
+
+}; // end of gip namespace
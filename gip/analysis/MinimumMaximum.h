@@ -44,11 +44,31 @@ namespace gip {
     inline void operator()(const Pixel& value) noexcept {
       if (value > maximumValue) {
         maximumValue = value;
-      } else if (value < minimumValue) {
+      }
+      if (value < minimumValue) {
         minimumValue = value;
       }
     }
     
+    /**
+      Returns an empty operation for collecting a part of the values.
+    */
+    inline MinimumMaximum clone() const noexcept {
+      return MinimumMaximum();
+    }
+
+    /**
+      Includes the values collected by the specified operation.
+    */
+    inline void merge(const MinimumMaximum& partial) noexcept {
+      if (partial.maximumValue > maximumValue) {
+        maximumValue = partial.maximumValue;
+      }
+      if (partial.minimumValue < minimumValue) {
+        minimumValue = partial.minimumValue;
+      }
+    }
+
     inline Pixel getMinimum() const noexcept {
       return minimumValue;
     }
@@ -88,21 +108,55 @@ namespace gip {
     inline void operator()(const Pixel& value) noexcept {
       if (value.red > maximumValue.red) {
         maximumValue.red = value.red;
-      } else if (value.red < minimumValue.red) {
+      }
+      if (value.red < minimumValue.red) {
         minimumValue.red = value.red;
       }
       if (value.green > maximumValue.green) {
         maximumValue.green = value.green;
-      } else if (value.green < minimumValue.green) {
+      }
+      if (value.green < minimumValue.green) {
         minimumValue.green = value.green;
       }
       if (value.blue > maximumValue.blue) {
         maximumValue.blue = value.blue;
-      } else if (value.blue < minimumValue.blue) {
+      }
+      if (value.blue < minimumValue.blue) {
         minimumValue.blue = value.blue;
       }
     }
 
+    /**
+      Returns an empty operation for collecting a part of the values.
+    */
+    inline MinimumMaximum clone() const noexcept {
+      return MinimumMaximum();
+    }
+
+    /**
+      Includes the values collected by the specified operation.
+    */
+    inline void merge(const MinimumMaximum& partial) noexcept {
+      if (partial.maximumValue.red > maximumValue.red) {
+        maximumValue.red = partial.maximumValue.red;
+      }
+      if (partial.minimumValue.red < minimumValue.red) {
+        minimumValue.red = partial.minimumValue.red;
+      }
+      if (partial.maximumValue.green > maximumValue.green) {
+        maximumValue.green = partial.maximumValue.green;
+      }
+      if (partial.minimumValue.green < minimumValue.green) {
+        minimumValue.green = partial.minimumValue.green;
+      }
+      if (partial.maximumValue.blue > maximumValue.blue) {
+        maximumValue.blue = partial.maximumValue.blue;
+      }
+      if (partial.minimumValue.blue < minimumValue.blue) {
+        minimumValue.blue = partial.minimumValue.blue;
+      }
+    }
+
     inline Pixel getMinimum() const noexcept {
       return minimumValue;
     }
@@ -40,13 +40,13 @@ namespace gip {
     static constexpr unsigned int NUMBER_OF_SYMBOLS = PixelTraits<Pixel>::MAXIMUM + 1;
     
     /** The number of samples. */
-    unsigned int numberOfSamples = 0;
+    MemorySize numberOfSamples = 0;
     /** The pixel value frequencies. */
-    unsigned int frequency[NUMBER_OF_SYMBOLS];
+    MemorySize frequency[NUMBER_OF_SYMBOLS];
     /** The minimum frequency. */
-    unsigned int minimumFrequency = 0;
+    MemorySize minimumFrequency = 0;
     /** The maximum frequency. */
-    unsigned int maximumFrequency = 0;
+    MemorySize maximumFrequency = 0;
     /** The minimum pixel value. */
     Pixel minimum;
     /** The maximum pixel value. */
@@ -65,43 +65,89 @@ namespace gip {
     double entropy = 0;
   public:
     
+    /**
+      Initializes an empty statistic object. Pixels are accumulated with
+      operator() and the derived values are computed by update().
+    */
+    Statistic() noexcept {
+      fill<MemorySize>(frequency, getArraySize(frequency), 0);
+      update();
+    }
+
     /**
       Initializes the statistic object.
       
       @param image The source image.
     */
-    Statistic(const Image& image) noexcept
-      : numberOfSamples(image.getDimension().getSize()) {
+    Statistic(const Image& image) noexcept {
 
       // count frequency of each pixel value
-      fill<unsigned int>(frequency, getArraySize(frequency), 0);
+      fill<MemorySize>(frequency, getArraySize(frequency), 0);
       
       typename Image::ReadableRows rows = Cast::implicit<const Image>(image).getRows();
       typename Image::ReadableRows::RowIterator row = rows.getFirst();
       for (; row != rows.getEnd(); ++row) {
         typename Image::ReadableRows::RowIterator::ElementIterator column = row.getFirst();
         for (; column != row.getEnd(); ++column) {
-          unsigned int value = *column;
-          if ((value >= PixelTraits<Pixel>::MINIMUM) && (value <= PixelTraits<Pixel>::MAXIMUM)) {
-            ++frequency[value];
-          }
+          (*this)(*column);
         }
       }
-      
+      update();
+    }
+
+    /**
+      Accumulates the specified pixel. The derived values are not updated.
+    */
+    inline void operator()(const Pixel& pixel) noexcept {
+      unsigned int value = pixel;
+      if ((value >= PixelTraits<Pixel>::MINIMUM) && (value <= PixelTraits<Pixel>::MAXIMUM)) {
+        ++frequency[value];
+      }
+      ++numberOfSamples;
+    }
+
+    /**
+      Returns an empty statistic object for accumulating a part of the pixels.
+    */
+    inline Statistic clone() const noexcept {
+      return Statistic();
+    }
+
+    /**
+      Includes the pixels accumulated by the specified statistic object and
+      updates the derived values.
+    */
+    void merge(const Statistic& partial) noexcept {
+      numberOfSamples += partial.numberOfSamples;
+      for (unsigned int i = 0; i < NUMBER_OF_SYMBOLS; ++i) {
+        frequency[i] += partial.frequency[i];
+      }
+      update();
+    }
+
+    /**
+      Computes the derived values (mean, median, variance, ...) from the
+      accumulated frequencies.
+    */
+    void update() noexcept {
       mean = 0;
       for (unsigned int i = 0; i < NUMBER_OF_SYMBOLS; ++i) {
         mean += Cast::implicit<double>(i) * frequency[i];
       }
-      mean /= numberOfSamples;
+      if (numberOfSamples > 0) {
+        mean /= numberOfSamples;
+      }
       
-      int count = numberOfSamples/2;
+      MemoryDiff count = numberOfSamples/2;
       minimumFrequency = numberOfSamples;
       maximumFrequency = 0;
       minimum = PixelTraits<Pixel>::MAXIMUM;
       maximum = PixelTraits<Pixel>::MINIMUM;
       used = 0;
+      median = 0;
+      mode = 0;
       double sqrsum = 0;
-      entropy = numberOfSamples * Math::ln(Cast::implicit<double>(numberOfSamples));
+      entropy = (numberOfSamples > 0) ? numberOfSamples * Math::ln(Cast::implicit<double>(numberOfSamples)) : 0;
       for (unsigned int i = 0; i < NUMBER_OF_SYMBOLS; ++i) {
         if (frequency[i] != 0) {
           if (frequency[i] < minimumFrequency) {
@@ -116,7 +162,7 @@ namespace gip {
           }
           maximum = i;
           if (count >= 0) {
-            count -= frequency[i];
+            count -= static_cast<MemoryDiff>(frequency[i]);
             median = i;
           }
           ++used;
@@ -126,10 +172,12 @@ namespace gip {
           minimumFrequency = 0;
         }
       }
-      if (numberOfSamples == 0) {
+      if (numberOfSamples <= 1) {
         variance = 0;
       } else {
         variance = sqrsum/(numberOfSamples - 1);
+      }
+      if (numberOfSamples > 0) {
         entropy *= constant::LOG2E/numberOfSamples; // convert to binary units
       }
     }
@@ -137,7 +185,7 @@ namespace gip {
     /**
       Returns the number of values/samples.
     */
-    inline unsigned int getNumberOfSamples() const noexcept {
+    inline MemorySize getNumberOfSamples() const noexcept {
       return numberOfSamples;
     }
 
@@ -151,7 +199,7 @@ namespace gip {
     /**
       Returns the frequency of the specified pixel value.
     */
-    inline unsigned int getFrequency(Pixel value) const noexcept {
+    inline MemorySize getFrequency(Pixel value) const noexcept {
       if ((value >= PixelTraits<Pixel>::MINIMUM) && (value <= PixelTraits<Pixel>::MAXIMUM)) {
         return frequency[value];
       } else {
@@ -162,14 +210,14 @@ namespace gip {
     /**
       Returns the minimum frequency.
     */
-    inline unsigned int getMinimumFrequency() const noexcept {
+    inline MemorySize getMinimumFrequency() const noexcept {
       return minimumFrequency;
     }
 
     /**
       Returns the maximum frequency.
     */
-    inline unsigned int getMaximumFrequency() const noexcept {
+    inline MemorySize getMaximumFrequency() const noexcept {
       return maximumFrequency;
     }
 
@@ -14,6 +14,7 @@
 #pragma once
 
 #include <gip/ImageException.h>
+#include <gip/ThreadPool.h>
 
 namespace gip {
 
@@ -104,78 +105,349 @@ namespace gip {
   }
 
   /**
+    Partitioning of images into bands of consecutive rows for the parallel
+    traversals.
+
+    @short Row band partitioning
+    @version 1.0
+  */
+  class RowBands {
+  public:
+
+    /** The minimum number of pixels of an automatically sized band. */
+    static constexpr unsigned int MINIMUM_PIXELS = 16384;
+    /** The number of automatically sized bands per thread (for load balancing). */
+    static constexpr unsigned int BANDS_PER_THREAD = 4;
+
+    /**
+      Returns the number of rows per band.
+
+      @param dimension The dimension of the image.
+      @param grain The desired number of rows per band. 0 selects automatically.
+      @param pool The pool executing the bands.
+    */
+    static inline unsigned int getGrain(const Dimension& dimension, unsigned int grain, const ThreadPool& pool) noexcept {
+      if (grain > 0) {
+        return grain;
+      }
+      const unsigned int height = dimension.getHeight();
+      const unsigned int bands = pool.getNumberOfThreads() * BANDS_PER_THREAD;
+      const unsigned int byThreads = height/bands + ((height % bands) ? 1 : 0);
+      const unsigned int width = (dimension.getWidth() > 0) ? dimension.getWidth() : 1;
+      const unsigned int byPixels = MINIMUM_PIXELS/width + ((MINIMUM_PIXELS % width) ? 1 : 0);
+      const unsigned int result = (byThreads > byPixels) ? byThreads : byPixels;
+      return (result > 0) ? result : 1;
+    }
+
+    /**
+      Returns the number of bands.
+    */
+    static inline unsigned int getBands(unsigned int height, unsigned int grain) noexcept {
+      return height/grain + ((height % grain) ? 1 : 0);
+    }
+  };
+
+  /** Parallel forEach task. */
+  template<class IMAGE, class UNOPR>
+  class ForEachBands : public ThreadPool::Task {
+  private:
+
+    typename IMAGE::ReadableRows rows;
+    const unsigned int height = 0;
+    const unsigned int grain = 0;
+    UNOPR& function;
+  public:
+
+    ForEachBands(const IMAGE& image, unsigned int _grain, UNOPR& _function) noexcept
+      : rows(image.getRows()), height(image.getHeight()), grain(_grain), function(_function) {
+    }
+
+    void execute(unsigned int band) {
+      const unsigned int begin = band * grain;
+      const unsigned int end = (height - begin > grain) ? (begin + grain) : height;
+      typename IMAGE::ReadableRows::RowIterator row = rows.getFirst();
+      row += begin;
+      for (unsigned int count = end - begin; count > 0; --count, ++row) {
+        typename IMAGE::ReadableRows::RowIterator::ElementIterator column = row.getFirst();
+        for (; column != row.getEnd(); ++column) {
+          function(*column);
+        }
+      }
+    }
+  };
+
+  /**
+    Invokes the specified unary operation (non-modifying) for each element of
+    the specified image using several threads. The operation is invoked
+    concurrently and must be thread safe (see reduce() for stateful
+    operations).
+
+    @param image The image.
+    @param function The operation.
+    @param grain The number of rows per band. 0 selects automatically.
+    @param pool The thread pool. The default pool if not specified.
+  */
+  template<class IMAGE, class UNOPR>
+  void parallelForEach(
+    const IMAGE& image, UNOPR& function, unsigned int grain = 0, ThreadPool& pool = ThreadPool::getDefault()) {
+    grain = RowBands::getGrain(image.getDimension(), grain, pool);
+    ForEachBands<IMAGE, UNOPR> task(image, grain, function);
+    pool.execute(task, RowBands::getBands(image.getHeight(), grain));
+  }
+
+  /** Parallel transform task. */
+  template<class IMAGE, class UNOPR>
+  class TransformBands : public ThreadPool::Task {
+  private:
+
+    typename IMAGE::Rows rows;
+    const unsigned int height = 0;
+    const unsigned int grain = 0;
+    UNOPR& function;
+  public:
+
+    TransformBands(IMAGE& image, unsigned int _grain, UNOPR& _function)
+      : rows(image.getRows()), height(image.getHeight()), grain(_grain), function(_function) {
+    }
+
+    void execute(unsigned int band) {
+      const unsigned int begin = band * grain;
+      const unsigned int end = (height - begin > grain) ? (begin + grain) : height;
+      typename IMAGE::Rows::RowIterator row = rows.getFirst();
+      row += begin;
+      for (unsigned int count = end - begin; count > 0; --count, ++row) {
+        typename IMAGE::Rows::RowIterator::ElementIterator column = row.getFirst();
+        for (; column != row.getEnd(); ++column) {
+          *column = function(*column);
+        }
+      }
+    }
+  };
+
+  /**
+    Applies the specified operation on every element of the specified image
+    using several threads. The operation is invoked concurrently.
+
+    @param image The image.
+    @param function The operation.
+    @param grain The number of rows per band. 0 selects automatically.
+    @param pool The thread pool. The default pool if not specified.
+  */
+  template<class IMAGE, class UNOPR>
+  void parallelTransform(
+    IMAGE& image, UNOPR& function, unsigned int grain = 0, ThreadPool& pool = ThreadPool::getDefault()) {
+    grain = RowBands::getGrain(image.getDimension(), grain, pool);
+    TransformBands<IMAGE, UNOPR> task(image, grain, function); // copy-on-write happens here
+    pool.execute(task, RowBands::getBands(image.getHeight(), grain));
+  }
+
+  /** Parallel binary transform task. */
+  template<class LEFT, class RIGHT, class BINOPR>
+  class BinaryTransformBands : public ThreadPool::Task {
+  private:
+
+    typename LEFT::Rows rows;
+    typename RIGHT::ReadableRows rightRows;
+    const unsigned int height = 0;
+    const unsigned int grain = 0;
+    BINOPR& function;
+  public:
+
+    BinaryTransformBands(LEFT& left, const RIGHT& right, unsigned int _grain, BINOPR& _function)
+      : rows(left.getRows()),
+        rightRows(right.getRows()),
+        height(left.getHeight()),
+        grain(_grain),
+        function(_function) {
+    }
+
+    void execute(unsigned int band) {
+      const unsigned int begin = band * grain;
+      const unsigned int end = (height - begin > grain) ? (begin + grain) : height;
+      typename LEFT::Rows::RowIterator row = rows.getFirst();
+      typename RIGHT::ReadableRows::RowIterator rightRow = rightRows.getFirst();
+      row += begin;
+      rightRow += begin;
+      for (unsigned int count = end - begin; count > 0; --count, ++row, ++rightRow) {
+        typename LEFT::Rows::RowIterator::ElementIterator column = row.getFirst();
+        typename RIGHT::ReadableRows::RowIterator::ElementIterator rightColumn = rightRow.getFirst();
+        for (; column != row.getEnd(); ++column, ++rightColumn) {
+          *column = function(*column, *rightColumn);
+        }
+      }
+    }
+  };
+
+  /**
+    Combines the elements of the images using the specified binary operation
+    using several threads. The operation is invoked concurrently.
   */
-//template<class DEST, class LEFT, class RIGHT, class BINOPR>
-//inline void fillWithBinary(DEST& destination, const LSRC& left, const RSRC& right, BINOPR& function)  {
-//  // check if function is binary and write nice error if not???
-//  // typedef typename function::Result Result
-//  // typedef typename function::LeftArgument LeftArgument
-//  // typedef typename function::RightArgument RightArgument
-//  bassert(
-//    (destination.getDimension() == left.getDimension()) && (left.getDimension() == right.getDimension()),
-//    ImageException("Images must have identical dimension")
-//  );
-//  typename DEST::Rows rows = destination.getRows();
-//  typename DEST::Rows::RowIterator row = rows.getFirst();
-//  typename LEFT::ReadableRows::RowIterator leftRow = source.getRows().getFirst();
-//  typename RIGHT::ReadableRows::RowIterator rightRow = source.getRows().getFirst();
-//  while (row != rows.getEnd()) {
-//    typename DEST::Rows::RowIterator::ElementIterator column = row.getFirst();
-//    typename LEFT::ReadableRows::RowIterator::ElementIterator leftColumn = leftRow.getFirst();
-//    typename RIGHT::ReadableRows::RowIterator::ElementIterator rightColumn = rightRow.getFirst();
-//    while (column != row.getEnd()) {
-//      *column = function(*leftColumn, *rightColumn);
-//      ++column;
-//      ++leftColumn;
-//      ++rightColumn;
-//    }
-//    ++row;
-//    ++leftRow;
-//    ++rightRow;
-//  }
-//}
-
-//template<class PIXEL, class BINOPR>
-//class MergedImage : public Image<PIXEL> {
-//public:
-//
-//  template<class TRAITS>
-//  class RowIteratorImpl : public Iterator<TRAITS> {
-//  public:
-//
-//    typedef ArrayIteratorImpl<TRAITS> ElementIterator;
-//
-//    inline RowIteratorImpl(Pointer value, unsigned int columns) noexcept
-//      : InterleavedIteratorImpl<TRAITS>(value, columns) {
-//    }
-//
-//    inline RowIteratorImpl(const RowIteratorImpl& copy) noexcept
-//      : InterleavedIteratorImpl<TRAITS>(copy) {
-//    }
-//
-//    inline ElementIterator getFirst() const noexcept {
-//      return ElementIterator(current);
-//    }
-//
-//    inline ElementIterator getEnd() const noexcept {
-//      ElementIterator result(current);
-//      result += step;
-//      return result;
-//    }
-//
-//    inline ElementIterator operator[](unsigned int index) const noexcept {
-//      BASSERT(index < step);
-//      ElementIterator result(current);
-//      result += index;
-//      return result;
-//    }
-//  };
-//
-//private:
-//
-//public:
-//
-//
-//};
+  template<class LEFT, class RIGHT, class BINOPR>
+  void parallelTransform(
+    LEFT& left,
+    const RIGHT& right,
+    BINOPR& function,
+    unsigned int grain = 0,
+    ThreadPool& pool = ThreadPool::getDefault()) {
+    bassert(
+      left.getDimension() == right.getDimension(),
+      ImageException("Images must have identical dimension")
+    );
+    grain = RowBands::getGrain(left.getDimension(), grain, pool);
+    BinaryTransformBands<LEFT, RIGHT, BINOPR> task(left, right, grain, function);
+    pool.execute(task, RowBands::getBands(left.getHeight(), grain));
+  }
+
+  /** Parallel fillWithUnary task. */
+  template<class DEST, class SRC, class UNOPR>
+  class FillWithUnaryBands : public ThreadPool::Task {
+  private:
+
+    typename DEST::Rows rows;
+    typename SRC::ReadableRows srcRows;
+    const unsigned int height = 0;
+    const unsigned int grain = 0;
+    UNOPR& function;
+  public:
+
+    FillWithUnaryBands(DEST& destination, const SRC& source, unsigned int _grain, UNOPR& _function)
+      : rows(destination.getRows()),
+        srcRows(source.getRows()),
+        height(destination.getHeight()),
+        grain(_grain),
+        function(_function) {
+    }
+
+    void execute(unsigned int band) {
+      const unsigned int begin = band * grain;
+      const unsigned int end = (height - begin > grain) ? (begin + grain) : height;
+      typename DEST::Rows::RowIterator row = rows.getFirst();
+      typename SRC::ReadableRows::RowIterator srcRow = srcRows.getFirst();
+      row += begin;
+      srcRow += begin;
+      for (unsigned int count = end - begin; count > 0; --count, ++row, ++srcRow) {
+        typename DEST::Rows::RowIterator::ElementIterator column = row.getFirst();
+        typename SRC::ReadableRows::RowIterator::ElementIterator srcColumn = srcRow.getFirst();
+        for (; column != row.getEnd(); ++column, ++srcColumn) {
+          *column = function(*srcColumn);
+        }
+      }
+    }
+  };
+
+  /**
+    Applies the specified operation on every element of the source image and
+    stores the result in the destination image using several threads. The
+    operation is invoked concurrently.
+
+    @param destination The destination image.
+    @param source The source image.
+    @param function The operation.
+    @param grain The number of rows per band. 0 selects automatically.
+    @param pool The thread pool. The default pool if not specified.
+  */
+  template<class DEST, class SRC, class UNOPR>
+  void parallelFillWithUnary(
+    DEST& destination,
+    const SRC& source,
+    UNOPR& function,
+    unsigned int grain = 0,
+    ThreadPool& pool = ThreadPool::getDefault()) {
+    bassert(
+      destination.getDimension() == source.getDimension(),
+      ImageException("Images must have identical dimension")
+    );
+    grain = RowBands::getGrain(destination.getDimension(), grain, pool);
+    FillWithUnaryBands<DEST, SRC, UNOPR> task(destination, source, grain, function);
+    pool.execute(task, RowBands::getBands(destination.getHeight(), grain));
+  }
+
+  /** Parallel reduce task. Each band is accumulated into its own partial operation. */
+  template<class IMAGE, class UNOPR>
+  class ReduceBands : public ThreadPool::Task {
+  private:
+
+    typename IMAGE::ReadableRows rows;
+    const unsigned int height = 0;
+    const unsigned int grain = 0;
+    /** The partial operations (one per band). */
+    Allocator<UNOPR*> partials;
+
+    /** Releases the partial operations. */
+    void release() noexcept {
+      UNOPR** partial = partials.getElements();
+      for (MemorySize band = 0; band < partials.getSize(); ++band) {
+        delete partial[band];
+        partial[band] = nullptr;
+      }
+    }
+  public:
+
+    ReduceBands(const IMAGE& image, unsigned int _grain, unsigned int bands, const UNOPR& function)
+      : rows(image.getRows()), height(image.getHeight()), grain(_grain) {
+      partials.setSize(bands);
+      UNOPR** partial = partials.getElements();
+      fill<UNOPR*>(partial, bands, nullptr);
+      try {
+        for (unsigned int band = 0; band < bands; ++band) {
+          partial[band] = new UNOPR(function.clone());
+        }
+      } catch (...) {
+        release();
+        throw;
+      }
+    }
+
+    void execute(unsigned int band) {
+      UNOPR& function = *partials.getElements()[band];
+      const unsigned int begin = band * grain;
+      const unsigned int end = (height - begin > grain) ? (begin + grain) : height;
+      typename IMAGE::ReadableRows::RowIterator row = rows.getFirst();
+      row += begin;
+      for (unsigned int count = end - begin; count > 0; --count, ++row) {
+        typename IMAGE::ReadableRows::RowIterator::ElementIterator column = row.getFirst();
+        for (; column != row.getEnd(); ++column) {
+          function(*column);
+        }
+      }
+    }
+
+    /**
+      Merges the partial operations into the specified operation in band order.
+    */
+    void merge(UNOPR& function) {
+      const UNOPR* const* partial = partials.getElements();
+      for (MemorySize band = 0; band < partials.getSize(); ++band) {
+        function.merge(*partial[band]);
+      }
+    }
+
+    ~ReduceBands() noexcept {
+      release();
+    }
+  };
+
+  /**
+    Invokes the specified stateful unary operation for each element of the
+    specified image using several threads. Each band of rows is accumulated
+    into an empty operation obtained with clone() and the partial results are
+    merged into the operation with merge() in band order. Hence, the result
+    is deterministic for a given grain and identical to forEach() when the
+    merge is associative.
+
+    @param image The image.
+    @param function The operation providing clone() and merge().
+    @param grain The number of rows per band. 0 selects automatically.
+    @param pool The thread pool. The default pool if not specified.
+  */
+  template<class IMAGE, class UNOPR>
+  void reduce(
+    const IMAGE& image, UNOPR& function, unsigned int grain = 0, ThreadPool& pool = ThreadPool::getDefault()) {
+    grain = RowBands::getGrain(image.getDimension(), grain, pool);
+    const unsigned int bands = RowBands::getBands(image.getHeight(), grain);
+    ReduceBands<IMAGE, UNOPR> task(image, grain, bands, function);
+    pool.execute(task, bands);
+    task.merge(function);
+  }
 
 }; // end of gip namespace
@@ -18,6 +18,9 @@
 #include <gip/ImageException.h>
 #include <gip/Image.h>
 #include <gip/ArrayImage.h>
+#include <gip/ImageView.h>
+#include <gip/ImageBufferPool.h>
+#include <gip/CopyOnWriteMonitor.h>
 #include <gip/analysis/traverse.h>
 
 namespace gip {
@@ -160,6 +160,8 @@ _COM_AZURE_DEV__BASE__PACKED__END
   }
 
   ColorImage* BMPEncoder::read(const String& filename) {
+    static Metrics::Counter counter("BMPEncoder::read");
+    Metrics::Scope scope(counter);
     File file(filename, File::READ, 0);
 
     BMPHeader header;
@@ -458,12 +460,16 @@ _COM_AZURE_DEV__BASE__PACKED__END
         }
         break;
       }
+      scope.setProcessed(*image);
       return image;
     }
     return 0;
   }
 
   void BMPEncoder::write(const String& filename, const ColorImage* image) {
+    static Metrics::Counter counter("BMPEncoder::write");
+    Metrics::Scope scope(counter);
+    scope.setProcessed(*image);
     BMPHeader header;
 
     File file(filename, File::WRITE, File::CREATE);
@@ -498,6 +504,7 @@ _COM_AZURE_DEV__BASE__PACKED__END
     file.write(Cast::getAddress(header), sizeof(header));
 
     const ColorPixel* sourceElement = image->getElements();
+    const unsigned int padding = image->getPitch() - image->getDimension().getWidth();
     Allocator<uint8> buffer(16 * 1024);
     uint8* beginOfBuffer = buffer.getElements();
     uint8* endOfBuffer = beginOfBuffer + buffer.getSize();
@@ -522,6 +529,7 @@ _COM_AZURE_DEV__BASE__PACKED__END
           *p++ = pixel.red;
         }
       }
+      sourceElement += padding;
 
       if (((endOfBuffer - p)/3) == 0) {
         file.write(beginOfBuffer, p - beginOfBuffer); // empty buffer
@@ -543,6 +551,9 @@ _COM_AZURE_DEV__BASE__PACKED__END
   }
 
   void BMPEncoder::writeGray(const String& filename, const GrayImage* image) {
+    static Metrics::Counter counter("BMPEncoder::write");
+    Metrics::Scope scope(counter);
+    scope.setProcessed(*image);
     BMPHeader header;
 
     File file(filename, File::WRITE, File::CREATE);
@@ -593,6 +604,7 @@ _COM_AZURE_DEV__BASE__PACKED__END
     file.write(Cast::getAddress(palette), sizeof(palette)); // store palette
 
     const GrayPixel* sourceElement = image->getElements();
+    const unsigned int padding = image->getPitch() - image->getDimension().getWidth();
     uint8* beginOfBuffer = buffer.getElements();
     uint8* endOfBuffer = beginOfBuffer + buffer.getSize();
     uint8* p = beginOfBuffer;
@@ -614,6 +626,7 @@ _COM_AZURE_DEV__BASE__PACKED__END
           *p++ = *sourceElement;
         }
       }
+      sourceElement += padding;
 
       if (endOfBuffer - p == 0) {
         file.write(beginOfBuffer, p - beginOfBuffer); // empty buffer
@@ -277,6 +277,8 @@ _COM_AZURE_DEV__BASE__PACKED__END
   }
 
   ColorImage* GIFEncoder::read(const String& filename) {
+    static Metrics::Counter counter("GIFEncoder::read");
+    Metrics::Scope scope(counter);
 
     File file(filename, File::READ, 0);
 
@@ -338,6 +340,7 @@ _COM_AZURE_DEV__BASE__PACKED__END
     file.read(Cast::getAddress(trailer), sizeof(trailer)); // check trailer
     bassert(trailer == GIFImpl::TRAILER, InvalidFormat("Invalid GIF format", this));
 
+    scope.setProcessed(image);
     return new ColorImage(image);
   }
 
@@ -12,6 +12,7 @@
  ***************************************************************************/
 
 #include <gip/io/ImageEncoder.h>
+#include <utility>
 
 namespace gip {
 
@@ -20,5 +21,18 @@ namespace gip {
     extensions.append(getDefaultExtension());
     return extensions;
   }
+
+  ArrayImage<ColorPixel> ImageEncoder::readImage(const String& filename) {
+    ArrayImage<ColorPixel> result;
+    readImage(filename, result);
+    return result;
+  }
+
+  void ImageEncoder::readImage(const String& filename, ArrayImage<ColorPixel>& image) {
+    ArrayImage<ColorPixel>* decoded = read(filename);
+    bassert(decoded, InvalidFormat(this));
+    image = std::move(*decoded);
+    delete decoded;
+  }
   
 };
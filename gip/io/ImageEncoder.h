@@ -22,6 +22,7 @@
 #include <base/string/InvalidFormat.h>
 #include <gip/ArrayImage.h>
 #include <gip/ImageException.h>
+#include <gip/Metrics.h>
 
 namespace gip {
 
@@ -76,6 +77,24 @@ namespace gip {
       @param filename The path of the file.
     */
     virtual ArrayImage<ColorPixel>* read(const String& filename) = 0;
+
+    /**
+      Reads a color image from the specified file. Raises InvalidFormat if
+      the file could not be decoded.
+
+      @param filename The path of the file.
+    */
+    ArrayImage<ColorPixel> readImage(const String& filename);
+
+    /**
+      Reads a color image from the specified file into the specified image.
+      The image takes over the decoded elements (i.e. no elements are copied).
+      Raises InvalidFormat if the file could not be decoded.
+
+      @param filename The path of the file.
+      @param image The image to be filled.
+    */
+    void readImage(const String& filename, ArrayImage<ColorPixel>& image);
     
     /**
       Writes the specified image to the specified file.
@@ -180,6 +180,8 @@ MODULE_REGISTER_EXPLICIT(_COM_AZURE_DEV__GIP__THIS_MODULE, "net.sourceforge.libj
 
   ColorImage* JPEGEncoder::read(
     const String& filename) {
+    static Metrics::Counter counter("JPEGEncoder::read");
+    Metrics::Scope scope(counter);
 #if defined(_COM_AZURE_DEV__GIP__USE_JPEG)
     JPEGEncoderImpl::JPEGSource source;
     struct jpeg_decompress_struct cinfo;
@@ -241,6 +243,9 @@ MODULE_REGISTER_EXPLICIT(_COM_AZURE_DEV__GIP__THIS_MODULE, "net.sourceforge.libj
       ::jpeg_destroy_decompress(&cinfo);
     } catch(...) {
     }
+    if (image) {
+      scope.setProcessed(*image);
+    }
     return image;
 #else
     return nullptr;
@@ -250,6 +255,9 @@ MODULE_REGISTER_EXPLICIT(_COM_AZURE_DEV__GIP__THIS_MODULE, "net.sourceforge.libj
   void JPEGEncoder::write(
     const String& filename,
     const ColorImage* image) {
+    static Metrics::Counter counter("JPEGEncoder::write");
+    Metrics::Scope scope(counter);
+    scope.setProcessed(*image);
 #if defined(_COM_AZURE_DEV__GIP__USE_JPEG)
     struct JPEGEncoderImpl::JPEGDestination dest;
     struct jpeg_compress_struct cinfo;
@@ -290,6 +298,7 @@ MODULE_REGISTER_EXPLICIT(_COM_AZURE_DEV__GIP__THIS_MODULE, "net.sourceforge.libj
         JSAMPLE row[cinfo.image_width * cinfo.num_components];
         JSAMPROW prow = Cast::pointer<JSAMPROW>(row);
         const ColorPixel* src = image->getElements();
+        const unsigned int padding = image->getPitch() - cinfo.image_width;
         
         while (cinfo.next_scanline < cinfo.image_height) {
           // TAG: check top-bottom problem
@@ -301,6 +310,7 @@ MODULE_REGISTER_EXPLICIT(_COM_AZURE_DEV__GIP__THIS_MODULE, "net.sourceforge.libj
             *dest++ = src->blue;
             ++src;
           }
+          src += padding;
           ::jpeg_write_scanlines(&cinfo, &prow, 1);
         }
         ::jpeg_finish_compress(&cinfo);
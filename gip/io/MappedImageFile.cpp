@@ -0,0 +1,110 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#include <gip/io/MappedImageFile.h>
+#include <gip/Pixel.h>
+#include <base/string/InvalidFormat.h>
+#include <base/Primitives.h>
+
+namespace gip {
+
+  namespace {
+
+    /**
+      Reads the unsigned decimal field of a portable anymap header. Whitespace
+      and comments in front of the field are skipped.
+    */
+    unsigned int readField(const uint8*& src, const uint8* end) {
+      while (src < end) {
+        if (*src == '#') { // comment runs to end of line
+          while ((src < end) && (*src != '\n') && (*src != '\r')) {
+            ++src;
+          }
+        } else if ((*src == ' ') || (*src == '\t') || (*src == '\n') || (*src == '\r')) {
+          ++src;
+        } else {
+          break;
+        }
+      }
+      bassert((src < end) && (*src >= '0') && (*src <= '9'), InvalidFormat("Invalid header"));
+      uint64 value = 0;
+      while ((src < end) && (*src >= '0') && (*src <= '9')) {
+        value = value * 10 + (*src++ - '0');
+        bassert(value <= PrimitiveTraits<unsigned int>::MAXIMUM, InvalidFormat("Invalid header"));
+      }
+      return static_cast<unsigned int>(value);
+    }
+  }
+
+  RawImageLayout MappedImageFile::parseHeader(File& file) {
+    uint8 buffer[512]; // larger than any sensible header
+    const long long fileSize = file.getSize();
+    const unsigned int size = (fileSize < static_cast<long long>(sizeof(buffer))) ?
+      static_cast<unsigned int>(fileSize) : static_cast<unsigned int>(sizeof(buffer));
+    file.setPosition(0, File::BEGIN);
+    file.read(buffer, size);
+
+    const uint8* src = buffer;
+    const uint8* end = buffer + size;
+    bassert(
+      (size >= 2) && (src[0] == 'P') && (src[1] == '5'),
+      InvalidFormat("Unsupported file format")
+    );
+    src += 2;
+    const unsigned int width = readField(src, end);
+    const unsigned int height = readField(src, end);
+    const unsigned int maximumValue = readField(src, end);
+    bassert((maximumValue > 0) && (maximumValue <= 0xff), InvalidFormat("Unsupported sample size"));
+    bassert(src < end, InvalidFormat("Invalid header"));
+    ++src; // single whitespace before the pixel data
+    return RawImageLayout(src - buffer, Dimension(width, height), sizeof(Gray8Pixel));
+  }
+
+  const RawImageLayout& MappedImageFile::validate(File& file, const RawImageLayout& layout) {
+    const uint64 rowSize = static_cast<uint64>(layout.dimension.getWidth()) * layout.bytesPerPixel;
+    const uint64 dataSize = layout.getDataSize();
+    bassert(
+      (layout.bytesPerPixel > 0) && (dataSize > 0) &&
+      (layout.pitch >= rowSize) &&
+      (dataSize <= PrimitiveTraits<MemorySize>::MAXIMUM),
+      InvalidFormat("Invalid layout")
+    );
+    const uint64 fileSize = file.getSize();
+    bassert(
+      (layout.offset <= fileSize) && (dataSize <= fileSize - layout.offset),
+      InvalidFormat("Layout exceeds file")
+    );
+    return layout;
+  }
+
+  FileRegion MappedImageFile::getRegion(const RawImageLayout& layout) noexcept {
+    const uint64 granularity = MappedFile::getGranularity();
+    const uint64 offset = layout.offset/granularity * granularity;
+    return FileRegion(offset, static_cast<MemorySize>(layout.offset - offset + layout.getDataSize()));
+  }
+
+  MappedImageFile::MappedImageFile(const String& path, Access _access)
+    : RawImageData(_access),
+      file(path, File::READ, 0),
+      mapping(file, getRegion(setLayout(validate(file, parseHeader(file)))), false) {
+    bytes = mapping.getBytes() + (layout.offset - mapping.getRegion().getOffset());
+  }
+
+  MappedImageFile::MappedImageFile(const String& path, const RawImageLayout& _layout, Access _access)
+    : RawImageData(_access),
+      file(path, File::READ, 0),
+      mapping(file, getRegion(setLayout(validate(file, _layout))), false) {
+    bytes = mapping.getBytes() + (layout.offset - mapping.getRegion().getOffset());
+  }
+
+}; // end of gip namespace
@@ -0,0 +1,105 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#pragma once
+
+#include <gip/RawImageData.h>
+#include <base/io/File.h>
+#include <base/io/MappedFile.h>
+#include <base/io/FileRegion.h>
+#include <base/string/String.h>
+
+namespace gip {
+
+  /**
+    An image file mapped into memory. The pixel data is loaded by the
+    operating system on first access and may be shared by several processes
+    mapping the same file. The file is never modified.
+    The mapped file is used as the storage of an ArrayImage using the
+    ArrayImage(const Reference<RawImageData>&) constructor and the rows are
+    used in place in the order of the file. Portable graymaps store the top
+    row first so row 0 of the image is the top row (i.e. the image is upside
+    down). Use Flip on a COPY_ON_WRITE mapping for the usual orientation at
+    the cost of a private copy of the pixels.
+
+    The header is parsed for binary portable graymap (P5) files with 8-bit
+    samples. Portable pixmaps (P6) are not supported since their 3-byte
+    pixels do not match any pixel type (ColorPixel has 4 bytes). For
+    headerless raw dumps (and other layouts) the layout is specified
+    explicitly.
+
+    @code
+    Reference<MappedImageFile> file = new MappedImageFile(MESSAGE("frames.pgm"));
+    const Gray8Image image(file); // row 0 is the first row of the file
+    @endcode
+
+    @short Memory mapped image file.
+    @ingroup imageEncoders
+    @version 1.0
+  */
+
+  class _COM_AZURE_DEV__GIP__API MappedImageFile : public RawImageData {
+  private:
+
+    /** The file. */
+    File file;
+    /** The mapping of the pixel data. */
+    MappedFile mapping;
+
+    /**
+      Sets the layout of the pixel data and returns it.
+    */
+    inline const RawImageLayout& setLayout(const RawImageLayout& _layout) noexcept {
+      layout = _layout;
+      return layout;
+    }
+
+    /**
+      Raises InvalidFormat if the layout exceeds the file.
+    */
+    static const RawImageLayout& validate(File& file, const RawImageLayout& layout);
+
+    /**
+      Returns the region of the file to be mapped. The offset is rounded down
+      to the granularity of the mappings.
+    */
+    static FileRegion getRegion(const RawImageLayout& layout) noexcept;
+  public:
+
+    /**
+      Parses the header of a binary portable graymap (P5) file with 8-bit
+      samples. Raises InvalidFormat if the header is not valid.
+
+      @param file The file. The position of the file is modified.
+    */
+    static RawImageLayout parseHeader(File& file);
+
+    /**
+      Maps the pixel data of the specified portable graymap file.
+
+      @param path The path of the file.
+      @param access The behavior of modifying access. The default is READ_ONLY.
+    */
+    MappedImageFile(const String& path, Access access = READ_ONLY);
+
+    /**
+      Maps the pixel data of the specified file using an explicit layout.
+
+      @param path The path of the file.
+      @param layout The layout of the pixel data.
+      @param access The behavior of modifying access. The default is READ_ONLY.
+    */
+    MappedImageFile(const String& path, const RawImageLayout& layout, Access access = READ_ONLY);
+  };
+
+}; // end of gip namespace
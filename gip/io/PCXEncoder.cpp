@@ -75,6 +75,8 @@ _COM_AZURE_DEV__BASE__PACKED__END
   }
 
   ColorImage* PCXEncoder::read(const String& filename) {
+    static Metrics::Counter counter("PCXEncoder::read");
+    Metrics::Scope scope(counter);
 
     File file(filename, File::READ, 0);
 
@@ -227,10 +229,14 @@ _COM_AZURE_DEV__BASE__PACKED__END
       }
     }
 
+    scope.setProcessed(image);
     return new ColorImage(image);
   }
 
   void PCXEncoder::write(const String& filename, const ColorImage* image) {
+    static Metrics::Counter counter("PCXEncoder::write");
+    Metrics::Scope scope(counter);
+    scope.setProcessed(*image);
     PCXHeader header;
     File file(filename, File::WRITE, File::CREATE);
 
@@ -257,8 +263,9 @@ _COM_AZURE_DEV__BASE__PACKED__END
     Allocator<uint8> reordered(bytesPerLine * 3);
     Allocator<uint8> encoded(bytesPerLine * 3 * 2); // encoded data cannot exceed double size
     const ColorPixel* imageElement = image->getElements();
+    const unsigned int padding = image->getPitch() - width;
 
-    for (unsigned int row = 0; row < height; ++row) {
+    for (unsigned int row = 0; row < height; ++row, imageElement += padding) {
 
       uint8* red = reordered.getElements();
       uint8* green = red + bytesPerLine;
@@ -302,6 +309,9 @@ _COM_AZURE_DEV__BASE__PACKED__END
   }
 
   void PCXEncoder::writeGray(const String& filename, const GrayImage* image) {
+    static Metrics::Counter counter("PCXEncoder::write");
+    Metrics::Scope scope(counter);
+    scope.setProcessed(*image);
     PCXHeader header;
     File file(filename, File::WRITE, File::CREATE);
 
@@ -330,8 +340,9 @@ _COM_AZURE_DEV__BASE__PACKED__END
 
     Allocator<uint8> encoded(maximum(bytesPerLine * 2, 256U * 3 + 1));
     const GrayPixel* imageElement = image->getElements();
+    const unsigned int padding = image->getPitch() - width;
 
-    for (unsigned int row = 0; row < height; ++row) {
+    for (unsigned int row = 0; row < height; ++row, imageElement += padding) {
 
       switch (header.encoding) {
       case 0: // no encoding
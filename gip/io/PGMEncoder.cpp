@@ -51,6 +51,9 @@ namespace gip {
     if (!image) {
       _throw NullPointer(this);
     }
+    static Metrics::Counter counter("PGMEncoder::write");
+    Metrics::Scope scope(counter);
+    scope.setProcessed(*image);
     Dimension dimension = image->getDimension();
     
     FileOutputStream file(
@@ -64,12 +67,13 @@ namespace gip {
     out << setWidth(4);
     //FormatOutputStream::Context push(out);
 
+    const unsigned int pitch = image->getPitch();
     const GrayPixel* end = image->getElements();
-    const GrayPixel* src = end + dimension.getSize();
+    const GrayPixel* src = end + static_cast<MemorySize>(pitch) * dimension.getHeight();
     // unsigned int row = 0;
     while (src > end) {
-      const GrayPixel* endOfRow = src;
-      src -= dimension.getWidth();
+      src -= pitch;
+      const GrayPixel* endOfRow = src + dimension.getWidth();
       while (src < endOfRow) {
         int c = minimum<MemorySize>(endOfRow - src, 17); // do not exceed 70 chars per line
         while (c--) {
@@ -81,6 +85,37 @@ namespace gip {
     }
   }
   
+  void PGMEncoder::writeGray(
+    const String& filename,
+    const Gray8Image* image)
+  {
+    if (!image) {
+      _throw NullPointer(this);
+    }
+    static Metrics::Counter counter("PGMEncoder::write");
+    Metrics::Scope scope(counter);
+    scope.setProcessed(*image);
+    Dimension dimension = image->getDimension();
+    
+    FileOutputStream file(
+      filename, FileOutputStream::CREATE | FileOutputStream::TRUNCATE
+    );
+    FormatOutputStream out(file);
+    
+    out << MESSAGE("P5") << EOL
+        << dimension.getWidth() << ' ' << dimension.getHeight() << EOL
+        << 255 << EOL << FLUSH;
+
+    // rows are written directly from the image (one byte per pixel)
+    const unsigned int pitch = image->getPitch();
+    const Gray8Pixel* end = image->getElements();
+    const Gray8Pixel* src = end + static_cast<MemorySize>(pitch) * dimension.getHeight();
+    while (src > end) {
+      src -= pitch;
+      file.write(src, dimension.getWidth());
+    }
+  }
+  
   ArrayMap<String, AnyValue> PGMEncoder::getInformation(const String& filename)
   {
     return {
@@ -81,6 +81,8 @@ MODULE_REGISTER_EXPLICIT(_COM_AZURE_DEV__GIP__THIS_MODULE, "org.libpng", "libpng
 
   ColorImage* PNGEncoder::read(
     const String& filename) {
+    static Metrics::Counter counter("PNGEncoder::read");
+    Metrics::Scope scope(counter);
 #if defined(_COM_AZURE_DEV__GIP__USE_PNG)
     File file(filename, File::READ, 0);
 
@@ -149,12 +151,12 @@ MODULE_REGISTER_EXPLICIT(_COM_AZURE_DEV__GIP__THIS_MODULE, "org.libpng", "libpng
 
       unsigned int count = height;
       ColorPixel* rows[1024];
-      ColorPixel* src = image->getElements() + width * height;
+      ColorPixel* src = image->getElements() + image->getNumberOfPixels();
       while (count > 0) {
         unsigned int blockHeight = minimum(count, 1024U);
         count -= blockHeight;
         ColorPixel** row = rows;
-        ColorPixel* end = src - width * blockHeight;
+        ColorPixel* end = src - static_cast<MemorySize>(width) * blockHeight;
         while (src > end) {
           src -= width;
           *row++ = src;
@@ -165,6 +167,7 @@ MODULE_REGISTER_EXPLICIT(_COM_AZURE_DEV__GIP__THIS_MODULE, "org.libpng", "libpng
       
       ::png_read_end(context, 0);
       ::png_destroy_read_struct(&context, &information, &endInformation);
+      scope.setProcessed(*image);
       return image;
     } catch(...) {
       ::png_destroy_read_struct(&context, &information, &endInformation);
@@ -178,6 +181,9 @@ MODULE_REGISTER_EXPLICIT(_COM_AZURE_DEV__GIP__THIS_MODULE, "org.libpng", "libpng
   void PNGEncoder::write(
     const String& filename,
     const ColorImage* image) {
+    static Metrics::Counter counter("PNGEncoder::write");
+    Metrics::Scope scope(counter);
+    scope.setProcessed(*image);
 #if defined(_COM_AZURE_DEV__GIP__USE_PNG)
     unsigned int width = image->getDimension().getWidth();
     unsigned int height = image->getDimension().getHeight();
@@ -231,14 +237,15 @@ MODULE_REGISTER_EXPLICIT(_COM_AZURE_DEV__GIP__THIS_MODULE, "org.libpng", "libpng
       
       unsigned int count = height;
       const ColorPixel* rows[1024];
-      const ColorPixel* src = image->getElements() + width * height;
+      const unsigned int pitch = image->getPitch();
+      const ColorPixel* src = image->getElements() + static_cast<MemorySize>(pitch) * height;
       while (count > 0) {
         unsigned int blockHeight = minimum(count, 1024U);
         count -= blockHeight;
         const ColorPixel** row = rows;
-        const ColorPixel* end = src - width * blockHeight;
+        const ColorPixel* end = src - static_cast<MemorySize>(pitch) * blockHeight;
         while (src > end) {
-          src -= width;
+          src -= pitch;
           *row++ = src;
         }
         ::png_write_rows(context, (png_bytepp)rows, blockHeight); // TAG: fix for bad prototype in PNG API
@@ -46,6 +46,9 @@ namespace gip {
     if (!image) {
       _throw NullPointer(this);
     }
+    static Metrics::Counter counter("PPMEncoder::write");
+    Metrics::Scope scope(counter);
+    scope.setProcessed(*image);
     Dimension dimension = image->getDimension();
     
     FileOutputStream file(
@@ -58,12 +61,13 @@ namespace gip {
     out << setWidth(4);
     //FormatOutputStream::Context push(out);
 
+    const unsigned int pitch = image->getPitch();
     const ColorPixel* end = image->getElements();
-    const ColorPixel* src = end + dimension.getSize();
+    const ColorPixel* src = end + static_cast<MemorySize>(pitch) * dimension.getHeight();
     unsigned int row = 0;
     while (src > end) {
-      const ColorPixel* endOfRow = src;
-      src -= dimension.getWidth();
+      src -= pitch;
+      const ColorPixel* endOfRow = src + dimension.getWidth();
       while (src < endOfRow) {
         int c = minimum<MemorySize>(endOfRow - src, 5); // do not exceed 70 chars per line
         while (c--) {
@@ -119,6 +119,8 @@ namespace gip {
   
   ColorImage* RASEncoder::read(
     const String& filename) {
+    static Metrics::Counter counter("RASEncoder::read");
+    Metrics::Scope scope(counter);
     RASEncoderImpl::Header header;
 
     File file(filename, File::READ, 0);
@@ -279,7 +281,7 @@ namespace gip {
       {
         // TAG: if not color map then read blue, green, and red bytes
         bassert(header.length > 0, InvalidFormat(this));
-        unsigned int pixelsToWrite = dimension.getSize();
+        MemorySize pixelsToWrite = static_cast<MemorySize>(dimension.getWidth()) * dimension.getHeight();
         unsigned int bytesToRead = header.length;
         while (pixelsToWrite > 0) {
           FileReader::ReadIterator src = reader.peek(header.length); // entire image data
@@ -419,6 +421,7 @@ namespace gip {
       _throw InvalidFormat(this);
     }
 
+    scope.setProcessed(image);
     return new ColorImage(image);
   }
   
@@ -427,9 +430,12 @@ namespace gip {
     if (!image) {
       _throw NullPointer(this);
     }
+    static Metrics::Counter counter("RASEncoder::write");
+    Metrics::Scope scope(counter);
+    scope.setProcessed(*image);
     const Dimension dimension = image->getDimension();
     bassert(
-      dimension.getSize() * 3 <= static_cast<unsigned int>(PrimitiveTraits<int>::MAXIMUM),
+      image->getNumberOfPixels() * 3 <= static_cast<MemorySize>(PrimitiveTraits<int>::MAXIMUM),
       ImageException(this)
     ); // make sure length fits in header.length
 
@@ -486,9 +492,12 @@ namespace gip {
     if (!image) {
       _throw NullPointer(this);
     }
+    static Metrics::Counter counter("RASEncoder::write");
+    Metrics::Scope scope(counter);
+    scope.setProcessed(*image);
     Dimension dimension = image->getDimension();
     bassert(
-      dimension.getSize() <= static_cast<unsigned int>(PrimitiveTraits<int>::MAXIMUM),
+      image->getNumberOfPixels() <= static_cast<MemorySize>(PrimitiveTraits<int>::MAXIMUM),
       ImageException(this)
     ); // make sure length fits in header.length
 
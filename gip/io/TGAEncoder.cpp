@@ -126,6 +126,8 @@ _COM_AZURE_DEV__BASE__PACKED__END
   
   ColorImage* TGAEncoder::read(
     const String& filename) {    
+    static Metrics::Counter counter("TGAEncoder::read");
+    Metrics::Scope scope(counter);
     bool newFormat = false;
     TGAEncoderImpl::Header header;
     TGAEncoderImpl::Footer footer;    
@@ -179,6 +181,7 @@ _COM_AZURE_DEV__BASE__PACKED__END
       }
       reader.skip(dimension.getWidth() * 3);
     }
+    scope.setProcessed(*image);
     return image;
   }
   
@@ -189,6 +192,9 @@ _COM_AZURE_DEV__BASE__PACKED__END
     if (!image) {
       _throw NullPointer(this);
     }
+    static Metrics::Counter counter("TGAEncoder::write");
+    Metrics::Scope scope(counter);
+    scope.setProcessed(*image);
     Dimension dimension = image->getDimension();
     bassert(
       (dimension.getWidth() <= 0xffff) && (dimension.getHeight() <= 0xffff),
@@ -218,20 +224,24 @@ _COM_AZURE_DEV__BASE__PACKED__END
     File file(filename, File::WRITE, File::CREATE | File::EXCLUSIVE);
     file.write(Cast::getAddress(header), sizeof(header));
     
-    unsigned int count = dimension.getSize(); // max is 0xffff * 0xffff
+    const unsigned int padding = image->getPitch() - dimension.getWidth();
     const ColorPixel* src = image->getElements();
-    while (count > 0) {
-      unsigned int elementsToCopy = minimum(BUFFER_SIZE/3, count);
-      uint8* dest = buffer.getElements();
-      const ColorPixel* end = src + elementsToCopy;
-      while (src < end) {
-        *dest++ = src->blue;
-        *dest++ = src->green;
-        *dest++ = src->red;
-        ++src;
+    for (unsigned int row = 0; row < dimension.getHeight(); ++row) {
+      unsigned int count = dimension.getWidth();
+      while (count > 0) {
+        unsigned int elementsToCopy = minimum(BUFFER_SIZE/3, count);
+        uint8* dest = buffer.getElements();
+        const ColorPixel* end = src + elementsToCopy;
+        while (src < end) {
+          *dest++ = src->blue;
+          *dest++ = src->green;
+          *dest++ = src->red;
+          ++src;
+        }
+        file.write(buffer.getElements(), elementsToCopy * 3);
+        count -= elementsToCopy;
       }
-      file.write(buffer.getElements(), elementsToCopy * 3);
-      count -= elementsToCopy;
+      src += padding;
     }
     
     file.write(Cast::getAddress(footer), sizeof(footer));
@@ -248,6 +258,9 @@ _COM_AZURE_DEV__BASE__PACKED__END
     if (!image) {
       _throw NullPointer(this);
     }
+    static Metrics::Counter counter("TGAEncoder::write");
+    Metrics::Scope scope(counter);
+    scope.setProcessed(*image);
     Dimension dimension = image->getDimension();
     bassert(
       (dimension.getWidth() <= 0xffff) && (dimension.getHeight() <= 0xffff),
@@ -278,21 +291,25 @@ _COM_AZURE_DEV__BASE__PACKED__END
     File file(filename, File::WRITE, File::CREATE | File::EXCLUSIVE);
     file.write(Cast::getAddress(header), sizeof(header));
     
-    unsigned int count = dimension.getSize(); // max is 0xffff * 0xffff
+    const unsigned int padding = image->getPitch() - dimension.getWidth();
     const ColorAlphaPixel* src = image->getElements();
-    while (count > 0) {
-      unsigned int elementsToCopy = minimum(BUFFER_SIZE/4, count);
-      uint8* dest = buffer.getElements();
-      const ColorAlphaPixel* end = src + elementsToCopy;
-      while (src < end) {
-        *dest++ = src->blue;
-        *dest++ = src->green;
-        *dest++ = src->red;
-        *dest++ = src->alpha;
-        ++src;
+    for (unsigned int row = 0; row < dimension.getHeight(); ++row) {
+      unsigned int count = dimension.getWidth();
+      while (count > 0) {
+        unsigned int elementsToCopy = minimum(BUFFER_SIZE/4, count);
+        uint8* dest = buffer.getElements();
+        const ColorAlphaPixel* end = src + elementsToCopy;
+        while (src < end) {
+          *dest++ = src->blue;
+          *dest++ = src->green;
+          *dest++ = src->red;
+          *dest++ = src->alpha;
+          ++src;
+        }
+        file.write(buffer.getElements(), elementsToCopy * 4);
+        count -= elementsToCopy;
       }
-      file.write(buffer.getElements(), elementsToCopy * 4);
-      count -= elementsToCopy;
+      src += padding;
     }
 
     file.write(Cast::getAddress(footer), sizeof(footer));
@@ -309,6 +326,9 @@ _COM_AZURE_DEV__BASE__PACKED__END
     if (!image) {
       _throw NullPointer(this);
     }
+    static Metrics::Counter counter("TGAEncoder::write");
+    Metrics::Scope scope(counter);
+    scope.setProcessed(*image);
     Dimension dimension = image->getDimension();
     bassert(
       (dimension.getWidth() <= 0xffff) && (dimension.getHeight() <= 0xffff),
@@ -336,23 +356,79 @@ _COM_AZURE_DEV__BASE__PACKED__END
     
     File file(filename, File::WRITE, File::CREATE | File::EXCLUSIVE);
     
-    unsigned int count = dimension.getSize(); // max is 0xffff * 0xffff
+    const unsigned int padding = image->getPitch() - dimension.getWidth();
     const GrayPixel* src = image->getElements();
-    if (sizeof(GrayPixel) == 1) {
+    if ((sizeof(GrayPixel) == 1) && (padding == 0)) {
       file.write(Cast::getAddress(header), sizeof(header));
-      file.write(Cast::pointer<const uint8*>(src), count);
+      file.write(Cast::pointer<const uint8*>(src), dimension.getSize());
     } else {
       Allocator<uint8> buffer(BUFFER_SIZE);
       file.write(Cast::getAddress(header), sizeof(header));
-      while (count > 0) {
-        unsigned int bytesToCopy = minimum(BUFFER_SIZE, count);
-        uint8* dest = buffer.getElements();
-        const GrayPixel* end = src + bytesToCopy;
-        while (src < end) {
-          *dest++ = *src++;
+      for (unsigned int row = 0; row < dimension.getHeight(); ++row) {
+        unsigned int count = dimension.getWidth();
+        while (count > 0) {
+          unsigned int bytesToCopy = minimum(BUFFER_SIZE, count);
+          uint8* dest = buffer.getElements();
+          const GrayPixel* end = src + bytesToCopy;
+          while (src < end) {
+            *dest++ = *src++;
+          }
+          file.write(buffer.getElements(), bytesToCopy);
+          count -= bytesToCopy;
         }
-        file.write(buffer.getElements(), bytesToCopy);
-        count -= bytesToCopy;
+        src += padding;
+      }
+    }
+    
+    file.write(Cast::getAddress(footer), sizeof(footer));
+    file.truncate(sizeof(header) + dimension.getSize() * 1 + sizeof(footer));
+  }
+
+  void TGAEncoder::writeGray(
+    const String& filename,
+    const Gray8Image* image)
+  {
+    if (!image) {
+      _throw NullPointer(this);
+    }
+    static Metrics::Counter counter("TGAEncoder::write");
+    Metrics::Scope scope(counter);
+    scope.setProcessed(*image);
+    Dimension dimension = image->getDimension();
+    bassert(
+      (dimension.getWidth() <= 0xffff) && (dimension.getHeight() <= 0xffff),
+      ImageException(this)
+    );
+
+    TGAEncoderImpl::Header header;
+    clear(header);
+    header.type = TGAEncoderImpl::TYPE_UNCOMPRESSED_BLACK_WHITE;
+    header.image.width = dimension.getWidth();
+    header.image.height = dimension.getHeight();
+    header.image.pixelDepth = 8;
+    header.image.origin = 0; // bottom and left
+    
+    TGAEncoderImpl::Footer footer;
+    footer.extensionOffset = 0;
+    footer.directoryOffset = 0;
+    copy<char>(
+      footer.signature,
+      TGAEncoderImpl::signature.getValue(),
+      TGAEncoderImpl::signature.getLength()
+    );
+    footer.dot = '.';
+    footer.zero = '\0';
+    
+    File file(filename, File::WRITE, File::CREATE | File::EXCLUSIVE);
+    file.write(Cast::getAddress(header), sizeof(header));
+    
+    const Gray8Pixel* src = image->getElements();
+    if (image->isPacked()) {
+      file.write(src, dimension.getSize());
+    } else {
+      for (unsigned int row = 0; row < dimension.getHeight(); ++row) {
+        file.write(src, dimension.getWidth());
+        src += image->getPitch();
       }
     }
     
@@ -91,6 +91,15 @@ namespace gip {
       @param image The image to be written.
     */
     void writeGray(const String& filename, const GrayImage* image);
+
+    /**
+      Writes the specified image to the specified file. The rows are written
+      directly from the image.
+
+      @param filename The path of the file.
+      @param image The image to be written.
+    */
+    void writeGray(const String& filename, const Gray8Image* image);
     
     /**
       Returns information about the specified image.
@@ -149,7 +149,7 @@ namespace gip {
   };
   
   template<>
-  class Blend<RGBPixel<float> > : public BinaryOperation<RGBPixel<float>, RGBPixel<float>, RGBPixel<flaot> > {
+  class Blend<RGBPixel<float> > : public BinaryOperation<RGBPixel<float>, RGBPixel<float>, RGBPixel<float> > {
   private:
 
     typedef RGBPixel<float> Pixel;
@@ -24,15 +24,15 @@ namespace gip {
     @ingroup colormaps
     @version 1.0
   */
-  class BlueColorMap : public UnaryOperation<RGBPixel<double>, double> {
+  class BlueColorMap : public UnaryOperation<double, RGBPixel<double> > {
   public:
 
-    inline void RGBPixel<double> operator()(const double value) const noexcept
+    inline RGBPixel<double> operator()(const double value) const noexcept
     {
       RGBPixel<double> result;
       result.red = 0;
       result.green = 0;
-      result.blue = clamp(0, value, 1);
+      result.blue = clamp(0.0, value, 1.0);
       return result;
     }
   };
@@ -24,7 +24,7 @@ namespace gip {
     @ingroup colormaps
     @version 1.0
   */
-  class ColdHotColorMap : public UnaryOperation<RGBPixel<double>, double> {
+  class ColdHotColorMap : public UnaryOperation<double, RGBPixel<double> > {
   public:
 
     inline RGBPixel<double> operator()(const double value) const noexcept {
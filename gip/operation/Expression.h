@@ -0,0 +1,438 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#pragma once
+
+#include <gip/ImageException.h>
+#include <gip/analysis/traverse.h>
+#include <type_traits>
+#include <utility>
+
+namespace gip {
+
+  /**
+    Base of lazily evaluated pixel expressions. An expression describes how
+    each pixel is computed from one or more images but nothing is computed
+    until the expression is assigned to a destination image with assign()
+    or parallelAssign(). The assignment evaluates the complete expression
+    for one row at a time without intermediate images.
+
+    An expression provides the Pixel type, getDimension(), and a Row type
+    obtained with getRow() which provides an Element type with operator*()
+    and operator++().
+
+    <pre>
+    assign(destination, combine(apply(source, HeatColorMap()), background, blend));
+    </pre>
+
+    The images of an expression must outlive the expression.
+
+    @short Pixel expression.
+    @ingroup operator
+    @see apply combine assign
+    @version 1.0
+  */
+  class PixelExpression {
+  };
+
+  /**
+    Expression reading the pixels of an image.
+
+    @short Image pixel expression.
+    @version 1.0
+  */
+  template<class IMAGE>
+  class ImageExpression : public PixelExpression {
+  public:
+
+    typedef typename IMAGE::Pixel Pixel;
+  private:
+
+    typedef typename IMAGE::ReadableRows Rows;
+
+    /** The rows of the image. */
+    Rows rows;
+    /** The dimension of the image. */
+    Dimension dimension;
+  public:
+
+    class Element {
+    private:
+
+      typename Rows::RowIterator::ElementIterator column;
+    public:
+
+      inline Element(const typename Rows::RowIterator::ElementIterator& _column) noexcept
+        : column(_column) {
+      }
+
+      inline Pixel operator*() const noexcept {
+        return *column;
+      }
+
+      inline void operator++() noexcept {
+        ++column;
+      }
+    };
+
+    class Row {
+    private:
+
+      typename Rows::RowIterator row;
+    public:
+
+      inline Row(const typename Rows::RowIterator& _row) noexcept
+        : row(_row) {
+      }
+
+      inline Element getFirst() const noexcept {
+        return Element(row.getFirst());
+      }
+
+      inline void operator++() noexcept {
+        ++row;
+      }
+    };
+
+    inline ImageExpression(const IMAGE& image) noexcept
+      : rows(image.getRows()), dimension(image.getDimension()) {
+    }
+
+    inline const Dimension& getDimension() const noexcept {
+      return dimension;
+    }
+
+    /**
+      Returns the specified row.
+    */
+    inline Row getRow(unsigned int index) const noexcept {
+      typename Rows::RowIterator row = rows.getFirst();
+      row += index;
+      return Row(row);
+    }
+  };
+
+  /**
+    Maps an image or expression to an expression.
+  */
+  template<class TYPE, bool IS_EXPRESSION = std::is_base_of<PixelExpression, TYPE>::value>
+  class ExpressionOf {
+  public:
+
+    typedef TYPE Expression;
+
+    static inline const Expression& make(const TYPE& value) noexcept {
+      return value;
+    }
+  };
+
+  template<class IMAGE>
+  class ExpressionOf<IMAGE, false> {
+  public:
+
+    typedef ImageExpression<IMAGE> Expression;
+
+    static inline Expression make(const IMAGE& image) noexcept {
+      return Expression(image);
+    }
+  };
+
+  /**
+    Expression applying a unary operation (e.g. Slice or a color map) to the
+    pixels of an expression.
+
+    @short Unary pixel expression.
+    @version 1.0
+  */
+  template<class EXPRESSION, class UNOPR>
+  class UnaryExpression : public PixelExpression {
+  public:
+
+    typedef typename std::decay<
+      decltype(std::declval<const UNOPR&>()(std::declval<typename EXPRESSION::Pixel>()))
+    >::type Pixel;
+  private:
+
+    /** The operand. */
+    EXPRESSION operand;
+    /** The operation. */
+    UNOPR function;
+  public:
+
+    class Element {
+    private:
+
+      typename EXPRESSION::Element element;
+      const UNOPR* function = nullptr;
+    public:
+
+      inline Element(const typename EXPRESSION::Element& _element, const UNOPR* _function) noexcept
+        : element(_element), function(_function) {
+      }
+
+      inline Pixel operator*() const noexcept {
+        return (*function)(*element);
+      }
+
+      inline void operator++() noexcept {
+        ++element;
+      }
+    };
+
+    class Row {
+    private:
+
+      typename EXPRESSION::Row row;
+      const UNOPR* function = nullptr;
+    public:
+
+      inline Row(const typename EXPRESSION::Row& _row, const UNOPR* _function) noexcept
+        : row(_row), function(_function) {
+      }
+
+      inline Element getFirst() const noexcept {
+        return Element(row.getFirst(), function);
+      }
+
+      inline void operator++() noexcept {
+        ++row;
+      }
+    };
+
+    inline UnaryExpression(const EXPRESSION& _operand, const UNOPR& _function)
+      : operand(_operand), function(_function) {
+    }
+
+    inline const Dimension& getDimension() const noexcept {
+      return operand.getDimension();
+    }
+
+    inline Row getRow(unsigned int index) const noexcept {
+      return Row(operand.getRow(index), &function);
+    }
+  };
+
+  /**
+    Expression applying a binary operation (e.g. Blend) to the pixels of two
+    expressions of identical dimension.
+
+    @short Binary pixel expression.
+    @version 1.0
+  */
+  template<class LEFT, class RIGHT, class BINOPR>
+  class BinaryExpression : public PixelExpression {
+  public:
+
+    typedef typename std::decay<
+      decltype(
+        std::declval<const BINOPR&>()(
+          std::declval<typename LEFT::Pixel>(), std::declval<typename RIGHT::Pixel>()
+        )
+      )
+    >::type Pixel;
+  private:
+
+    /** The left operand. */
+    LEFT left;
+    /** The right operand. */
+    RIGHT right;
+    /** The operation. */
+    BINOPR function;
+  public:
+
+    class Element {
+    private:
+
+      typename LEFT::Element left;
+      typename RIGHT::Element right;
+      const BINOPR* function = nullptr;
+    public:
+
+      inline Element(
+        const typename LEFT::Element& _left,
+        const typename RIGHT::Element& _right,
+        const BINOPR* _function) noexcept
+        : left(_left), right(_right), function(_function) {
+      }
+
+      inline Pixel operator*() const noexcept {
+        return (*function)(*left, *right);
+      }
+
+      inline void operator++() noexcept {
+        ++left;
+        ++right;
+      }
+    };
+
+    class Row {
+    private:
+
+      typename LEFT::Row left;
+      typename RIGHT::Row right;
+      const BINOPR* function = nullptr;
+    public:
+
+      inline Row(const typename LEFT::Row& _left, const typename RIGHT::Row& _right, const BINOPR* _function) noexcept
+        : left(_left), right(_right), function(_function) {
+      }
+
+      inline Element getFirst() const noexcept {
+        return Element(left.getFirst(), right.getFirst(), function);
+      }
+
+      inline void operator++() noexcept {
+        ++left;
+        ++right;
+      }
+    };
+
+    BinaryExpression(const LEFT& _left, const RIGHT& _right, const BINOPR& _function)
+      : left(_left), right(_right), function(_function) {
+      bassert(
+        left.getDimension() == right.getDimension(),
+        ImageException("Images must have identical dimension")
+      );
+    }
+
+    inline const Dimension& getDimension() const noexcept {
+      return left.getDimension();
+    }
+
+    inline Row getRow(unsigned int index) const noexcept {
+      return Row(left.getRow(index), right.getRow(index), &function);
+    }
+  };
+
+  /**
+    Returns an expression reading the pixels of the specified image.
+  */
+  template<class IMAGE>
+  inline ImageExpression<IMAGE> pixels(const IMAGE& image) noexcept {
+    return ImageExpression<IMAGE>(image);
+  }
+
+  /**
+    Returns an expression applying the specified unary operation to an image
+    or expression. The operation is copied and must not modify its state.
+  */
+  template<class OPERAND, class UNOPR>
+  inline UnaryExpression<typename ExpressionOf<OPERAND>::Expression, UNOPR> apply(
+    const OPERAND& operand, const UNOPR& function) {
+    return UnaryExpression<typename ExpressionOf<OPERAND>::Expression, UNOPR>(
+      ExpressionOf<OPERAND>::make(operand), function
+    );
+  }
+
+  /**
+    Returns an expression applying the specified binary operation to two
+    images or expressions. The operation is copied and must not modify its
+    state.
+  */
+  template<class LEFT, class RIGHT, class BINOPR>
+  inline BinaryExpression<
+    typename ExpressionOf<LEFT>::Expression, typename ExpressionOf<RIGHT>::Expression, BINOPR
+  > combine(const LEFT& left, const RIGHT& right, const BINOPR& function) {
+    return BinaryExpression<
+      typename ExpressionOf<LEFT>::Expression, typename ExpressionOf<RIGHT>::Expression, BINOPR
+    >(ExpressionOf<LEFT>::make(left), ExpressionOf<RIGHT>::make(right), function);
+  }
+
+  /**
+    Evaluates the specified rows of an expression into the destination rows.
+  */
+  template<class DEST, class EXPRESSION>
+  inline void evaluate(
+    typename DEST::Rows::RowIterator row, const EXPRESSION& expression, unsigned int begin, unsigned int count) noexcept {
+    typename EXPRESSION::Row srcRow = expression.getRow(begin);
+    for (; count > 0; --count, ++row, ++srcRow) {
+      typename DEST::Rows::RowIterator::ElementIterator column = row.getFirst();
+      const typename DEST::Rows::RowIterator::ElementIterator end = row.getEnd();
+      typename EXPRESSION::Element element = srcRow.getFirst();
+      for (; column != end; ++column, ++element) {
+        *column = *element;
+      }
+    }
+  }
+
+  /**
+    Evaluates the specified expression into the destination image in a single
+    pass. The destination may also be an operand of the expression if the
+    pixels are only read at the position being written.
+
+    @param destination The destination image.
+    @param expression The expression.
+  */
+  template<class DEST, class EXPRESSION>
+  void assign(DEST& destination, const EXPRESSION& expression) {
+    const typename ExpressionOf<EXPRESSION>::Expression& e = ExpressionOf<EXPRESSION>::make(expression);
+    bassert(
+      destination.getDimension() == e.getDimension(),
+      ImageException("Images must have identical dimension")
+    );
+    typename DEST::Rows rows = destination.getRows();
+    evaluate<DEST>(rows.getFirst(), e, 0, destination.getHeight());
+  }
+
+  /** Parallel expression evaluation task. */
+  template<class DEST, class EXPRESSION>
+  class AssignBands : public ThreadPool::Task {
+  private:
+
+    typename DEST::Rows rows;
+    const EXPRESSION& expression;
+    const unsigned int height = 0;
+    const unsigned int grain = 0;
+  public:
+
+    AssignBands(DEST& destination, const EXPRESSION& _expression, unsigned int _grain)
+      : rows(destination.getRows()), expression(_expression), height(destination.getHeight()), grain(_grain) {
+    }
+
+    void execute(unsigned int band) {
+      const unsigned int begin = band * grain;
+      const unsigned int end = (height - begin > grain) ? (begin + grain) : height;
+      typename DEST::Rows::RowIterator row = rows.getFirst();
+      row += begin;
+      evaluate<DEST>(row, expression, begin, end - begin);
+    }
+  };
+
+  /**
+    Evaluates the specified expression into the destination image using
+    several threads. The operations of the expression are invoked
+    concurrently.
+
+    @param destination The destination image.
+    @param expression The expression.
+    @param grain The number of rows per band. 0 selects automatically.
+    @param pool The thread pool. The default pool if not specified.
+  */
+  template<class DEST, class EXPRESSION>
+  void parallelAssign(
+    DEST& destination,
+    const EXPRESSION& expression,
+    unsigned int grain = 0,
+    ThreadPool& pool = ThreadPool::getDefault()) {
+    typedef typename ExpressionOf<EXPRESSION>::Expression Expression;
+    const Expression& e = ExpressionOf<EXPRESSION>::make(expression);
+    bassert(
+      destination.getDimension() == e.getDimension(),
+      ImageException("Images must have identical dimension")
+    );
+    grain = RowBands::getGrain(destination.getDimension(), grain, pool);
+    AssignBands<DEST, Expression> task(destination, e, grain); // copy-on-write happens here
+    pool.execute(task, RowBands::getBands(destination.getHeight(), grain));
+  }
+
+}; // end of gip namespace
@@ -24,14 +24,14 @@ namespace gip {
     @ingroup colormaps
     @version 1.0
   */
-  class GreenColorMap : public UnaryOperation<RGBPixel<double>, double> {
+  class GreenColorMap : public UnaryOperation<double, RGBPixel<double> > {
   public:
 
-    inline void RGBPixel<double> operator()(const double value) const noexcept
+    inline RGBPixel<double> operator()(const double value) const noexcept
     {
       RGBPixel<double> result;
       result.red = 0;
-      result.green = clamp(0, value, 1);
+      result.green = clamp(0.0, value, 1.0);
       result.blue = 0;
       return result;
     }
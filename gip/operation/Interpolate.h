@@ -33,10 +33,11 @@ namespace gip {
     typedef PIXEL Pixel;
     const Pixel* elements = nullptr;
     Dimension dimension;
+    unsigned int pitch = 0;
   public:
     
     inline Interpolate(const ArrayImage<Pixel>& image) noexcept
-      : elements(image.getElements()), dimension(image.getDimension()) {
+      : elements(image.getElements()), dimension(image.getDimension()), pitch(image.getPitch()) {
     }
     
     inline double operator()(double x, double y) const noexcept {
@@ -48,7 +49,7 @@ namespace gip {
       
       double result = 0; // 0 is background
 
-      const Pixel* p = elements + y0 * dimension.getWidth() + x0;
+      const Pixel* p = elements + static_cast<MemoryDiff>(y0) * pitch + x0;
       
       if ((x0 >= 0) && (x0 < dimension.getWidth())) {
         if ((y0 >= 0) && (y0 < dimension.getHeight())) {
@@ -57,7 +58,7 @@ namespace gip {
         }
         if (((y0 + 1) >= 0) && ((y0 + 1) < dimension.getHeight())) {
           const double w2 = (1 - xFraction) * yFraction;
-          result += w2 * p[dimension.getWidth()];
+          result += w2 * p[pitch];
         }
       }
       
@@ -70,7 +71,7 @@ namespace gip {
         }
         if (((y0 + 1) >= 0) && ((y0 + 1) < dimension.getHeight())) {
           const double w3 = xFraction * yFraction;
-          result += w3 * p[dimension.getWidth()];
+          result += w3 * p[pitch];
         }
       }
       
@@ -85,10 +86,11 @@ namespace gip {
     typedef GrayPixel Pixel;
     const Pixel* elements = nullptr;
     Dimension dimension;
+    unsigned int pitch = 0;
   public:
     
     inline Interpolate(const ArrayImage<Pixel>& image) noexcept
-      : elements(image.getElements()), dimension(image.getDimension()) {
+      : elements(image.getElements()), dimension(image.getDimension()), pitch(image.getPitch()) {
     }
     
     inline double operator()(double x, double y) const noexcept {
@@ -100,7 +102,7 @@ namespace gip {
       
       double result = 0; // 0 is background
 
-      const Pixel* p = elements + y0 * dimension.getWidth() + x0;
+      const Pixel* p = elements + static_cast<MemoryDiff>(y0) * pitch + x0;
       
       if ((x0 >= 0) && (static_cast<unsigned int>(x0) < dimension.getWidth())) {
         if ((y0 >= 0) && (static_cast<unsigned int>(y0) < dimension.getHeight())) {
@@ -109,7 +111,7 @@ namespace gip {
         }
         if (((y0 + 1) >= 0) && (static_cast<unsigned int>(y0 + 1) < dimension.getHeight())) {
           const double w2 = (1 - xFraction) * yFraction;
-          result += w2 * p[dimension.getWidth()];
+          result += w2 * p[pitch];
         }
       }
       
@@ -122,7 +124,7 @@ namespace gip {
         }
         if (((y0 + 1) >= 0) && (static_cast<unsigned int>(y0 + 1) < dimension.getHeight())) {
           const double w3 = xFraction * yFraction;
-          result += w3 * p[dimension.getWidth()];
+          result += w3 * p[pitch];
         }
       }
       
@@ -137,10 +139,11 @@ namespace gip {
     typedef RGBPixel<COMPONENT> Pixel;
     const Pixel* elements = nullptr;
     Dimension dimension;
+    unsigned int pitch = 0;
   public:
     
     inline Interpolate(const ArrayImage<Pixel>& image) noexcept
-      : elements(image.getElements()), dimension(image.getDimension()) {
+      : elements(image.getElements()), dimension(image.getDimension()), pitch(image.getPitch()) {
     }
     
     inline RGBPixel<COMPONENT> operator()(double x, double y) const noexcept {
@@ -154,7 +157,7 @@ namespace gip {
       double green = 0;
       double blue = 0;
       
-      const Pixel* p = elements + y0 * dimension.getWidth() + x0;
+      const Pixel* p = elements + static_cast<MemoryDiff>(y0) * pitch + x0;
       
       if ((x0 >= 0) && (static_cast<unsigned int>(x0) < dimension.getWidth())) {
         if ((y0 >= 0) && (static_cast<unsigned int>(y0) < dimension.getHeight())) {
@@ -165,9 +168,9 @@ namespace gip {
         }
         if (((y0 + 1) >= 0) && (static_cast<unsigned int>(y0 + 1) < dimension.getHeight())) {
           const double w2 = (1 - xFraction) * yFraction;
-          red += w2 * p[dimension.getWidth()].red;
-          green += w2 * p[dimension.getWidth()].green;
-          blue += w2 * p[dimension.getWidth()].blue;
+          red += w2 * p[pitch].red;
+          green += w2 * p[pitch].green;
+          blue += w2 * p[pitch].blue;
         }
       }
       
@@ -182,9 +185,9 @@ namespace gip {
         }
         if (((y0 + 1) >= 0) && (static_cast<unsigned int>(y0 + 1) < dimension.getHeight())) {
           const double w3 = xFraction * yFraction;
-          red += w3 * p[dimension.getWidth()].red;
-          green += w3 * p[dimension.getWidth()].green;
-          blue += w3 * p[dimension.getWidth()].blue;
+          red += w3 * p[pitch].red;
+          green += w3 * p[pitch].green;
+          blue += w3 * p[pitch].blue;
         }
       }
 
@@ -24,13 +24,13 @@ namespace gip {
     @ingroup colormaps
     @version 1.0
   */
-  class RedColorMap : public UnaryOperation<RGBPixel<double>, double> {
+  class RedColorMap : public UnaryOperation<double, RGBPixel<double> > {
   public:
 
-    inline void RGBPixel<double> operator()(const double& value) const noexcept
+    inline RGBPixel<double> operator()(const double& value) const noexcept
     {
       RGBPixel<double> result;
-      result.red = clamp(0, value, 1);
+      result.red = clamp(0.0, value, 1.0);
       result.green = 0;
       result.blue = 0;
       return result;
@@ -0,0 +1,258 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#pragma once
+
+#include <gip/transformation/Transformation.h>
+#include <gip/transformation/Convolution.h>
+#include <gip/analysis/IntegralImage.h>
+#include <gip/ArrayImage.h>
+#include <gip/ImageException.h>
+#include <gip/Border.h>
+#include <base/collection/Array.h>
+#include <base/mem/Allocator.h>
+
+namespace gip {
+
+  /**
+    Mean filter with a square window of any radius. The sums are read from
+    an IntegralImage of the source image so the cost per pixel does not
+    depend on the radius. The pixels outside the image are given by the
+    border mode like for the other neighborhood operations (the window
+    always has (2 * radius + 1)^2 pixels). A window crossing an edge is
+    summed as a few boxes of the image (e.g. the replicated edge column
+    counted several times). The radii 1 and 2 give the same result as
+    ConvolutionNxN with SmoothUniformRectangular3x3 and
+    SmoothUniformRectangular5x5. Integer means are rounded to the nearest
+    integer like the convolution.
+
+    @code
+    BoxFilter<Gray8Image> transform(&smoothed, &image, 7, Border::REFLECT);
+    transform();
+    @endcode
+
+    @short Box filter of any radius.
+    @ingroup transformations filtering
+    @see IntegralImage Border
+    @version 1.0
+  */
+
+  template<class DEST, class SRC = DEST>
+  class BoxFilter : public Transformation<DEST, SRC> {
+  public:
+
+    typedef typename Transformation<DEST, SRC>::DestinationImage DestinationImage;
+    typedef typename Transformation<DEST, SRC>::SourceImage SourceImage;
+    typedef typename DestinationImage::Pixel DestinationPixel;
+    typedef typename SourceImage::Pixel SourcePixel;
+    typedef typename IntegralImage<SourceImage>::Sum Sum;
+  private:
+
+    /** A range of rows or columns of the source image and the number of times a window uses it. */
+    class Span {
+    public:
+
+      unsigned int begin = 0;
+      unsigned int end = 0;
+      unsigned int weight = 0;
+
+      inline Span() noexcept {
+      }
+
+      inline Span(int _begin, int _end, int _weight) noexcept
+        : begin(_begin), end(_end), weight(_weight) {
+      }
+    };
+
+    /** The radius of the window. */
+    unsigned int radius = 0;
+    /** The border mode. */
+    Border::Mode border = Border::REPLICATE;
+    /** The value of the pixels outside the source image for Border::CONSTANT. */
+    SourcePixel constant;
+
+    /**
+      Appends the spans of the image covering the rows or columns
+      [first; end) which may exceed [0; size). The rows or columns outside
+      the image are omitted for CONSTANT.
+    */
+    static void addSpans(Array<Span>& spans, int first, int end, int size, Border::Mode mode) {
+      if (mode == Border::CONSTANT) {
+        first = maximum(first, 0);
+        end = minimum(end, size);
+        if (first < end) {
+          spans.append(Span(first, end, 1));
+        }
+        return;
+      }
+      if ((mode == Border::REPLICATE) || (mode == Border::NONE)) {
+        if (first < 0) {
+          spans.append(Span(0, 1, minimum(end, 0) - first));
+        }
+        if (maximum(first, 0) < minimum(end, size)) {
+          spans.append(Span(maximum(first, 0), minimum(end, size), 1));
+        }
+        if (end > size) {
+          spans.append(Span(size - 1, size, end - maximum(first, size)));
+        }
+        return;
+      }
+      if (size == 1) {
+        spans.append(Span(0, 1, end - first));
+        return;
+      }
+      const int period = 2 * (size - 1);
+      for (int i = first; i < end;) {
+        int length = 0;
+        if (mode == Border::WRAP) {
+          const int index = Border::map(i, size, mode);
+          length = minimum(end - i, size - index);
+          spans.append(Span(index, index + length, 1));
+        } else { // REFLECT
+          int phase = i % period;
+          if (phase < 0) {
+            phase += period;
+          }
+          if (phase < size) { // ascending
+            length = minimum(end - i, size - phase);
+            spans.append(Span(phase, phase + length, 1));
+          } else { // descending from period - phase
+            length = minimum(end - i, period - phase);
+            spans.append(Span(period - phase - length + 1, period - phase + 1, 1));
+          }
+        }
+        i += length;
+      }
+    }
+
+    /**
+      Returns the quotient of the sum and the area rounded to the nearest
+      integer (halfway cases away from zero) from the reciprocal of twice
+      the area. The estimate is off by at most one and is corrected with
+      the remainder.
+    */
+    static inline long long divide(long long sum, long long area, double reciprocal) noexcept {
+      const long long magnitude = 2 * ((sum < 0) ? -sum : sum) + area;
+      const long long divisor = 2 * area;
+      long long quotient = static_cast<long long>(magnitude * reciprocal);
+      const long long remainder = magnitude - quotient * divisor;
+      if (remainder >= divisor) {
+        ++quotient;
+      } else if (remainder < 0) {
+        --quotient;
+      }
+      return (sum < 0) ? -quotient : quotient;
+    }
+
+    static inline float divide(double sum, double, double reciprocal) noexcept {
+      return static_cast<float>(2 * sum * reciprocal);
+    }
+  public:
+
+    /**
+      Initializes the transformation.
+
+      @param destination The destination image.
+      @param source The source image.
+      @param radius The radius of the window (the window has 2 * radius + 1 rows and columns).
+      @param border The border mode. The default is Border::REPLICATE.
+      @param constant The value of the pixels outside the source image for Border::CONSTANT.
+    */
+    BoxFilter(
+      DestinationImage* destination,
+      const SourceImage* source,
+      unsigned int _radius,
+      Border::Mode _border = Border::REPLICATE,
+      const SourcePixel& _constant = SourcePixel())
+      : Transformation<DEST, SRC>(destination, source),
+        radius(_radius),
+        border(_border),
+        constant(_constant) {
+      bassert(
+        destination->getDimension() == source->getDimension(),
+        ImageException("Images must have the same dimension", this)
+      );
+    }
+
+    /**
+      Filters the image. For Border::NONE the pixels closer to the edges
+      than the radius are not modified.
+    */
+    void operator()() const {
+      static Metrics::Counter counter("BoxFilter");
+      Metrics::Scope scope(counter, *Transformation<DEST, SRC>::destination, *Transformation<DEST, SRC>::source);
+
+      const Dimension dimension = Transformation<DEST, SRC>::source->getDimension();
+      if (!dimension.isProper()) {
+        return;
+      }
+      const Region calculate = Border::getRegion(Region(Point2D(0, 0), dimension), dimension, radius, border);
+      if (!calculate.isProper()) {
+        return;
+      }
+      const int width = dimension.getWidth();
+      const int height = dimension.getHeight();
+      const int size = 2 * radius + 1;
+      const Sum area = static_cast<Sum>(size) * size;
+      const double reciprocal = 1.0/(2 * area);
+      const IntegralImage<SourceImage> table(*Transformation<DEST, SRC>::source);
+      Sum outside[IntegralImage<SourceImage>::CHANNELS];
+      for (unsigned int channel = 0; channel < IntegralImage<SourceImage>::CHANNELS; ++channel) {
+        outside[channel] = IntegralImageTraits<SourcePixel>::get(constant, channel);
+      }
+
+      // the spans of the windows of the columns and rows (one span within the image)
+      const unsigned int firstColumn = calculate.getOffset().getColumn();
+      const unsigned int columns = calculate.getDimension().getWidth();
+      Array<Span> columnSpans;
+      Allocator<MemorySize> columnIndex(columns + 1);
+      for (unsigned int x = 0; x < columns; ++x) {
+        columnIndex.getElements()[x] = columnSpans.getSize();
+        const int column = firstColumn + x;
+        addSpans(columnSpans, column - static_cast<int>(radius), column + radius + 1, width, border);
+      }
+      columnIndex.getElements()[columns] = columnSpans.getSize();
+      const Span* columnSpan = columnSpans.getElements();
+      const MemorySize* columnFirst = columnIndex.getElements();
+
+      typename DestinationImage::Rows::RowIterator row = Transformation<DEST, SRC>::destination->getRows().getFirst();
+      row += calculate.getOffset().getRow();
+      for (unsigned int y = calculate.getOffset().getRow(); y < calculate.getEndRow(); ++y, ++row) {
+        Array<Span> rowSpans;
+        addSpans(rowSpans, static_cast<int>(y) - static_cast<int>(radius), y + radius + 1, height, border);
+        const Span* rowSpan = rowSpans.getElements();
+        const MemorySize numberOfRowSpans = rowSpans.getSize();
+        typename DestinationImage::Rows::RowIterator::ElementIterator dest = row.getFirst() + firstColumn;
+        for (unsigned int x = 0; x < columns; ++x, ++dest) {
+          for (unsigned int channel = 0; channel < IntegralImage<SourceImage>::CHANNELS; ++channel) {
+            Sum sum = 0;
+            Sum inside = 0;
+            for (MemorySize i = 0; i < numberOfRowSpans; ++i) {
+              for (MemorySize j = columnFirst[x]; j < columnFirst[x + 1]; ++j) {
+                const Sum weight = static_cast<Sum>(rowSpan[i].weight) * columnSpan[j].weight;
+                sum += weight * table.getSum(
+                  rowSpan[i].begin, columnSpan[j].begin, rowSpan[i].end, columnSpan[j].end, channel
+                );
+                inside += weight * static_cast<Sum>(rowSpan[i].end - rowSpan[i].begin) *
+                  (columnSpan[j].end - columnSpan[j].begin);
+              }
+            }
+            sum += (area - inside) * outside[channel]; // pixels outside the image for CONSTANT only
+            ConvolutionPixel<DestinationPixel>::set(*dest, channel, divide(sum, area, reciprocal));
+          }
+        }
+      }
+    }
+  };
+
+}; // end of gip namespace
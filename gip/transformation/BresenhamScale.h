@@ -53,6 +53,8 @@ namespace gip {
       Scale the source image to the destination image.
     */
     void operator()() noexcept {
+      static Metrics::Counter counter("BresenhamScale");
+      Metrics::Scope scope(counter, *Transformation<DEST, SRC>::destination, *Transformation<DEST, SRC>::source);
       const unsigned int destWidth = Transformation<DEST, SRC>::destination->getDimension().getWidth();
       const unsigned int destHeight = Transformation<DEST, SRC>::destination->getDimension().getHeight();
       const unsigned int srcWidth = Transformation<DEST, SRC>::source->getDimension().getWidth();
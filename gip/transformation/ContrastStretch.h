@@ -17,6 +17,7 @@
 #include <gip/ArrayImage.h>
 #include <gip/analysis/MinimumMaximum.h>
 #include <gip/analysis/traverse.h>
+#include <gip/LookupTable.h>
 #include <gip/ImageException.h>
 #include <base/Functor.h>
 
@@ -26,6 +27,26 @@ namespace gip {
   class ContrastStretch {
   };
 
+  /**
+    Fills the specified table of 256 entries which maps [minimum; maximum]
+    onto [0; 255]. Entries outside the range are clamped. The table is the
+    identity if minimum equals maximum.
+  */
+  inline void fillStretchLookup(uint8* lookup, unsigned int minimum, unsigned int maximum) noexcept {
+    const unsigned int range = maximum - minimum;
+    for (unsigned int i = 0; i < 256; ++i) {
+      if (range == 0) {
+        lookup[i] = i;
+      } else if (i <= minimum) {
+        lookup[i] = 0;
+      } else if (i >= maximum) {
+        lookup[i] = 0xff;
+      } else {
+        lookup[i] = (2 * (i - minimum) * 0xff + range)/(2 * range);
+      }
+    }
+  }
+
   /**
     @short Stretches the intensity of the image
     @ingroup transformations
@@ -74,15 +95,74 @@ namespace gip {
       bassert(destination->getDimension() == source->getDimension(), ImageException(this));
     }
 
-    void operator()() const noexcept {
+    void operator()() const {
+      static Metrics::Counter counter("ContrastStretch");
+      Metrics::Scope scope(counter, *destination, *source);
       MinimumMaximum<Pixel> minmax;
-      forEach(*source, minmax);
+      reduce(*source, minmax);
       MapPixel mapPixel(minmax.getMinimum(), minmax.getMaximum());
-      fillWithUnary(*destination, *source, mapPixel);
+      parallelFillWithUnary(*destination, *source, mapPixel);
     }
     
   };
 
+  /**
+    @short Stretches the intensity of the image
+    @ingroup transformations
+    @version 1.0
+  */
+
+  template<>
+  class ContrastStretch<Gray8Image, Gray8Image> : public Transformation<Gray8Image, Gray8Image> {
+  public:
+
+    typedef SourceImage::Pixel Pixel;
+
+    class MapPixel : public UnaryOperation<Pixel, Pixel> {
+    private:
+
+      uint8 lookup[256];
+    public:
+
+      inline MapPixel(const Pixel& minimum, const Pixel& maximum) noexcept {
+        fillStretchLookup(lookup, minimum, maximum);
+      }
+
+      /**
+        Returns the table for LookupTable.
+      */
+      inline const uint8* getTable() const noexcept {
+        return lookup;
+      }
+
+      inline Pixel operator()(const Pixel& value) const noexcept {
+        return lookup[value];
+      }
+    };
+
+    /**
+      Initializes the transformation.
+
+      @param destination The destination image.
+      @param source The source image.
+    */
+    ContrastStretch(DestinationImage* destination, const SourceImage* source)
+      : Transformation<Gray8Image, Gray8Image>(destination, source) {
+
+      bassert(destination->getDimension() == source->getDimension(), ImageException(this));
+    }
+
+    void operator()() const {
+      static Metrics::Counter counter("ContrastStretch");
+      Metrics::Scope scope(counter, *destination, *source);
+      MinimumMaximum<Pixel> minmax;
+      reduce(*source, minmax);
+      const MapPixel mapPixel(minmax.getMinimum(), minmax.getMaximum());
+      applyLookup(*destination, *source, mapPixel.getTable());
+    }
+
+  };
+
   template<>
   class ContrastStretch<ColorImage, ColorImage> : public Transformation<ColorImage, ColorImage> {
   public:
@@ -94,44 +174,22 @@ namespace gip {
     class MapPixel : public UnaryOperation<Pixel, Pixel> {
     private:
 
-      Allocator<Component> redAllocatorLookup;
-      Allocator<Component> greenAllocatorLookup;
-      Allocator<Component> blueAllocatorLookup;
-      Component* redLookup = nullptr;
-      Component* greenLookup = nullptr;
-      Component* blueLookup = nullptr;
+      Component redLookup[256];
+      Component greenLookup[256];
+      Component blueLookup[256];
     public:
 
-      inline MapPixel(const Pixel& minimum, const Pixel& maximum) noexcept
-        : redAllocatorLookup(static_cast<Arithmetic>(PixelTraits<Pixel>::MAXIMUM) + 1),
-          greenAllocatorLookup(static_cast<Arithmetic>(PixelTraits<Pixel>::MAXIMUM) + 1),
-          blueAllocatorLookup(static_cast<Arithmetic>(PixelTraits<Pixel>::MAXIMUM) + 1) {
-          Arithmetic range;
-
-          redLookup = redAllocatorLookup.getElements();
-          redLookup += minimum.red;
-          range = maximum.red - minimum.red;
-          for (int i = 0; i <= range; ++i) {
-            *redLookup++ = (2 * i * static_cast<Arithmetic>(PixelTraits<Pixel>::MAXIMUM) + range)/(2 * range);
-          }
-          redLookup = redAllocatorLookup.getElements();
-
-          greenLookup = greenAllocatorLookup.getElements();
-          greenLookup += minimum.green;
-          range = maximum.green - minimum.green;
-          for (int i = 0; i <= range; ++i) {
-            *greenLookup++ = (2 * i * static_cast<Arithmetic>(PixelTraits<Pixel>::MAXIMUM) + range)/(2 * range);
-          }
-          greenLookup = greenAllocatorLookup.getElements();
-
-          blueLookup = blueAllocatorLookup.getElements();
-          blueLookup += minimum.blue;
-          range = maximum.blue - minimum.blue;
-          for (int i = 0; i <= range; ++i) {
-            *blueLookup++ = (2 * i * static_cast<Arithmetic>(PixelTraits<Pixel>::MAXIMUM) + range)/(2 * range);
-          }
-          blueLookup = blueAllocatorLookup.getElements();
+      inline MapPixel(const Pixel& minimum, const Pixel& maximum) noexcept {
+        fillStretchLookup(redLookup, minimum.red, maximum.red);
+        fillStretchLookup(greenLookup, minimum.green, maximum.green);
+        fillStretchLookup(blueLookup, minimum.blue, maximum.blue);
+      }
 
+      /**
+        Returns the table for LookupTable.
+      */
+      inline LookupTable::ColorTable getTable() const noexcept {
+        return LookupTable::ColorTable(redLookup, greenLookup, blueLookup);
       }
 
       inline Pixel operator()(const Pixel& value) const noexcept {
@@ -151,11 +209,14 @@ namespace gip {
       bassert(destination->getDimension() == source->getDimension(), ImageException(this));
     }
 
-    void operator()() const noexcept {
+    void operator()() const {
+      static Metrics::Counter counter("ContrastStretch");
+      Metrics::Scope scope(counter, *destination, *source);
       MinimumMaximum<Pixel> minmax;
-      forEach(*source, minmax);
-      MapPixel mapPixel(minmax.getMinimum(), minmax.getMaximum());
-      fillWithUnary(*destination, *source, mapPixel);
+      reduce(*source, minmax);
+      const MapPixel mapPixel(minmax.getMinimum(), minmax.getMaximum());
+      const LookupTable::ColorTable table = mapPixel.getTable();
+      applyLookup(*destination, *source, table);
     }
 
   };
@@ -264,6 +264,8 @@ namespace gip {
     */
     void operator()() noexcept
     {
+      static Metrics::Counter counter("Convert");
+      Metrics::Scope scope(counter, *Transformation<DEST, SRC>::destination, *Transformation<DEST, SRC>::source);
       fillWithUnary(*Transformation<DEST, SRC>::destination, *Transformation<DEST, SRC>::source, convert);
     }
 
@@ -0,0 +1,678 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#pragma once
+
+#include <gip/transformation/Transformation.h>
+#include <gip/transformation/Convolution3x3.h>
+#include <gip/Border.h>
+#include <gip/ArrayImage.h>
+#include <gip/ImageException.h>
+#include <base/collection/Array.h>
+#include <base/mem/Allocator.h>
+
+namespace gip {
+
+  /** The type used to accumulate the products of kernel coefficients of type TYPE. */
+  template<class TYPE>
+  class ConvolutionArithmetic {
+  public:
+
+    typedef TYPE Accumulator;
+  };
+
+  template<>
+  class ConvolutionArithmetic<int> {
+  public:
+
+    typedef long long Accumulator;
+  };
+
+  /**
+    Access to the channels of a pixel for convolution. Floating-point results
+    are rounded to the nearest integer for integer pixels. The results are
+    clamped to the range of 8-bit pixels (Gray8Pixel and ColorPixel).
+  */
+  template<class PIXEL>
+  class ConvolutionPixel {
+  public:
+
+    enum {CHANNELS = 1};
+
+    template<class ACCUMULATOR>
+    static inline ACCUMULATOR get(const PIXEL& pixel, unsigned int) noexcept {
+      return static_cast<ACCUMULATOR>(pixel);
+    }
+
+    static inline void set(PIXEL& pixel, unsigned int, long long value) noexcept {
+      pixel = static_cast<PIXEL>(value);
+    }
+
+    static inline void set(PIXEL& pixel, unsigned int, float value) noexcept {
+      pixel = static_cast<PIXEL>((value < 0) ? (value - 0.5f) : (value + 0.5f));
+    }
+  };
+
+  template<>
+  class ConvolutionPixel<float> {
+  public:
+
+    enum {CHANNELS = 1};
+
+    template<class ACCUMULATOR>
+    static inline ACCUMULATOR get(const float& pixel, unsigned int) noexcept {
+      return static_cast<ACCUMULATOR>(pixel);
+    }
+
+    template<class ACCUMULATOR>
+    static inline void set(float& pixel, unsigned int, ACCUMULATOR value) noexcept {
+      pixel = static_cast<float>(value);
+    }
+  };
+
+  template<>
+  class ConvolutionPixel<Gray8Pixel> {
+  public:
+
+    enum {CHANNELS = 1};
+
+    template<class ACCUMULATOR>
+    static inline ACCUMULATOR get(const Gray8Pixel& pixel, unsigned int) noexcept {
+      return static_cast<ACCUMULATOR>(pixel);
+    }
+
+    static inline Gray8Pixel clamp(long long value) noexcept {
+      return static_cast<Gray8Pixel>((value < 0) ? 0 : ((value > 0xff) ? 0xff : value));
+    }
+
+    static inline Gray8Pixel clamp(float value) noexcept {
+      return static_cast<Gray8Pixel>((value <= 0) ? 0 : ((value >= 255) ? 0xff : static_cast<int>(value + 0.5f)));
+    }
+
+    template<class ACCUMULATOR>
+    static inline void set(Gray8Pixel& pixel, unsigned int, ACCUMULATOR value) noexcept {
+      pixel = clamp(value);
+    }
+  };
+
+  template<>
+  class ConvolutionPixel<ColorPixel> {
+  public:
+
+    enum {CHANNELS = 3};
+
+    template<class ACCUMULATOR>
+    static inline ACCUMULATOR get(const ColorPixel& pixel, unsigned int channel) noexcept {
+      return static_cast<ACCUMULATOR>((channel == 0) ? pixel.red : ((channel == 1) ? pixel.green : pixel.blue));
+    }
+
+    template<class ACCUMULATOR>
+    static inline void set(ColorPixel& pixel, unsigned int channel, ACCUMULATOR value) noexcept {
+      const uint8 component = ConvolutionPixel<Gray8Pixel>::clamp(value);
+      switch (channel) {
+      case 0:
+        pixel.red = component;
+        break;
+      case 1:
+        pixel.green = component;
+        break;
+      default:
+        pixel.blue = component;
+      }
+    }
+  };
+
+  /**
+    Convolution kernel of odd size with coefficients of type TYPE (int or
+    float). A kernel of rank one (e.g. box, pyramid and Gaussian kernels) is
+    detected as separable and is applied as a row pass followed by a column
+    pass which requires 2N instead of N*N multiplications per pixel. Integer
+    kernels are factored exactly and give the same result for both passes.
+
+    Normalization divides by the sum of the coefficients. A kernel whose
+    coefficients sum to 0 (e.g. an edge detector) is never normalized. The
+    scaled sum of products of an integer kernel is rounded to the nearest
+    integer with halfway cases away from zero.
+
+    @short Convolution kernel.
+    @ingroup transformations filtering
+    @version 1.0
+  */
+  template<class TYPE>
+  class ConvolutionKernel {
+  public:
+
+    typedef TYPE Coefficient;
+    typedef typename ConvolutionArithmetic<TYPE>::Accumulator Accumulator;
+  private:
+
+    /** The width and height of the kernel. */
+    unsigned int size = 0;
+    /** The coefficients (row by row). */
+    Array<TYPE> coefficients;
+    /** The horizontal factor of a separable kernel. */
+    Array<TYPE> row;
+    /** The vertical factor of a separable kernel. */
+    Array<TYPE> column;
+    /** Set if the kernel is separable. */
+    bool separable = false;
+    /** The multiplier applied to the sum of products. */
+    Accumulator multiplier = 1;
+    /** The divisor applied to the sum of products. */
+    Accumulator divisor = 1;
+    /** The multiplier applied to the sum of products of the separable passes. */
+    Accumulator separableMultiplier = 1;
+    /** The divisor applied to the sum of products of the separable passes. */
+    Accumulator separableDivisor = 1;
+
+    static inline long long getGCD(long long a, long long b) noexcept {
+      a = (a < 0) ? -a : a;
+      b = (b < 0) ? -b : b;
+      while (b) {
+        const long long temp = a % b;
+        a = b;
+        b = temp;
+      }
+      return a;
+    }
+
+    static inline bool isZero(long long value, long long) noexcept {
+      return value == 0;
+    }
+
+    static inline bool isZero(float value, float tolerance) noexcept {
+      return ((value < 0) ? -value : value) <= tolerance;
+    }
+
+    /** Divides by the positive divisor rounding halfway cases away from zero. */
+    static inline long long divide(long long value, long long divisor) noexcept {
+      return (value < 0) ? -((-value + divisor/2)/divisor) : ((value + divisor/2)/divisor);
+    }
+
+    static inline double divide(double value, double divisor) noexcept {
+      return value/divisor;
+    }
+
+    static inline double getAbsolute(TYPE value) noexcept {
+      return (value < 0) ? -static_cast<double>(value) : static_cast<double>(value);
+    }
+
+    /** Normalizes integer kernels by scaling the result. */
+    void normalize(Accumulator sum, long long*) noexcept {
+      multiplier = (sum < 0) ? -1 : 1;
+      divisor = (sum < 0) ? -sum : sum;
+    }
+
+    /** Normalizes floating-point kernels by scaling the coefficients. */
+    void normalize(Accumulator sum, float*) noexcept {
+      TYPE* coefficient = coefficients.getElements();
+      for (unsigned int i = 0; i < size * size; ++i) {
+        coefficient[i] /= sum;
+      }
+    }
+
+    /** Factors an integer kernel as column[i] * row[j] * multiplier/divisor. */
+    void factor(TYPE pivot, long long*) {
+      long long rowGCD = 0;
+      long long columnGCD = 0;
+      for (unsigned int i = 0; i < size; ++i) {
+        rowGCD = getGCD(rowGCD, row.getElements()[i]);
+        columnGCD = getGCD(columnGCD, column.getElements()[i]);
+      }
+      for (unsigned int i = 0; i < size; ++i) {
+        row.getElements()[i] /= static_cast<TYPE>(rowGCD);
+        column.getElements()[i] /= static_cast<TYPE>(columnGCD);
+      }
+      // kernel = column * row * rowGCD * columnGCD/pivot
+      long long numerator = rowGCD * columnGCD * multiplier;
+      long long denominator = static_cast<long long>(pivot) * divisor;
+      if (denominator < 0) {
+        numerator = -numerator;
+        denominator = -denominator;
+      }
+      const long long gcd = getGCD(numerator, denominator);
+      separableMultiplier = numerator/gcd;
+      separableDivisor = denominator/gcd;
+    }
+
+    /** Factors a floating-point kernel as column[i] * row[j]. */
+    void factor(TYPE pivot, float*) noexcept {
+      for (unsigned int i = 0; i < size; ++i) {
+        row.getElements()[i] /= pivot;
+      }
+    }
+
+    /** Detects if the kernel has rank one and finds the factors. */
+    void detectSeparable() {
+      const TYPE* k = coefficients.getElements();
+      unsigned int pivotRow = 0;
+      unsigned int pivotColumn = 0;
+      double largest = 0;
+      for (unsigned int i = 0; i < size; ++i) {
+        for (unsigned int j = 0; j < size; ++j) {
+          if (getAbsolute(k[i * size + j]) > largest) {
+            largest = getAbsolute(k[i * size + j]);
+            pivotRow = i;
+            pivotColumn = j;
+          }
+        }
+      }
+      if ((size == 1) || (largest == 0)) {
+        return; // nothing to gain
+      }
+
+      // rank one if k[i][j] * pivot == k[i][pivotColumn] * k[pivotRow][j] for all entries
+      const TYPE pivot = k[pivotRow * size + pivotColumn];
+      const Accumulator tolerance = static_cast<Accumulator>(largest * largest * 1e-6);
+      for (unsigned int i = 0; i < size; ++i) {
+        for (unsigned int j = 0; j < size; ++j) {
+          const Accumulator difference =
+            static_cast<Accumulator>(k[i * size + j]) * pivot -
+            static_cast<Accumulator>(k[i * size + pivotColumn]) * k[pivotRow * size + j];
+          if (!isZero(difference, tolerance)) {
+            return;
+          }
+        }
+      }
+
+      row.setSize(size);
+      column.setSize(size);
+      for (unsigned int i = 0; i < size; ++i) {
+        row.getElements()[i] = k[pivotRow * size + i];
+        column.getElements()[i] = k[i * size + pivotColumn];
+      }
+      factor(pivot, static_cast<Accumulator*>(nullptr));
+      separable = true;
+    }
+  public:
+
+    /**
+      Initializes the kernel. Raises ImageException if the size is not odd.
+
+      @param size The width and height of the kernel.
+      @param coefficients The size*size coefficients row by row.
+      @param normalize Specifies that the result is divided by the sum of the coefficients.
+    */
+    ConvolutionKernel(unsigned int _size, const TYPE* _coefficients, bool _normalize = false)
+      : size(_size) {
+      bassert((size % 2) == 1, ImageException("Kernel size must be odd"));
+      coefficients.setSize(size * size);
+      TYPE* coefficient = coefficients.getElements();
+      Accumulator sum = 0;
+      for (unsigned int i = 0; i < size * size; ++i) {
+        coefficient[i] = _coefficients[i];
+        sum += _coefficients[i];
+      }
+      if (_normalize && (sum != 0)) {
+        normalize(sum, static_cast<Accumulator*>(nullptr));
+      }
+      detectSeparable();
+    }
+
+    /**
+      Returns the width and height of the kernel.
+    */
+    inline unsigned int getSize() const noexcept {
+      return size;
+    }
+
+    /**
+      Returns the number of pixels on each side of the center.
+    */
+    inline unsigned int getRadius() const noexcept {
+      return size/2;
+    }
+
+    /**
+      Returns the coefficients row by row.
+    */
+    inline const TYPE* getCoefficients() const noexcept {
+      return coefficients.getElements();
+    }
+
+    /**
+      Returns true if the kernel is separable.
+    */
+    inline bool isSeparable() const noexcept {
+      return separable;
+    }
+
+    /**
+      Returns the horizontal factor of a separable kernel.
+    */
+    inline const TYPE* getRow() const noexcept {
+      return row.getElements();
+    }
+
+    /**
+      Returns the vertical factor of a separable kernel.
+    */
+    inline const TYPE* getColumn() const noexcept {
+      return column.getElements();
+    }
+
+    /**
+      Scales the sum of products of the kernel.
+    */
+    inline Accumulator scale(Accumulator sum) const noexcept {
+      return divide(sum * multiplier, divisor);
+    }
+
+    /**
+      Scales the sum of products of the separable passes.
+    */
+    inline Accumulator scaleSeparable(Accumulator sum) const noexcept {
+      return divide(sum * separableMultiplier, separableDivisor);
+    }
+  };
+
+  /** Reads the coefficients of a kernel defined with the M00..M(N-1)(N-1) enums (e.g. SmoothPyramid5x5). */
+  template<class KERNEL, unsigned int SIZE>
+  class KernelCoefficients {
+  };
+
+  template<class KERNEL>
+  class KernelCoefficients<KERNEL, 3> {
+  public:
+
+    static void get(int* coefficients) noexcept {
+      const int values[] = {
+        KERNEL::M00, KERNEL::M01, KERNEL::M02,
+        KERNEL::M10, KERNEL::M11, KERNEL::M12,
+        KERNEL::M20, KERNEL::M21, KERNEL::M22
+      };
+      for (unsigned int i = 0; i < 3 * 3; ++i) {
+        coefficients[i] = values[i];
+      }
+    }
+  };
+
+  template<class KERNEL>
+  class KernelCoefficients<KERNEL, 5> {
+  public:
+
+    static void get(int* coefficients) noexcept {
+      const int values[] = {
+        KERNEL::M00, KERNEL::M01, KERNEL::M02, KERNEL::M03, KERNEL::M04,
+        KERNEL::M10, KERNEL::M11, KERNEL::M12, KERNEL::M13, KERNEL::M14,
+        KERNEL::M20, KERNEL::M21, KERNEL::M22, KERNEL::M23, KERNEL::M24,
+        KERNEL::M30, KERNEL::M31, KERNEL::M32, KERNEL::M33, KERNEL::M34,
+        KERNEL::M40, KERNEL::M41, KERNEL::M42, KERNEL::M43, KERNEL::M44
+      };
+      for (unsigned int i = 0; i < 5 * 5; ++i) {
+        coefficients[i] = values[i];
+      }
+    }
+  };
+
+  /** Returns true if the enum kernel derives from NormalizedKernel. */
+  template<class KERNEL>
+  constexpr bool isNormalizedKernel(decltype(KERNEL::NORMALIZED)*) noexcept {
+    return KERNEL::NORMALIZED;
+  }
+
+  template<class KERNEL>
+  constexpr bool isNormalizedKernel(...) noexcept {
+    return false;
+  }
+
+  /**
+    Returns the convolution kernel for the specified enum kernel (e.g.
+    makeConvolutionKernel<SmoothPyramid5x5, 5>()). Kernels derived from
+    NormalizedKernel are normalized.
+  */
+  template<class KERNEL, unsigned int SIZE>
+  ConvolutionKernel<int> makeConvolutionKernel() {
+    int coefficients[SIZE * SIZE];
+    KernelCoefficients<KERNEL, SIZE>::get(coefficients);
+    return ConvolutionKernel<int>(SIZE, coefficients, isNormalizedKernel<KERNEL>(nullptr));
+  }
+
+  /**
+    Convolution with a kernel of any odd size. Separable kernels are applied
+    as a row pass and a column pass. Gray, color (per component) and float
+    images are supported. The results are rounded to the nearest integer for
+    integer destination pixels and are clamped to the range of 8-bit
+    destination pixels.
+
+    @code
+    Convolution<Gray8Image, Gray8Image> blur(&destination, &source, kernel);
+    blur();
+    ConvolutionNxN<ColorImage, ColorImage, SmoothPyramid5x5, 5> pyramid(&destination, &source);
+    pyramid();
+    @endcode
+
+    @short Convolution with NxN kernel.
+    @ingroup transformations filtering
+    @see ConvolutionKernel
+    @version 1.0
+  */
+  template<class DEST, class SRC, class TYPE = int>
+  class Convolution : public Transformation<DEST, SRC> {
+  public:
+
+    typedef typename Transformation<DEST, SRC>::DestinationImage DestinationImage;
+    typedef typename Transformation<DEST, SRC>::SourceImage SourceImage;
+    typedef typename DestinationImage::Pixel DestinationPixel;
+    typedef typename SourceImage::Pixel SourcePixel;
+    typedef typename ConvolutionKernel<TYPE>::Accumulator Accumulator;
+    typedef ConvolutionPixel<SourcePixel> SourceChannels;
+    typedef ConvolutionPixel<DestinationPixel> DestinationChannels;
+
+    enum {CHANNELS = SourceChannels::CHANNELS};
+  private:
+
+    /** The kernel. */
+    ConvolutionKernel<TYPE> kernel;
+    /** The border mode. */
+    Border::Mode border = Border::REPLICATE;
+    /** The value of the pixels outside the source image for Border::CONSTANT. */
+    SourcePixel constant;
+
+    /** Applies the full kernel to every pixel. */
+    void applyDirect(const Region& region) const {
+      const unsigned int size = kernel.getSize();
+      const int radius = kernel.getRadius();
+      const unsigned int firstColumn = region.getOffset().getColumn();
+      const unsigned int endColumn = region.getEndColumn();
+      const MemorySize destinationPitch = Transformation<DEST, SRC>::destination->getPitch();
+      DestinationPixel* dest = Transformation<DEST, SRC>::destination->getElements();
+      BorderRows<SourceImage> rows(*Transformation<DEST, SRC>::source, firstColumn, endColumn, radius, border, constant);
+      Allocator<const SourcePixel*> window(size);
+      const SourcePixel** top = window.getElements();
+
+      for (unsigned int y = region.getOffset().getRow(); y < region.getEndRow(); ++y) {
+        rows.seek(y);
+        for (unsigned int i = 0; i < size; ++i) {
+          top[i] = rows.getRow(static_cast<int>(i) - radius) - radius;
+        }
+        DestinationPixel* destRow = dest + y * destinationPitch;
+        for (unsigned int x = firstColumn; x < endColumn; ++x) {
+          for (unsigned int channel = 0; channel < CHANNELS; ++channel) {
+            const TYPE* coefficient = kernel.getCoefficients();
+            Accumulator sum = 0;
+            for (unsigned int i = 0; i < size; ++i) {
+              const SourcePixel* s = top[i] + (x - firstColumn);
+              for (unsigned int j = 0; j < size; ++j) {
+                sum += static_cast<Accumulator>(*coefficient++) *
+                  SourceChannels::template get<Accumulator>(s[j], channel);
+              }
+            }
+            DestinationChannels::set(destRow[x], channel, kernel.scale(sum));
+          }
+        }
+      }
+    }
+
+    /** Filters the specified padded source row (starting at radius columns before the first column) horizontally. */
+    void filterRow(Accumulator* result, const SourcePixel* src, unsigned int columns) const noexcept {
+      const unsigned int size = kernel.getSize();
+      const TYPE* row = kernel.getRow();
+      for (unsigned int x = 0; x < columns; ++x) {
+        for (unsigned int channel = 0; channel < CHANNELS; ++channel) {
+          Accumulator sum = 0;
+          for (unsigned int j = 0; j < size; ++j) {
+            sum += static_cast<Accumulator>(row[j]) * SourceChannels::template get<Accumulator>(src[x + j], channel);
+          }
+          *result++ = sum;
+        }
+      }
+    }
+
+    /** Applies the row pass into a ring of rows followed by the column pass. */
+    void applySeparable(const Region& region) const {
+      const unsigned int size = kernel.getSize();
+      const int radius = kernel.getRadius();
+      const TYPE* column = kernel.getColumn();
+      const unsigned int firstColumn = region.getOffset().getColumn();
+      const unsigned int endColumn = region.getEndColumn();
+      const unsigned int firstRow = region.getOffset().getRow();
+      const MemorySize stride = static_cast<MemorySize>(endColumn - firstColumn) * CHANNELS;
+      Allocator<Accumulator> ring(size * stride);
+      Allocator<const Accumulator*> rows(size);
+      Accumulator* buffer = ring.getElements();
+      const MemorySize destinationPitch = Transformation<DEST, SRC>::destination->getPitch();
+      DestinationPixel* dest = Transformation<DEST, SRC>::destination->getElements();
+      BorderRows<SourceImage> padded(*Transformation<DEST, SRC>::source, firstColumn, endColumn, radius, border, constant);
+
+      // the ring holds source rows y - radius to y + radius (row r at slot (r + radius) % size)
+      for (unsigned int y = firstRow; y < region.getEndRow(); ++y) {
+        padded.seek(y);
+        if (y == firstRow) {
+          for (int k = -radius; k < radius; ++k) {
+            filterRow(buffer + ((y + k + radius) % size) * stride, padded.getRow(k) - radius, endColumn - firstColumn);
+          }
+        }
+        filterRow(buffer + ((y + 2 * radius) % size) * stride, padded.getRow(radius) - radius, endColumn - firstColumn);
+        for (unsigned int i = 0; i < size; ++i) {
+          rows.getElements()[i] = buffer + ((y + i) % size) * stride;
+        }
+        const Accumulator* const* row = rows.getElements();
+        DestinationPixel* destRow = dest + y * destinationPitch;
+        MemorySize offset = 0;
+        for (unsigned int x = firstColumn; x < endColumn; ++x) {
+          for (unsigned int channel = 0; channel < CHANNELS; ++channel, ++offset) {
+            Accumulator sum = 0;
+            for (unsigned int i = 0; i < size; ++i) {
+              sum += static_cast<Accumulator>(column[i]) * row[i][offset];
+            }
+            DestinationChannels::set(destRow[x], channel, kernel.scaleSeparable(sum));
+          }
+        }
+      }
+    }
+  public:
+
+    /**
+      Initializes the transformation.
+
+      @param destination The destination image.
+      @param source The source image.
+      @param kernel The kernel.
+      @param border The border mode. The default is Border::REPLICATE.
+      @param constant The value of the pixels outside the source image for Border::CONSTANT.
+    */
+    Convolution(
+      DestinationImage* destination,
+      const SourceImage* source,
+      const ConvolutionKernel<TYPE>& _kernel,
+      Border::Mode _border = Border::REPLICATE,
+      const SourcePixel& _constant = SourcePixel())
+      : Transformation<DestinationImage, SourceImage>(destination, source),
+        kernel(_kernel),
+        border(_border),
+        constant(_constant) {
+      bassert(destination->getDimension() == source->getDimension(), ImageException(this));
+      bassert(destination != source, ImageException("Convolution cannot be done in place", this));
+    }
+
+    /**
+      Returns the kernel.
+    */
+    inline const ConvolutionKernel<TYPE>& getKernel() const noexcept {
+      return kernel;
+    }
+
+    /**
+      Returns the number of source rows above and below a row required to
+      calculate the row (e.g. for Pipeline::add()).
+    */
+    inline unsigned int getHalo() const noexcept {
+      return kernel.getRadius();
+    }
+
+    /**
+      Calculates the transformation for the specified region of the destination
+      image. For Border::NONE the pixels closer to the border of the image than
+      the radius of the kernel are not modified.
+    */
+    void operator()(const Region& region) const {
+      bassert(region.isWithin(Transformation<DEST, SRC>::destination->getDimension()), ImageException(this));
+      const Region calculate = Border::getRegion(
+        region, Transformation<DEST, SRC>::source->getDimension(), kernel.getRadius(), border
+      );
+      if (!calculate.isProper()) {
+        return;
+      }
+      if (kernel.isSeparable()) {
+        applySeparable(calculate);
+      } else {
+        applyDirect(calculate);
+      }
+    }
+
+    /**
+      Calculate transformation.
+    */
+    void operator()() const {
+      static Metrics::Counter counter("Convolution");
+      Metrics::Scope scope(counter, *Transformation<DEST, SRC>::destination, *Transformation<DEST, SRC>::source);
+      (*this)(Region(Point2D(0, 0), Transformation<DEST, SRC>::destination->getDimension()));
+    }
+  };
+
+  /**
+    Convolution with a kernel defined by enums (e.g. SmoothPyramid5x5).
+
+    @short Convolution with NxN enum kernel.
+    @ingroup transformations filtering
+    @version 1.0
+  */
+  template<class DEST, class SRC, class KERNEL, unsigned int SIZE>
+  class ConvolutionNxN : public Convolution<DEST, SRC, int> {
+  public:
+
+    typedef typename Convolution<DEST, SRC, int>::DestinationImage DestinationImage;
+    typedef typename Convolution<DEST, SRC, int>::SourceImage SourceImage;
+
+    /** The number of source rows above and below a row required to calculate the row. */
+    static constexpr unsigned int HALO = SIZE/2;
+
+    /**
+      Initializes the transformation.
+
+      @param destination The destination image.
+      @param source The source image.
+      @param border The border mode. The default is Border::REPLICATE.
+      @param constant The value of the pixels outside the source image for Border::CONSTANT.
+    */
+    ConvolutionNxN(
+      DestinationImage* destination,
+      const SourceImage* source,
+      Border::Mode border = Border::REPLICATE,
+      const typename SourceImage::Pixel& constant = typename SourceImage::Pixel())
+      : Convolution<DEST, SRC, int>(destination, source, makeConvolutionKernel<KERNEL, SIZE>(), border, constant) {
+    }
+  };
+
+}; // end of gip namespace
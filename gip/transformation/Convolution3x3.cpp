@@ -12,5 +12,249 @@
  ***************************************************************************/
 
 #include <gip/transformation/Convolution3x3.h>
+#include <gip/CPUDispatch.h>
 
-_COM_AZURE_DEV__BASE__DUMMY_SYMBOL
+#if defined(_COM_AZURE_DEV__GIP__SIMD_X86)
+#  include <immintrin.h>
+#endif
+
+namespace gip {
+
+  namespace {
+
+    static_assert(sizeof(ColorPixel) == 4, "ColorPixel must be 32 bits.");
+
+    typedef void (*Convolve)(
+      uint8*, const uint8*, const uint8*, const uint8*, MemorySize, const Convolution3x3Engine::Coefficients&);
+
+    /*
+      The samples are bytes. STEP is the distance in bytes between horizontal
+      neighbors (1 for gray and 4 for ColorPixel). The unused byte of a
+      ColorPixel is set to 0.
+    */
+
+    template<unsigned int STEP>
+    void convolveScalar(
+      uint8* dest,
+      const uint8* previous,
+      const uint8* current,
+      const uint8* next,
+      MemorySize size,
+      const Convolution3x3Engine::Coefficients& kernel) noexcept {
+      const int* m = kernel.coefficients;
+      for (MemorySize i = 0; i < size; ++i) {
+        if ((STEP == 4) && ((i & 3) == 3)) {
+          dest[i] = 0;
+          continue;
+        }
+        const int sum =
+          m[0] * previous[i - STEP] + m[1] * previous[i] + m[2] * previous[i + STEP] +
+          m[3] * current[i - STEP] + m[4] * current[i] + m[5] * current[i + STEP] +
+          m[6] * next[i - STEP] + m[7] * next[i] + m[8] * next[i + STEP];
+        dest[i] = static_cast<uint8>(sum/kernel.divisor);
+      }
+    }
+
+#if defined(_COM_AZURE_DEV__GIP__SIMD_X86)
+
+    /*
+      The products and sums are 16-bit. Without division only the low 8 bits
+      of the sum are used and these are exact modulo 2^16. With division the
+      sums are within +/-32640 (see Coefficients) and the truncated quotient of
+      |sum| is mulhi(|sum|, reciprocal) >> shift.
+    */
+
+    _COM_AZURE_DEV__GIP__TARGET("sse2")
+    inline void multiplyAdd(__m128i& low, __m128i& high, const uint8* src, __m128i coefficient) noexcept {
+      const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+      const __m128i zero = _mm_setzero_si128();
+      low = _mm_add_epi16(low, _mm_mullo_epi16(_mm_unpacklo_epi8(value, zero), coefficient));
+      high = _mm_add_epi16(high, _mm_mullo_epi16(_mm_unpackhi_epi8(value, zero), coefficient));
+    }
+
+    _COM_AZURE_DEV__GIP__TARGET("sse2")
+    inline __m128i divide(__m128i sum, __m128i reciprocal, __m128i shift) noexcept {
+      const __m128i sign = _mm_srai_epi16(sum, 15);
+      const __m128i magnitude = _mm_sub_epi16(_mm_xor_si128(sum, sign), sign);
+      const __m128i quotient = _mm_srl_epi16(_mm_mulhi_epu16(magnitude, reciprocal), shift);
+      return _mm_sub_epi16(_mm_xor_si128(quotient, sign), sign);
+    }
+
+    template<unsigned int STEP>
+    _COM_AZURE_DEV__GIP__TARGET("sse2")
+    void convolveSSE2(
+      uint8* dest,
+      const uint8* previous,
+      const uint8* current,
+      const uint8* next,
+      MemorySize size,
+      const Convolution3x3Engine::Coefficients& kernel) noexcept {
+      if (!kernel.vectorizable) {
+        convolveScalar<STEP>(dest, previous, current, next, size, kernel);
+        return;
+      }
+      __m128i m[9];
+      for (unsigned int i = 0; i < 9; ++i) {
+        m[i] = _mm_set1_epi16(kernel.narrow[i]);
+      }
+      const bool normalize = kernel.divisor != 1;
+      const __m128i reciprocal = _mm_set1_epi16(static_cast<int16>(kernel.reciprocal));
+      const __m128i shift = _mm_cvtsi32_si128(kernel.shift);
+      const __m128i byte = _mm_set1_epi16(0xff);
+      const __m128i mask = _mm_set1_epi32((STEP == 4) ? 0x00ffffff : -1);
+      MemorySize i = 0;
+      for (; (size - i) >= 16; i += 16) {
+        __m128i low = _mm_setzero_si128();
+        __m128i high = _mm_setzero_si128();
+        multiplyAdd(low, high, previous + i - STEP, m[0]);
+        multiplyAdd(low, high, previous + i, m[1]);
+        multiplyAdd(low, high, previous + i + STEP, m[2]);
+        multiplyAdd(low, high, current + i - STEP, m[3]);
+        multiplyAdd(low, high, current + i, m[4]);
+        multiplyAdd(low, high, current + i + STEP, m[5]);
+        multiplyAdd(low, high, next + i - STEP, m[6]);
+        multiplyAdd(low, high, next + i, m[7]);
+        multiplyAdd(low, high, next + i + STEP, m[8]);
+        if (normalize) {
+          low = divide(low, reciprocal, shift);
+          high = divide(high, reciprocal, shift);
+        }
+        const __m128i result = _mm_packus_epi16(_mm_and_si128(low, byte), _mm_and_si128(high, byte));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), _mm_and_si128(result, mask));
+      }
+      convolveScalar<STEP>(dest + i, previous + i, current + i, next + i, size - i, kernel);
+    }
+
+    _COM_AZURE_DEV__GIP__TARGET("avx2")
+    inline void multiplyAdd(__m256i& low, __m256i& high, const uint8* src, __m256i coefficient) noexcept {
+      const __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+      const __m256i zero = _mm256_setzero_si256();
+      low = _mm256_add_epi16(low, _mm256_mullo_epi16(_mm256_unpacklo_epi8(value, zero), coefficient));
+      high = _mm256_add_epi16(high, _mm256_mullo_epi16(_mm256_unpackhi_epi8(value, zero), coefficient));
+    }
+
+    _COM_AZURE_DEV__GIP__TARGET("avx2")
+    inline __m256i divide(__m256i sum, __m256i reciprocal, __m128i shift) noexcept {
+      const __m256i quotient = _mm256_srl_epi16(_mm256_mulhi_epu16(_mm256_abs_epi16(sum), reciprocal), shift);
+      return _mm256_sign_epi16(quotient, sum);
+    }
+
+    /* The unpacking and packing are within 128-bit lanes so the samples stay in order. */
+    template<unsigned int STEP>
+    _COM_AZURE_DEV__GIP__TARGET("avx2")
+    void convolveAVX2(
+      uint8* dest,
+      const uint8* previous,
+      const uint8* current,
+      const uint8* next,
+      MemorySize size,
+      const Convolution3x3Engine::Coefficients& kernel) noexcept {
+      if (!kernel.vectorizable) {
+        convolveScalar<STEP>(dest, previous, current, next, size, kernel);
+        return;
+      }
+      __m256i m[9];
+      for (unsigned int i = 0; i < 9; ++i) {
+        m[i] = _mm256_set1_epi16(kernel.narrow[i]);
+      }
+      const bool normalize = kernel.divisor != 1;
+      const __m256i reciprocal = _mm256_set1_epi16(static_cast<int16>(kernel.reciprocal));
+      const __m128i shift = _mm_cvtsi32_si128(kernel.shift);
+      const __m256i byte = _mm256_set1_epi16(0xff);
+      const __m256i mask = _mm256_set1_epi32((STEP == 4) ? 0x00ffffff : -1);
+      MemorySize i = 0;
+      for (; (size - i) >= 32; i += 32) {
+        __m256i low = _mm256_setzero_si256();
+        __m256i high = _mm256_setzero_si256();
+        multiplyAdd(low, high, previous + i - STEP, m[0]);
+        multiplyAdd(low, high, previous + i, m[1]);
+        multiplyAdd(low, high, previous + i + STEP, m[2]);
+        multiplyAdd(low, high, current + i - STEP, m[3]);
+        multiplyAdd(low, high, current + i, m[4]);
+        multiplyAdd(low, high, current + i + STEP, m[5]);
+        multiplyAdd(low, high, next + i - STEP, m[6]);
+        multiplyAdd(low, high, next + i, m[7]);
+        multiplyAdd(low, high, next + i + STEP, m[8]);
+        if (normalize) {
+          low = divide(low, reciprocal, shift);
+          high = divide(high, reciprocal, shift);
+        }
+        const __m256i result = _mm256_packus_epi16(_mm256_and_si256(low, byte), _mm256_and_si256(high, byte));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i), _mm256_and_si256(result, mask));
+      }
+      convolveSSE2<STEP>(dest + i, previous + i, current + i, next + i, size - i, kernel);
+    }
+#endif
+
+    CPUDispatch::Kernel<Convolve> convolveGray("convolution3x3", convolveScalar<1>);
+    CPUDispatch::Kernel<Convolve> convolveColor("convolution3x3Color", convolveScalar<4>);
+
+    /** Registers the SIMD implementations. */
+    class Registration {
+    public:
+
+      Registration() noexcept {
+#if defined(_COM_AZURE_DEV__GIP__SIMD_X86)
+        convolveGray.set(CPUDispatch::LEVEL_SSE2, convolveSSE2<1>);
+        convolveGray.set(CPUDispatch::LEVEL_AVX2, convolveAVX2<1>);
+        convolveColor.set(CPUDispatch::LEVEL_SSE2, convolveSSE2<4>);
+        convolveColor.set(CPUDispatch::LEVEL_AVX2, convolveAVX2<4>);
+#endif
+      }
+    };
+
+    Registration registration;
+  }
+
+  Convolution3x3Engine::Coefficients::Coefficients(const int* _coefficients, int _divisor) noexcept
+    : divisor(_divisor) {
+    int magnitude = 0;
+    bool narrowable = true;
+    for (unsigned int i = 0; i < 9; ++i) {
+      coefficients[i] = _coefficients[i];
+      narrow[i] = static_cast<int16>(_coefficients[i]);
+      narrowable = narrowable && (narrow[i] == _coefficients[i]);
+      magnitude += (_coefficients[i] < 0) ? -_coefficients[i] : _coefficients[i];
+    }
+    if (divisor == 1) {
+      vectorizable = narrowable; // the low 8 bits are exact modulo 2^16
+    } else if ((divisor > 1) && narrowable && (magnitude <= 128)) { // |sum| <= 255 * 128 < 2^15
+      // with 2^(l-1) < divisor <= 2^l the reciprocal ceil(2^(15+l)/divisor) is below 2^16 and exact for sums below 2^15
+      unsigned int l = 1;
+      while ((1 << l) < divisor) {
+        ++l;
+      }
+      reciprocal = static_cast<uint16>(((1U << (15 + l)) + divisor - 1)/divisor);
+      shift = l - 1;
+      vectorizable = true;
+    }
+  }
+
+  void Convolution3x3Engine::convolve(
+    uint8* destination,
+    const uint8* previous,
+    const uint8* current,
+    const uint8* next,
+    MemorySize size,
+    const Coefficients& coefficients) noexcept {
+    convolveGray.get()(destination, previous, current, next, size, coefficients);
+  }
+
+  void Convolution3x3Engine::convolve(
+    ColorPixel* destination,
+    const ColorPixel* previous,
+    const ColorPixel* current,
+    const ColorPixel* next,
+    MemorySize size,
+    const Coefficients& coefficients) noexcept {
+    convolveColor.get()(
+      reinterpret_cast<uint8*>(destination),
+      reinterpret_cast<const uint8*>(previous),
+      reinterpret_cast<const uint8*>(current),
+      reinterpret_cast<const uint8*>(next),
+      size * sizeof(ColorPixel),
+      coefficients
+    );
+  }
+
+}; // end of gip namespace
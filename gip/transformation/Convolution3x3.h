@@ -14,7 +14,9 @@
 #pragma once
 
 #include <gip/gip.h>
+#include <gip/ArrayImage.h>
 #include <gip/transformation/Transformation.h>
+#include <gip/Border.h>
 #include <base/mem/Allocator.h>
 
 namespace gip {
@@ -128,8 +130,120 @@ namespace gip {
   };
 
   /**
-    Convolution with 3x3 matrix.
-    
+    Engine for the 3x3 convolution of 8-bit gray and color pixels a row at a
+    time. The sums are accumulated in 16-bit integers (16 and 32 samples per
+    step for SSE2 and AVX2) and the division of normalized kernels is a
+    multiplication by a reciprocal. The result is the low 8 bits of the
+    truncated quotient like for the generic implementation of Convolution3x3.
+
+    The implementation is selected by CPUDispatch (kernels "convolution3x3"
+    and "convolution3x3Color"). Kernels for which the sum does not fit in 16
+    bits are convolved by the portable implementation. All the
+    implementations produce identical results.
+
+    @short 3x3 convolution engine.
+    @ingroup transformations filtering
+    @see CPUDispatch
+    @version 1.0
+  */
+
+  class _COM_AZURE_DEV__GIP__API Convolution3x3Engine : public Object {
+  public:
+
+    /**
+      The kernel prepared for the engine.
+    */
+    class _COM_AZURE_DEV__GIP__API Coefficients {
+    public:
+
+      /** The coefficients in row-major order. */
+      int coefficients[9];
+      /** The divisor. */
+      int divisor = 1;
+      /** The coefficients as 16-bit integers. */
+      int16 narrow[9];
+      /** The reciprocal of the divisor scaled by 2^(16 + shift). */
+      uint16 reciprocal = 0;
+      /** The shift of the scaled reciprocal. */
+      unsigned int shift = 0;
+      /** Specifies that the 16-bit implementations are exact. */
+      bool vectorizable = false;
+
+      /**
+        Initializes the coefficients.
+
+        @param coefficients The 9 coefficients in row-major order.
+        @param divisor The divisor (must not be 0).
+      */
+      Coefficients(const int* coefficients, int divisor) noexcept;
+
+      /**
+        Returns the divisor of the specified kernel class (the sum of the
+        coefficients for normalized kernels and 1 otherwise).
+      */
+      template<class KERNEL>
+      static inline int getDivisor() noexcept {
+        return (KERNEL::NORMALIZE) ?
+          (KERNEL::M00 + KERNEL::M01 + KERNEL::M02 +
+           KERNEL::M10 + KERNEL::M11 + KERNEL::M12 +
+           KERNEL::M20 + KERNEL::M21 + KERNEL::M22) : 1;
+      }
+
+      /**
+        Initializes the coefficients from the specified kernel class. The
+        divisor of the kernel must not be 0.
+      */
+      template<class KERNEL>
+      static inline Coefficients make() noexcept {
+        const int coefficients[9] = {
+          KERNEL::M00, KERNEL::M01, KERNEL::M02,
+          KERNEL::M10, KERNEL::M11, KERNEL::M12,
+          KERNEL::M20, KERNEL::M21, KERNEL::M22
+        };
+        return Coefficients(coefficients, getDivisor<KERNEL>());
+      }
+    };
+
+    /**
+      Convolves a row of samples. The source rows must have one sample before
+      and after the specified samples.
+
+      @param destination The destination samples.
+      @param previous The samples of the row above.
+      @param current The samples of the row.
+      @param next The samples of the row below.
+      @param size The number of samples.
+      @param coefficients The kernel.
+    */
+    static void convolve(
+      uint8* destination,
+      const uint8* previous,
+      const uint8* current,
+      const uint8* next,
+      MemorySize size,
+      const Coefficients& coefficients) noexcept;
+
+    /**
+      Convolves each component of a row of pixels. The source rows must have
+      one pixel before and after the specified pixels.
+    */
+    static void convolve(
+      ColorPixel* destination,
+      const ColorPixel* previous,
+      const ColorPixel* current,
+      const ColorPixel* next,
+      MemorySize size,
+      const Coefficients& coefficients) noexcept;
+  };
+
+  /**
+    Convolution with 3x3 matrix. Gray8Image and ColorImage are convolved by
+    Convolution3x3Engine. The 8-bit results are the low 8 bits of the
+    truncated quotient and are not clamped. Thus negative and large results
+    of kernels such as VerticalSobel and HorizontalPrewitt wrap around
+    whereas ConvolutionNxN clamps to [0; 255]. Use a wider destination
+    pixel (e.g. GrayImage) to keep the sign and magnitude.
+
     @short Convolution with 3x3 matrix
     @ingroup transformations filtering
     @version 1.0
@@ -141,24 +255,41 @@ namespace gip {
 
     typedef typename Transformation<DEST, SRC>::DestinationImage DestinationImage;
     typedef typename Transformation<DEST, SRC>::SourceImage SourceImage;
+  private:
+
+    /** The border mode. */
+    Border::Mode border = Border::REPLICATE;
+    /** The value of the pixels outside the source image for Border::CONSTANT. */
+    typename SourceImage::Pixel constant;
+  public:
 
     /**
       Initializes the transformation.
 
       @param destination The destination image.
       @param source The source image.
+      @param border The border mode. The default is Border::REPLICATE.
+      @param constant The value of the pixels outside the source image for Border::CONSTANT.
     */
-    Convolution3x3(DestinationImage* destination, const SourceImage* source) 
-      : Transformation<DestinationImage, SourceImage>(destination, source) {
+    Convolution3x3(
+      DestinationImage* destination,
+      const SourceImage* source,
+      Border::Mode _border = Border::REPLICATE,
+      const typename SourceImage::Pixel& _constant = typename SourceImage::Pixel())
+      : Transformation<DestinationImage, SourceImage>(destination, source), border(_border), constant(_constant) {
       
       bassert(destination->getDimension() == source->getDimension(), ImageException(this));
+      bassert(
+        Convolution3x3Engine::Coefficients::getDivisor<KERNEL>() != 0,
+        ImageException("Normalized kernel sums to zero", this)
+      );
     }
     
     template<class PIXEL>
     class ApplyKernel {
     public:
       
-      typedef typename SourceImage::ReadableRows::RowIterator::ElementIterator Iterator;
+      typedef const typename SourceImage::Pixel* Iterator;
       typedef typename PixelTraits<typename SourceImage::Pixel>::Arithmetic Arithmetic;
       typedef typename PixelTraits<typename DestinationImage::Pixel>::Arithmetic Result;
       
@@ -188,7 +319,7 @@ namespace gip {
     class ApplyKernel<GrayAlphaPixel<COMPONENT> > {
     public:
       
-      typedef typename SourceImage::ReadableRows::RowIterator::ElementIterator Iterator;
+      typedef const typename SourceImage::Pixel* Iterator;
       typedef typename PixelTraits<typename SourceImage::Pixel>::Arithmetic Arithmetic;
       typedef GrayAlphaPixel<typename PixelTraits<typename DestinationImage::Pixel>::Arithmetic> Result;
 
@@ -230,7 +361,7 @@ namespace gip {
     class ApplyKernel<RGBPixel<COMPONENT> > {
     public:
       
-      typedef typename SourceImage::ReadableRows::RowIterator::ElementIterator Iterator;
+      typedef const typename SourceImage::Pixel* Iterator;
       typedef typename PixelTraits<typename SourceImage::Pixel>::Arithmetic Arithmetic;
       typedef RGBPixel<typename PixelTraits<typename DestinationImage::Pixel>::Arithmetic> Result;
       
@@ -282,7 +413,7 @@ namespace gip {
     class ApplyKernel<RGBAPixel<COMPONENT> > {
     public:
       
-      typedef typename SourceImage::ReadableRows::RowIterator::ElementIterator Iterator;
+      typedef const typename SourceImage::Pixel* Iterator;
       typedef typename PixelTraits<typename SourceImage::Pixel>::Arithmetic Arithmetic;
       typedef RGBAPixel<typename PixelTraits<typename DestinationImage::Pixel>::Arithmetic> Result;
       
@@ -340,52 +471,67 @@ namespace gip {
       }
     };
     
+  private:
+
+    /** Applies the kernel to the specified region of the destination image. */
+    template<class DESTINATION, class SOURCE>
+    void apply(DESTINATION* destination, const SOURCE* source, const Region& region) const {
+      applyNeighborhood(*destination, *source, region, border, constant, ApplyKernel<typename SOURCE::Pixel>());
+    }
+
+    /** Applies the kernel using Convolution3x3Engine. */
+    template<class PIXEL>
+    void applyEngine(ArrayImage<PIXEL>* destination, const ArrayImage<PIXEL>* source, const Region& region) const {
+      const Region calculate = Border::getRegion(region, source->getDimension(), HALO, border);
+      if (!calculate.isProper()) {
+        return;
+      }
+      const Convolution3x3Engine::Coefficients coefficients = Convolution3x3Engine::Coefficients::make<KERNEL>(); // divisor validated by constructor
+      const unsigned int firstColumn = calculate.getOffset().getColumn();
+      const MemorySize destPitch = destination->getPitch();
+      PIXEL* dest = destination->getElements() + calculate.getOffset().getRow() * destPitch + firstColumn; // detach before source is read
+      BorderRows<ArrayImage<PIXEL> > rows(*source, firstColumn, calculate.getEndColumn(), HALO, border, constant);
+      for (unsigned int row = calculate.getOffset().getRow(); row < calculate.getEndRow(); ++row, dest += destPitch) {
+        rows.seek(row);
+        Convolution3x3Engine::convolve(
+          dest,
+          rows.getRow(-1),
+          rows.getRow(0),
+          rows.getRow(1),
+          calculate.getDimension().getWidth(),
+          coefficients
+        );
+      }
+    }
+
+    void apply(Gray8Image* destination, const Gray8Image* source, const Region& region) const {
+      applyEngine(destination, source, region);
+    }
+
+    void apply(ColorImage* destination, const ColorImage* source, const Region& region) const {
+      applyEngine(destination, source, region);
+    }
+  public:
+
+    /** The number of source rows above and below a row required to calculate the row. */
+    static constexpr unsigned int HALO = 1;
+
     /**
-      Calculate transformation.
+      Calculates the transformation for the specified region of the destination
+      image. The border pixels of the image are not modified for Border::NONE.
     */
-    void operator()() noexcept {
-      typename SourceImage::ReadableRows rowLookup = Transformation<DEST, SRC>::source->getRows();
-      typename SourceImage::ReadableRows::RowIterator endRow = rowLookup.getEnd();
-      typename SourceImage::ReadableRows::RowIterator previousRow = rowLookup.getFirst();
-      typename SourceImage::ReadableRows::RowIterator currentRow = previousRow + 1;
-      typename SourceImage::ReadableRows::RowIterator nextRow = currentRow + 1;
-      
-      typename DestinationImage::Rows::RowIterator destRow = Transformation<DEST, SRC>::destination->getRows().getFirst();
-      
-      // handle first row
-      ++destRow;
-      
-      while (nextRow < endRow) {
-        typename SourceImage::ReadableRows::RowIterator::ElementIterator previousRowColumn = previousRow.getFirst();
-        typename SourceImage::ReadableRows::RowIterator::ElementIterator currentRowColumn = currentRow.getFirst();
-        typename SourceImage::ReadableRows::RowIterator::ElementIterator nextRowColumn = nextRow.getFirst();
-        typename SourceImage::ReadableRows::RowIterator::ElementIterator endCurrentRowColumn = currentRow.getEnd() - 1;
-        typename DestinationImage::Rows::RowIterator::ElementIterator dest = destRow.getFirst();
-        
-        // first column
-        ++previousRowColumn;
-        ++currentRowColumn;
-        ++nextRowColumn;
-        ++dest;
-        
-        ApplyKernel<typename SourceImage::Pixel> applyKernel;
-        while (currentRowColumn < endCurrentRowColumn) {
-          *dest = applyKernel(previousRowColumn, currentRowColumn, nextRowColumn);
-          ++dest;
-          ++previousRowColumn;
-          ++currentRowColumn;
-          ++nextRowColumn;
-        }
-        
-        // last column
-        
-        ++destRow;
-        previousRow = currentRow;
-        currentRow = nextRow;
-        ++nextRow;
-      }
+    void operator()(const Region& region) const {
+      bassert(region.isWithin(Transformation<DEST, SRC>::destination->getDimension()), ImageException(this));
+      apply(Transformation<DEST, SRC>::destination, Transformation<DEST, SRC>::source, region);
+    }
 
-      // handle last row
+    /**
+      Calculate transformation.
+    */
+    void operator()() const {
+      static Metrics::Counter counter("Convolution3x3");
+      Metrics::Scope scope(counter, *Transformation<DEST, SRC>::destination, *Transformation<DEST, SRC>::source);
+      (*this)(Region(Point2D(0, 0), Transformation<DEST, SRC>::destination->getDimension()));
     }
   };
 
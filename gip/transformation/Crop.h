@@ -49,6 +49,8 @@ namespace gip {
 
   template<class DEST, class SRC>
   void Crop<DEST, SRC>::operator()() noexcept {
+    static Metrics::Counter counter("Crop");
+    Metrics::Scope scope(counter, *destination, *source);
     Dimension min(
       minimum(destination->getDimension().getWidth(), source->getDimension().getWidth()),
       minimum(destination->getDimension().getHeight(), source->getDimension().getHeight())
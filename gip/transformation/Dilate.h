@@ -14,6 +14,7 @@
 #pragma once
 
 #include <gip/transformation/Transformation.h>
+#include <gip/Border.h>
 #include <gip/ArrayImage.h>
 #include <gip/analysis/Histogram.h>
 #include <gip/ImageException.h>
@@ -29,17 +30,26 @@ namespace gip {
     @version 1.0
   */
 
-  template<class KERNEL>
-  class Dilate : public Transformation<GrayImage, GrayImage> {
+  template<class KERNEL, class IMAGE = GrayImage>
+  class Dilate : public Transformation<IMAGE, IMAGE> {
   public:
 
-    typedef GrayImage::Pixel Pixel;
+    typedef typename Transformation<IMAGE, IMAGE>::DestinationImage DestinationImage;
+    typedef typename Transformation<IMAGE, IMAGE>::SourceImage SourceImage;
+    typedef typename IMAGE::Pixel Pixel;
+  private:
+
+    /** The border mode. */
+    Border::Mode border = Border::REPLICATE;
+    /** The value of the pixels outside the source image for Border::CONSTANT. */
+    Pixel constant;
+  public:
 
     template<class PIXEL>
     class ApplyKernel {
     public:
       
-      typedef typename SourceImage::ReadableRows::RowIterator::ElementIterator Iterator;
+      typedef const Pixel* Iterator;
       
       inline Pixel operator()(Iterator previous, Iterator current, Iterator next) const noexcept {
         Pixel maximum;
@@ -101,56 +111,45 @@ namespace gip {
 
       @param destination The destination image.
       @param source The source image.
+      @param border The border mode. The default is Border::REPLICATE.
+      @param constant The value of the pixels outside the source image for Border::CONSTANT.
     */
-    Dilate(DestinationImage* destination, const SourceImage* source) 
-      : Transformation<DestinationImage, SourceImage>(destination, source) {
+    Dilate(
+      DestinationImage* destination,
+      const SourceImage* source,
+      Border::Mode _border = Border::REPLICATE,
+      const Pixel& _constant = Pixel())
+      : Transformation<DestinationImage, SourceImage>(destination, source), border(_border), constant(_constant) {
       
       bassert(destination->getDimension() == source->getDimension(), ImageException(this));
     }
 
-    void operator()() const noexcept {
-      typename SourceImage::ReadableRows rowLookup = source->getRows();
-      typename SourceImage::ReadableRows::RowIterator endRow = rowLookup.getEnd();
-      typename SourceImage::ReadableRows::RowIterator previousRow = rowLookup.getFirst();
-      typename SourceImage::ReadableRows::RowIterator currentRow = previousRow + 1;
-      typename SourceImage::ReadableRows::RowIterator nextRow = currentRow + 1;
-      
-      typename DestinationImage::Rows::RowIterator destRow = destination->getRows().getFirst();
-      
-      // handle first row
-      ++destRow;
+    /** The number of source rows above and below a row required to calculate the row. */
+    static constexpr unsigned int HALO = 1;
 
-      while (nextRow < endRow) {
-        typename SourceImage::ReadableRows::RowIterator::ElementIterator previousRowColumn = previousRow.getFirst();
-        typename SourceImage::ReadableRows::RowIterator::ElementIterator currentRowColumn = currentRow.getFirst();
-        typename SourceImage::ReadableRows::RowIterator::ElementIterator nextRowColumn = nextRow.getFirst();
-        typename SourceImage::ReadableRows::RowIterator::ElementIterator endCurrentRowColumn = currentRow.getEnd() - 1;
-        typename DestinationImage::Rows::RowIterator::ElementIterator dest = destRow.getFirst();
-        
-        // first column
-        ++previousRowColumn;
-        ++currentRowColumn;
-        ++nextRowColumn;
-        ++dest;
-        
-        ApplyKernel<typename SourceImage::Pixel> applyKernel;
-        while (currentRowColumn < endCurrentRowColumn) {
-          *dest = applyKernel(previousRowColumn, currentRowColumn, nextRowColumn);
-          ++dest;
-          ++previousRowColumn;
-          ++currentRowColumn;
-          ++nextRowColumn;
-        }
-        
-        // last column
-        
-        ++destRow;
-        previousRow = currentRow;
-        currentRow = nextRow;
-        ++nextRow;
-      }
+    /**
+      Calculates the transformation for the specified region of the destination
+      image. The border pixels of the image are not modified for Border::NONE.
+    */
+    void operator()(const Region& region) const {
+      bassert(region.isWithin(Transformation<IMAGE, IMAGE>::destination->getDimension()), ImageException(this));
+      applyNeighborhood(
+        *Transformation<IMAGE, IMAGE>::destination,
+        *Transformation<IMAGE, IMAGE>::source,
+        region,
+        border,
+        constant,
+        ApplyKernel<Pixel>()
+      );
+    }
 
-      // handle last row
+    /**
+      Calculate transformation.
+    */
+    void operator()() const {
+      static Metrics::Counter counter("Dilate");
+      Metrics::Scope scope(counter, *Transformation<IMAGE, IMAGE>::destination, *Transformation<IMAGE, IMAGE>::source);
+      (*this)(Region(Point2D(0, 0), Transformation<IMAGE, IMAGE>::destination->getDimension()));
     }
     
   };
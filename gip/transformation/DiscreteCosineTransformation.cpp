@@ -57,6 +57,8 @@ DiscreteCosineTransformation::DiscreteCosineTransformation(DestinationImage* des
 }
 
 void DiscreteCosineTransformation::operator()() noexcept {
+  static Metrics::Counter counter("DiscreteCosineTransformation");
+  Metrics::Scope scope(counter, *destination, *source);
   unsigned int rows = source->getHeight();
   unsigned int columns = source->getWidth();
 
@@ -109,17 +111,19 @@ void DiscreteCosineTransformation::operator()() noexcept {
 
   // Discrete cosine transformation column by column
   {
+    const MemorySize pitch = destination->getPitch();
+    const MemorySize size = pitch * rows;
     Pixel* column = destination->getElements();
     const Pixel* endColumn = column + columns;
-    const Pixel* endPoint = column + columns * rows;
+    const Pixel* endPoint = column + size;
     for (; column < endColumn; ++column) { // traverse all columns
       unsigned int halfBlockSize = 1;
       for (unsigned int i = rows/2; i > 0; i >>= 1, halfBlockSize <<= 1) {
-        const unsigned int halfStep = halfBlockSize * columns;
-        const unsigned int fullStep = 2 * halfBlockSize * columns;
+        const MemorySize halfStep = halfBlockSize * pitch;
+        const MemorySize fullStep = 2 * halfBlockSize * pitch;
         const double delta = constant::PI/halfBlockSize;
         const Pixel* endOffset = column + halfStep;
-        for (Pixel* offset = column; offset < endOffset; offset += columns) {
+        for (Pixel* offset = column; offset < endOffset; offset += pitch) {
           Pixel* evenBlockPoint = offset;
           Pixel* oddBlockPoint = offset + halfStep;
           double u = constant::PI/halfBlockSize * 0.25;
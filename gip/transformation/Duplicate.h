@@ -53,16 +53,18 @@ namespace gip {
     /**
       Duplicates the contents of the source image to the destination image.
     */
-    void operator()() noexcept;
+    void operator()();
   };
 
   Duplicate::Duplicate(DestinationImage* destination, const SourceImage* source) noexcept
     : Transformation<DestinationImage, SourceImage>(destination, source) {
   }
 
-  void Duplicate::operator()() noexcept {
+  void Duplicate::operator()() {
+    static Metrics::Counter counter("Duplicate");
+    Metrics::Scope scope(counter, *destination, *source);
     Same<ColorPixel> operation;
-    fillWithUnary(*destination, *source, operation);
+    parallelFillWithUnary(*destination, *source, operation);
   }
 
 }; // end of gip namespace
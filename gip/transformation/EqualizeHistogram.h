@@ -16,6 +16,7 @@
 #include <gip/transformation/Transformation.h>
 #include <gip/ArrayImage.h>
 #include <gip/analysis/Histogram.h>
+#include <gip/LookupTable.h>
 #include <gip/ImageException.h>
 
 namespace gip {
@@ -64,39 +65,82 @@ namespace gip {
       bassert(destination->getDimension() == source->getDimension(), ImageException(this));
     }
 
-    void operator()() const noexcept {
+    void operator()() const {
+      static Metrics::Counter counter("EqualizeHistogram");
+      Metrics::Scope scope(counter, *destination, *source);
       GrayHistogram grayHistogram;
-      forEach(*source, grayHistogram);
-      Array<unsigned int> histogram = grayHistogram.getHistogram();
+      reduce(*source, grayHistogram);
+      Array<MemorySize> histogram = grayHistogram.getHistogram();
       
-      const unsigned int* src = histogram.getElements();
-      const unsigned int* end = src + histogram.getSize();
+      const MemorySize* src = histogram.getElements();
+      const MemorySize* end = src + histogram.getSize();
 
       Allocator<Pixel> lookup(static_cast<Arithmetic>(PixelTraits<Pixel>::MAXIMUM) + 1);
       Pixel* dest = lookup.getElements();
 
-      unsigned int numberOfPixels = source->getDimension().getSize();
-      unsigned long sum = 0;
-      if (static_cast<unsigned long long>(numberOfPixels) * static_cast<Arithmetic>(PixelTraits<Pixel>::MAXIMUM) <= PrimitiveTraits<unsigned long>::MAXIMUM) {
-        while (src < end) {
-          sum += *src++;
-          *dest++ = (2 * sum * static_cast<Arithmetic>(PixelTraits<Pixel>::MAXIMUM) + numberOfPixels)/(2 * numberOfPixels);
-        }
-      } else {
-        while (src < end) {
-          sum += *src++;
-          *dest++ = (2 *  static_cast<unsigned long long>(sum) * static_cast<Arithmetic>(PixelTraits<Pixel>::MAXIMUM) + numberOfPixels)/(2 * numberOfPixels);
-        }
+      // 2 * numberOfPixels * MAXIMUM cannot overflow for any image which fits in memory
+      const unsigned long long numberOfPixels = source->getNumberOfPixels();
+      unsigned long long sum = 0;
+      while (src < end) {
+        sum += *src++;
+        *dest++ = (2 * sum * static_cast<Arithmetic>(PixelTraits<Pixel>::MAXIMUM) + numberOfPixels)/(2 * numberOfPixels);
       }
 
       MapPixel mapPixel(lookup);
-      fillWithUnary(*destination, *source, mapPixel);
+      parallelFillWithUnary(*destination, *source, mapPixel);
     }
     
   };
 
 
 
+  /**
+    @short Histogram equalization
+    @ingroup transformations
+    @version 1.0
+  */
+
+  template<>
+  class EqualizeHistogram<Gray8Image, Gray8Image> : public Transformation<Gray8Image, Gray8Image> {
+  public:
+
+    typedef SourceImage::Pixel Pixel;
+
+    /**
+      Initializes the transformation.
+
+      @param destination The destination image.
+      @param source The source image.
+    */
+    EqualizeHistogram(DestinationImage* destination, const SourceImage* source)
+      : Transformation<DestinationImage, SourceImage>(destination, source) {
+
+      bassert(destination->getDimension() == source->getDimension(), ImageException(this));
+    }
+
+    void operator()() const {
+      static Metrics::Counter counter("EqualizeHistogram");
+      Metrics::Scope scope(counter, *destination, *source);
+      Histogram<Pixel> grayHistogram;
+      reduce(*source, grayHistogram);
+      const MemorySize* src = grayHistogram.getHistogram().getElements();
+
+      uint8 lookup[256];
+      const unsigned long long numberOfPixels = source->getNumberOfPixels();
+      if (numberOfPixels == 0) {
+        return;
+      }
+      unsigned long long sum = 0;
+      for (unsigned int i = 0; i < 256; ++i) {
+        sum += src[i];
+        lookup[i] = static_cast<uint8>((2 * sum * 0xff + numberOfPixels)/(2 * numberOfPixels));
+      }
+
+      applyLookup(*destination, *source, lookup);
+    }
+
+  };
+
   template<>
   class EqualizeHistogram<ColorImage, ColorImage> : public Transformation<ColorImage, ColorImage> {
   private:
@@ -105,22 +149,16 @@ namespace gip {
     typedef PixelTraits<Pixel>::Component Component;
     typedef PixelTraits<Pixel>::Arithmetic Arithmetic;
 
-    static void fillLookup(const Array<unsigned int>& histogram, Allocator<Arithmetic>& lookup, unsigned int numberOfPixels) noexcept {
-      const unsigned int* src = histogram.getElements();
-      const unsigned int* end = src + histogram.getSize();
+    static void fillLookup(const Array<MemorySize>& histogram, Allocator<Arithmetic>& lookup, unsigned long long numberOfPixels) noexcept {
+      const MemorySize* src = histogram.getElements();
+      const MemorySize* end = src + histogram.getSize();
       Arithmetic* dest = lookup.getElements();
 
-      unsigned long sum = 0;
-      if (2 * static_cast<unsigned long long>(numberOfPixels) * static_cast<Arithmetic>(PixelTraits<Pixel>::MAXIMUM) + numberOfPixels <= PrimitiveTraits<unsigned long>::MAXIMUM) {
-        while (src < end) {
-          sum += *src++;
-          *dest++ = ((2 * sum * 3 * static_cast<Arithmetic>(PixelTraits<Pixel>::MAXIMUM)) + numberOfPixels)/(2 * numberOfPixels);
-        }
-      } else {
-        while (src < end) {
-          sum += *src++;
-          *dest++ = (2 * static_cast<unsigned long long>(sum) * 3 * static_cast<Arithmetic>(PixelTraits<Pixel>::MAXIMUM) + numberOfPixels)/(2 * numberOfPixels);
-        }
+      // 2 * numberOfPixels * 3 * MAXIMUM cannot overflow for any image which fits in memory
+      unsigned long long sum = 0;
+      while (src < end) {
+        sum += *src++;
+        *dest++ = (2 * sum * 3 * static_cast<Arithmetic>(PixelTraits<Pixel>::MAXIMUM) + numberOfPixels)/(2 * numberOfPixels);
       }
     }
   public:
@@ -130,21 +168,38 @@ namespace gip {
 
       typedef PixelTraits<ColorPixel>::Arithmetic Arithmetic;
       /** The histogram. */
-      Array<unsigned int> histogram;
+      Array<MemorySize> histogram;
       /** The histogram elements. */
-      unsigned int* elements;
+      MemorySize* elements;
     public:
 
       inline Histogram() 
         : histogram(3 * PixelTraits<ColorPixel>::MAXIMUM + 1, 0), elements(histogram.getElements()) {
-        fill<unsigned int>(histogram.getElements(), histogram.getSize(), 0);
+        fill<MemorySize>(histogram.getElements(), histogram.getSize(), 0);
+      }
+
+      inline Histogram(const Histogram& copy)
+        : histogram(copy.histogram), elements(histogram.getElements()) { // detach from copy
       }
 
+      Histogram& operator=(const Histogram&) = delete;
+
       inline void operator()(const ColorPixel& value) noexcept {
         ++elements[static_cast<Arithmetic>(value.red) + static_cast<Arithmetic>(value.green) + static_cast<Arithmetic>(value.blue)];
       }
 
-      inline Array<unsigned int> getHistogram() const noexcept {
+      inline Histogram clone() const {
+        return Histogram();
+      }
+
+      void merge(const Histogram& partial) noexcept {
+        const MemorySize* src = partial.histogram.getElements();
+        for (MemorySize i = 0; i < histogram.getSize(); ++i) {
+          elements[i] += src[i];
+        }
+      }
+
+      inline Array<MemorySize> getHistogram() const noexcept {
         return histogram;
       }
     };
@@ -170,6 +225,20 @@ namespace gip {
         return maxIntensity - 1; // return value > 0
       }
 
+      inline FindMaximumComponent clone() const noexcept {
+        FindMaximumComponent result(*this);
+        result.max = 0;
+        result.maxIntensity = 1;
+        return result;
+      }
+
+      inline void merge(const FindMaximumComponent& partial) noexcept {
+        if (partial.max * maxIntensity > max * partial.maxIntensity) { // same order as operator()
+          max = partial.max;
+          maxIntensity = partial.maxIntensity;
+        }
+      }
+
       inline void operator()(const Pixel& value) noexcept {
         Arithmetic red = value.red;
         Arithmetic green = value.green;
@@ -224,22 +293,24 @@ namespace gip {
       bassert(destination->getDimension() == source->getDimension(), ImageException(this));
     }
 
-    void operator()() const noexcept {
+    void operator()() const {
+      static Metrics::Counter counter("EqualizeHistogram");
+      Metrics::Scope scope(counter, *destination, *source);
       Histogram intensityHistogram; // intensity = red + green + blue <= 3 * 255
-      forEach(*source, intensityHistogram);
-      Array<unsigned int> histogram = intensityHistogram.getHistogram();
-      if (histogram[0] == source->getDimension().getSize()) { // all black image - maximum intensity = 0
-        fill(destination->getElements(), destination->getDimension().getSize(), makeColorPixel(0, 0, 0)); // fill with black
+      reduce(*source, intensityHistogram);
+      Array<MemorySize> histogram = intensityHistogram.getHistogram();
+      if (histogram[0] == source->getNumberOfPixels()) { // all black image - maximum intensity = 0
+        fill(destination->getElements(), static_cast<MemorySize>(destination->getPitch()) * destination->getHeight(), makeColorPixel(0, 0, 0)); // fill with black (including padding)
         return;
       }
       Allocator<Arithmetic> lookup(3 * static_cast<Arithmetic>(PixelTraits<Pixel>::MAXIMUM) + 1);
-      fillLookup(histogram, lookup, source->getDimension().getSize());
+      fillLookup(histogram, lookup, source->getNumberOfPixels());
       // TAG: need alternative with clamp
       FindMaximumComponent findMaximumComponent(lookup);
-      forEach(*source, findMaximumComponent);
+      reduce(*source, findMaximumComponent);
       transform(lookup.getElements(), lookup.getSize(), bind2Second(Multiply<Arithmetic>(), 2 * static_cast<Arithmetic>(PixelTraits<Pixel>::MAXIMUM) * findMaximumComponent.getMaximumIntensity()));
       MapPixel mapPixel(lookup, findMaximumComponent.getMaximum());
-      fillWithUnary(*destination, *source, mapPixel);
+      parallelFillWithUnary(*destination, *source, mapPixel);
     }
 
   };
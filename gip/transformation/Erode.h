@@ -14,6 +14,7 @@
 #pragma once
 
 #include <gip/transformation/Transformation.h>
+#include <gip/Border.h>
 #include <gip/ArrayImage.h>
 #include <gip/analysis/Histogram.h>
 #include <gip/ImageException.h>
@@ -36,44 +37,19 @@ namespace gip {
     typedef typename Transformation<DEST, SRC>::DestinationImage DestinationImage;
     typedef typename Transformation<DEST, SRC>::SourceImage SourceImage;
 
-    class TopLeftKernel : public KERNEL {
-    public:
-      enum {M00 = false, M01 = false, M02 = false, M10 = false, M20 = false};
-    };
-
-    class TopRightKernel : public KERNEL {
-    public:
-      enum {M00 = false, M01 = false, M02 = false, M12 = false, M22 = false};
-    };
-
-    class TopKernel : public KERNEL {
-    public:
-      enum {M00 = false, M01 = false, M02 = false};
-    };
-
-    class BottomKernel : public KERNEL {
-    public:
-      enum {M20 = false, M21 = false, M22 = false};
-    };
-
-    class LeftKernel : public KERNEL {
-    public:
-      enum {M00 = false, M10 = false, M20 = false};
-    };
-
-    class RightKernel : public KERNEL {
-    public:
-      enum {M02 = false, M12 = false, M22 = false};
-    };
+    /** The border mode. */
+    Border::Mode border = Border::REPLICATE;
+    /** The value of the pixels outside the source image for Border::CONSTANT. */
+    typename SourceImage::Pixel constant;
   public:
     
-    typedef GrayImage::Pixel Pixel;
+    typedef typename DestinationImage::Pixel Pixel;
     
     template<class PIXEL>
     class ApplyKernel {
     public:
       
-      typedef typename SourceImage::ReadableRows::RowIterator::ElementIterator Iterator;
+      typedef const typename SourceImage::Pixel* Iterator;
       
       inline Pixel operator()(Iterator previous, Iterator current, Iterator next) const noexcept {
         Pixel minimum;
@@ -135,56 +111,45 @@ namespace gip {
 
       @param destination The destination image.
       @param source The source image.
+      @param border The border mode. The default is Border::REPLICATE.
+      @param constant The value of the pixels outside the source image for Border::CONSTANT.
     */
-    Erode3x3(DestinationImage* destination, const SourceImage* source) 
-      : Transformation<DestinationImage, SourceImage>(destination, source) {
+    Erode3x3(
+      DestinationImage* destination,
+      const SourceImage* source,
+      Border::Mode _border = Border::REPLICATE,
+      const typename SourceImage::Pixel& _constant = typename SourceImage::Pixel())
+      : Transformation<DestinationImage, SourceImage>(destination, source), border(_border), constant(_constant) {
       
       bassert(destination->getDimension() == source->getDimension(), ImageException(this));
     }
 
-    void operator()() const noexcept {
-      typename SourceImage::ReadableRows rowLookup = Transformation<DEST, SRC>::source->getRows();
-      typename SourceImage::ReadableRows::RowIterator endRow = rowLookup.getEnd();
-      typename SourceImage::ReadableRows::RowIterator previousRow = rowLookup.getFirst();
-      typename SourceImage::ReadableRows::RowIterator currentRow = previousRow + 1;
-      typename SourceImage::ReadableRows::RowIterator nextRow = currentRow + 1;
-      
-      typename DestinationImage::Rows::RowIterator destRow = Transformation<DEST, SRC>::destination->getRows().getFirst();
-      
-      // handle first row
-      ++destRow;
-      
-      while (nextRow < endRow) {
-        typename SourceImage::ReadableRows::RowIterator::ElementIterator previousRowColumn = previousRow.getFirst();
-        typename SourceImage::ReadableRows::RowIterator::ElementIterator currentRowColumn = currentRow.getFirst();
-        typename SourceImage::ReadableRows::RowIterator::ElementIterator nextRowColumn = nextRow.getFirst();
-        typename SourceImage::ReadableRows::RowIterator::ElementIterator endCurrentRowColumn = currentRow.getEnd() - 1;
-        typename DestinationImage::Rows::RowIterator::ElementIterator dest = destRow.getFirst();
-        
-        // first column
-        ++previousRowColumn;
-        ++currentRowColumn;
-        ++nextRowColumn;
-        ++dest;
-        
-        ApplyKernel<typename SourceImage::Pixel> applyKernel;
-        while (currentRowColumn < endCurrentRowColumn) {
-          *dest = applyKernel(previousRowColumn, currentRowColumn, nextRowColumn);
-          ++dest;
-          ++previousRowColumn;
-          ++currentRowColumn;
-          ++nextRowColumn;
-        }
-        
-        // last column
-        
-        ++destRow;
-        previousRow = currentRow;
-        currentRow = nextRow;
-        ++nextRow;
-      }
+    /** The number of source rows above and below a row required to calculate the row. */
+    static constexpr unsigned int HALO = 1;
+
+    /**
+      Calculates the transformation for the specified region of the destination
+      image. The border pixels of the image are not modified for Border::NONE.
+    */
+    void operator()(const Region& region) const {
+      bassert(region.isWithin(Transformation<DEST, SRC>::destination->getDimension()), ImageException(this));
+      applyNeighborhood(
+        *Transformation<DEST, SRC>::destination,
+        *Transformation<DEST, SRC>::source,
+        region,
+        border,
+        constant,
+        ApplyKernel<typename SourceImage::Pixel>()
+      );
+    }
 
-      // handle last row
+    /**
+      Calculate transformation.
+    */
+    void operator()() const {
+      static Metrics::Counter counter("Erode3x3");
+      Metrics::Scope scope(counter, *Transformation<DEST, SRC>::destination, *Transformation<DEST, SRC>::source);
+      (*this)(Region(Point2D(0, 0), Transformation<DEST, SRC>::destination->getDimension()));
     }
     
   };
@@ -54,6 +54,8 @@ namespace gip {
 
   template<class DEST>
   void Flip<DEST>::operator()() noexcept {
+    static Metrics::Counter counter("Flip");
+    Metrics::Scope scope(counter, *UnaryTransformation<DEST>::destination);
     typename DestinationImage::Rows rowLookup = UnaryTransformation<DEST>::destination->getRows();
 
     typename DestinationImage::Rows::RowIterator topRow = rowLookup.getFirst();
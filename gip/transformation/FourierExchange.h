@@ -58,6 +58,8 @@ namespace gip {
 
   template<class DEST>
   void FourierExchange<DEST>::operator()() noexcept {
+    static Metrics::Counter counter("FourierExchange");
+    Metrics::Scope scope(counter, *UnaryTransformation<DEST>::destination);
 
     unsigned int halfWidth = UnaryTransformation<DEST>::destination->getDimension().getWidth()/2;
     unsigned int halfHeight = UnaryTransformation<DEST>::destination->getDimension().getHeight()/2;
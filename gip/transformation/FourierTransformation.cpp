@@ -57,6 +57,8 @@ FourierTransformation::FourierTransformation(DestinationImage* destination, cons
 }
 
 void FourierTransformation::operator()() noexcept {
+  static Metrics::Counter counter("FourierTransformation");
+  Metrics::Scope scope(counter, *destination, *source);
 
   unsigned int rows = source->getHeight();
   unsigned int columns = source->getWidth();
@@ -112,19 +114,21 @@ void FourierTransformation::operator()() noexcept {
 
   // Fourier transformation column by column
   {
+    const MemorySize pitch = destination->getPitch();
+    const MemorySize size = pitch * rows;
     Complex<float>* column = destination->getElements();
     const Complex<float>* endColumn = column + columns;
-    const Complex<float>* endPoint = column + columns * rows;
+    const Complex<float>* endPoint = column + size;
     for (; column < endColumn; ++column) {
       double delta = forward ? constant::PI : -constant::PI;
-      for (unsigned int halfStep = columns; halfStep < columns * rows; halfStep <<= 1) {
-        unsigned int fullStep = halfStep << 1;
+      for (MemorySize halfStep = pitch; halfStep < size; halfStep <<= 1) {
+        const MemorySize fullStep = halfStep << 1;
         Complex<float> u(1, 0); // (Math::cos(0); Math::sin(0))
         Complex<float> w(Math::cos(delta), -Math::sin(delta));
         delta *= 0.5;
         Complex<float>* offset = column;
         const Complex<float>* endOffset = offset + halfStep;
-        for (; offset < endOffset; offset += columns) {
+        for (; offset < endOffset; offset += pitch) {
           Complex<float>* evenBlockPoint = offset;
           Complex<float>* oddBlockPoint = offset + halfStep;
           while (evenBlockPoint < endPoint) {
@@ -0,0 +1,271 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#include <gip/transformation/GaussianBlur.h>
+#include <gip/CPUDispatch.h>
+#include <base/math/Math.h>
+
+#if defined(_COM_AZURE_DEV__GIP__SIMD_X86)
+#  include <immintrin.h>
+#endif
+
+namespace gip {
+
+  namespace {
+
+    /*
+      One step of the recursion for a row of samples:
+      dest = gain * src + feedback[0] * first + feedback[1] * second + feedback[2] * third.
+      dest may be src. All implementations evaluate the same expression in the
+      same order and produce identical results.
+    */
+
+    typedef void (*Recurse)(
+      float*, const float*, const float*, const float*, const float*, MemorySize, const GaussianBlurEngine::Coefficients&);
+
+    void recurseScalar(
+      float* dest,
+      const float* src,
+      const float* first,
+      const float* second,
+      const float* third,
+      MemorySize size,
+      const GaussianBlurEngine::Coefficients& coefficients) noexcept {
+      const float gain = coefficients.gain;
+      const float b1 = coefficients.feedback[0];
+      const float b2 = coefficients.feedback[1];
+      const float b3 = coefficients.feedback[2];
+      for (MemorySize i = 0; i < size; ++i) {
+        dest[i] = gain * src[i] + b1 * first[i] + b2 * second[i] + b3 * third[i];
+      }
+    }
+
+#if defined(_COM_AZURE_DEV__GIP__SIMD_X86)
+
+    _COM_AZURE_DEV__GIP__TARGET("sse2")
+    void recurseSSE2(
+      float* dest,
+      const float* src,
+      const float* first,
+      const float* second,
+      const float* third,
+      MemorySize size,
+      const GaussianBlurEngine::Coefficients& coefficients) noexcept {
+      const __m128 b0 = _mm_set1_ps(coefficients.gain);
+      const __m128 b1 = _mm_set1_ps(coefficients.feedback[0]);
+      const __m128 b2 = _mm_set1_ps(coefficients.feedback[1]);
+      const __m128 b3 = _mm_set1_ps(coefficients.feedback[2]);
+      MemorySize i = 0;
+      for (; (size - i) >= 4; i += 4) {
+        __m128 sum = _mm_mul_ps(b0, _mm_loadu_ps(src + i));
+        sum = _mm_add_ps(sum, _mm_mul_ps(b1, _mm_loadu_ps(first + i)));
+        sum = _mm_add_ps(sum, _mm_mul_ps(b2, _mm_loadu_ps(second + i)));
+        sum = _mm_add_ps(sum, _mm_mul_ps(b3, _mm_loadu_ps(third + i)));
+        _mm_storeu_ps(dest + i, sum);
+      }
+      recurseScalar(dest + i, src + i, first + i, second + i, third + i, size - i, coefficients);
+    }
+
+    _COM_AZURE_DEV__GIP__TARGET("avx2")
+    void recurseAVX2(
+      float* dest,
+      const float* src,
+      const float* first,
+      const float* second,
+      const float* third,
+      MemorySize size,
+      const GaussianBlurEngine::Coefficients& coefficients) noexcept {
+      const __m256 b0 = _mm256_set1_ps(coefficients.gain);
+      const __m256 b1 = _mm256_set1_ps(coefficients.feedback[0]);
+      const __m256 b2 = _mm256_set1_ps(coefficients.feedback[1]);
+      const __m256 b3 = _mm256_set1_ps(coefficients.feedback[2]);
+      MemorySize i = 0;
+      for (; (size - i) >= 8; i += 8) {
+        __m256 sum = _mm256_mul_ps(b0, _mm256_loadu_ps(src + i));
+        sum = _mm256_add_ps(sum, _mm256_mul_ps(b1, _mm256_loadu_ps(first + i)));
+        sum = _mm256_add_ps(sum, _mm256_mul_ps(b2, _mm256_loadu_ps(second + i)));
+        sum = _mm256_add_ps(sum, _mm256_mul_ps(b3, _mm256_loadu_ps(third + i)));
+        _mm256_storeu_ps(dest + i, sum);
+      }
+      // the tail stays in AVX code to avoid the transition penalty of SSE code after AVX code
+      const float gain = coefficients.gain;
+      const float f1 = coefficients.feedback[0];
+      const float f2 = coefficients.feedback[1];
+      const float f3 = coefficients.feedback[2];
+      for (; i < size; ++i) {
+        dest[i] = gain * src[i] + f1 * first[i] + f2 * second[i] + f3 * third[i];
+      }
+    }
+#endif
+
+    CPUDispatch::Kernel<Recurse> recurse("gaussianBlurRow", recurseScalar);
+
+    /** Registers the SIMD implementations. */
+    class Registration {
+    public:
+
+      Registration() noexcept {
+#if defined(_COM_AZURE_DEV__GIP__SIMD_X86)
+        recurse.set(CPUDispatch::LEVEL_SSE2, recurseSSE2);
+        recurse.set(CPUDispatch::LEVEL_AVX2, recurseAVX2);
+#endif
+      }
+    };
+
+    Registration registration;
+  }
+
+  GaussianBlurEngine::Coefficients::Coefficients(double deviation) noexcept {
+    // Young and van Vliet, Recursive implementation of the Gaussian filter, 1995
+    const double q = (deviation >= 2.5) ?
+      (0.98711 * deviation - 0.96330) : (3.97156 - 4.14554 * Math::sqrt(1 - 0.26891 * deviation));
+    const double b0 = 1.57825 + 2.44413 * q + 1.4281 * q * q + 0.422205 * q * q * q;
+    const double a1 = (2.44413 * q + 2.85619 * q * q + 1.26661 * q * q * q)/b0;
+    const double a2 = -(1.4281 * q * q + 1.26661 * q * q * q)/b0;
+    const double a3 = (0.422205 * q * q * q)/b0;
+    const double b = 1 - (a1 + a2 + a3);
+    gain = static_cast<float>(b);
+    feedback[0] = static_cast<float>(a1);
+    feedback[1] = static_cast<float>(a2);
+    feedback[2] = static_cast<float>(a3);
+
+    // Triggs and Sdika, Boundary conditions for Young-van Vliet recursive filtering, 2006
+    const double scale = b/((1 + a1 - a2 + a3) * (1 - a1 - a2 - a3) * (1 + a2 + (a1 - a3) * a3));
+    const double m[9] = {
+      -a3 * a1 + 1 - a3 * a3 - a2,
+      (a3 + a1) * (a2 + a3 * a1),
+      a3 * (a1 + a3 * a2),
+      a1 + a3 * a2,
+      -(a2 - 1) * (a2 + a3 * a1),
+      -(a3 * a1 + a3 * a3 + a2 - 1) * a3,
+      a3 * a1 + a2 + a1 * a1 - a2 * a2,
+      a1 * a2 + a3 * a2 * a2 - a1 * a3 * a3 - a3 * a3 * a3 - a3 * a2 + a3,
+      a3 * (a1 + a3 * a2)
+    };
+    for (unsigned int i = 0; i < 9; ++i) {
+      boundary[i] = static_cast<float>(scale * m[i]);
+    }
+  }
+
+  void GaussianBlurEngine::filterColumns(
+    float* plane,
+    MemorySize columns,
+    unsigned int rows,
+    MemorySize stride,
+    float* buffer,
+    const Coefficients& coefficients) noexcept {
+    if ((columns == 0) || (rows == 0)) {
+      return;
+    }
+    const Recurse step = recurse.get();
+    const int last = static_cast<int>(rows) - 1;
+    float* edge = buffer; // the last source row
+    float* after = buffer + columns; // the rows last + 1 and last + 2 of the anticausal pass
+    float* afterNext = buffer + 2 * columns;
+
+    for (MemorySize i = 0; i < columns; ++i) {
+      edge[i] = plane[last * stride + i];
+    }
+
+    // causal pass: the rows before the first row equal the first row which is also its own result
+    for (int row = 1; row <= last; ++row) {
+      float* current = plane + row * stride;
+      step(
+        current,
+        current,
+        plane + (row - 1) * stride,
+        plane + maximum(row - 2, 0) * stride,
+        plane + maximum(row - 3, 0) * stride,
+        columns,
+        coefficients
+      );
+    }
+
+    // initial conditions of the anticausal pass for the replicated last row
+    {
+      float* w0 = plane + last * stride;
+      const float* w1 = plane + maximum(last - 1, 0) * stride;
+      const float* w2 = plane + maximum(last - 2, 0) * stride;
+      const float* m = coefficients.boundary;
+      for (MemorySize i = 0; i < columns; ++i) {
+        const float value = edge[i];
+        const float e0 = w0[i] - value;
+        const float e1 = w1[i] - value;
+        const float e2 = w2[i] - value;
+        const float y0 = value + m[0] * e0 + m[1] * e1 + m[2] * e2;
+        after[i] = value + m[3] * e0 + m[4] * e1 + m[5] * e2;
+        afterNext[i] = value + m[6] * e0 + m[7] * e1 + m[8] * e2;
+        w0[i] = y0;
+      }
+    }
+
+    // anticausal pass
+    for (int row = last - 1; row >= 0; --row) {
+      float* current = plane + row * stride;
+      step(
+        current,
+        current,
+        plane + (row + 1) * stride,
+        ((row + 2) <= last) ? (plane + (row + 2) * stride) : after,
+        ((row + 3) <= last) ? (plane + (row + 3) * stride) : (((row + 3) == (last + 1)) ? after : afterNext),
+        columns,
+        coefficients
+      );
+    }
+  }
+
+  void GaussianBlurEngine::transpose(
+    float* destination,
+    MemorySize destinationStride,
+    const float* source,
+    MemorySize sourceStride,
+    unsigned int rows,
+    unsigned int columns) noexcept {
+    const unsigned int BLOCK = 32; // 4 KiB per block
+    for (unsigned int row = 0; row < rows; row += BLOCK) {
+      const unsigned int endRow = minimum(row + BLOCK, rows);
+      for (unsigned int column = 0; column < columns; column += BLOCK) {
+        const unsigned int endColumn = minimum(column + BLOCK, columns);
+        for (unsigned int y = row; y < endRow; ++y) {
+          const float* src = source + y * sourceStride;
+          for (unsigned int x = column; x < endColumn; ++x) {
+            destination[x * destinationStride + y] = src[x];
+          }
+        }
+      }
+    }
+  }
+
+  void GaussianBlurEngine::filter(
+    float* plane,
+    unsigned int width,
+    unsigned int height,
+    const Coefficients& coefficients) {
+    if ((width == 0) || (height == 0)) {
+      return;
+    }
+    const unsigned int rows = minimum<unsigned int>(STRIP, height);
+    Allocator<float> strip(static_cast<MemorySize>(rows) * width);
+    Allocator<float> buffer(3 * static_cast<MemorySize>(maximum(width, rows)));
+
+    filterColumns(plane, width, height, width, buffer.getElements(), coefficients);
+    for (unsigned int row = 0; row < height; row += STRIP) {
+      const unsigned int count = minimum<unsigned int>(STRIP, height - row);
+      float* first = plane + static_cast<MemorySize>(row) * width;
+      transpose(strip.getElements(), count, first, width, count, width);
+      filterColumns(strip.getElements(), count, width, count, buffer.getElements(), coefficients);
+      transpose(first, width, strip.getElements(), count, width, count);
+    }
+  }
+
+}; // end of gip namespace
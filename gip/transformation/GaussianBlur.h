@@ -0,0 +1,208 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#pragma once
+
+#include <gip/transformation/Transformation.h>
+#include <gip/transformation/Convolution.h>
+#include <gip/ArrayImage.h>
+#include <gip/ImageException.h>
+#include <base/mem/Allocator.h>
+
+namespace gip {
+
+  /**
+    Recursive Gaussian filter of Young and van Vliet applied to planes of
+    float samples. Each direction is filtered by a causal and an anticausal
+    third order recursion so the cost per sample does not depend on the
+    standard deviation. The edges are replicated using the initial
+    conditions of Triggs and Sdika.
+
+    The recursion runs down the columns and each step processes a complete
+    row of samples. The step is dispatched by CPUDispatch (kernel
+    "gaussianBlurRow"). The rows are filtered in strips of STRIP rows which
+    are transposed into a small buffer so the recursion runs across the rows
+    of the strip.
+
+    @short Recursive Gaussian filter engine.
+    @ingroup transformations filtering
+    @see GaussianBlur CPUDispatch
+    @version 1.0
+  */
+
+  class _COM_AZURE_DEV__GIP__API GaussianBlurEngine : public Object {
+  public:
+
+    /** The number of rows filtered together by the horizontal pass. */
+    enum {STRIP = 32};
+
+    /**
+      The coefficients of the recursion for a standard deviation.
+    */
+    class _COM_AZURE_DEV__GIP__API Coefficients {
+    public:
+
+      /** The gain of the input sample. */
+      float gain = 1;
+      /** The weights of the 3 previous output samples. */
+      float feedback[3];
+      /** The matrix of the initial conditions of the anticausal pass in row-major order. */
+      float boundary[9];
+
+      /**
+        Initializes the coefficients.
+
+        @param deviation The standard deviation (at least 0.5).
+      */
+      Coefficients(double deviation) noexcept;
+    };
+
+    /**
+      Filters the columns of a plane in place.
+
+      @param plane The first sample.
+      @param columns The number of columns.
+      @param rows The number of rows.
+      @param stride The number of samples between the rows.
+      @param buffer Temporary storage of 3 * columns samples.
+      @param coefficients The coefficients.
+    */
+    static void filterColumns(
+      float* plane,
+      MemorySize columns,
+      unsigned int rows,
+      MemorySize stride,
+      float* buffer,
+      const Coefficients& coefficients) noexcept;
+
+    /**
+      Transposes the specified samples.
+
+      @param destination The first destination sample.
+      @param destinationStride The number of samples between the destination rows.
+      @param source The first source sample.
+      @param sourceStride The number of samples between the source rows.
+      @param rows The number of source rows.
+      @param columns The number of source columns.
+    */
+    static void transpose(
+      float* destination,
+      MemorySize destinationStride,
+      const float* source,
+      MemorySize sourceStride,
+      unsigned int rows,
+      unsigned int columns) noexcept;
+
+    /**
+      Filters the columns and rows of a plane in place.
+
+      @param plane The samples (width * height).
+      @param width The width of the plane.
+      @param height The height of the plane.
+      @param coefficients The coefficients.
+    */
+    static void filter(float* plane, unsigned int width, unsigned int height, const Coefficients& coefficients);
+  };
+
+  /**
+    Gaussian blur with a cost per pixel which is independent of the standard
+    deviation. The image is not resized and no Fourier transformation is
+    used. Gray, float and color images (each component separately) are
+    supported. Pixels outside the image are replicated from the edges.
+
+    @code
+    GaussianBlur<ColorImage> transform(&blurred, &image, 4.0);
+    transform();
+    @endcode
+
+    @short Recursive Gaussian blur.
+    @ingroup transformations filtering
+    @see GaussianBlurEngine
+    @version 1.0
+  */
+
+  template<class DEST, class SRC = DEST>
+  class GaussianBlur : public Transformation<DEST, SRC> {
+  public:
+
+    typedef typename Transformation<DEST, SRC>::DestinationImage DestinationImage;
+    typedef typename Transformation<DEST, SRC>::SourceImage SourceImage;
+    typedef typename SourceImage::Pixel SourcePixel;
+    typedef typename DestinationImage::Pixel DestinationPixel;
+  private:
+
+    /** The coefficients of the recursion. */
+    GaussianBlurEngine::Coefficients coefficients;
+  public:
+
+    /**
+      Initializes the transformation.
+
+      @param destination The destination image.
+      @param source The source image.
+      @param deviation The standard deviation in pixels (at least 0.5).
+    */
+    GaussianBlur(DestinationImage* destination, const SourceImage* source, double deviation)
+      : Transformation<DEST, SRC>(destination, source),
+        coefficients((deviation >= 0.5) ? deviation : 0.5) {
+      bassert(
+        destination->getDimension() == source->getDimension(),
+        ImageException("Images must have the same dimension", this)
+      );
+      bassert(deviation >= 0.5, ImageException("Standard deviation must be at least 0.5", this));
+    }
+
+    /**
+      Blurs the image.
+    */
+    void operator()() const {
+      static Metrics::Counter counter("GaussianBlur");
+      Metrics::Scope scope(counter, *Transformation<DEST, SRC>::destination, *Transformation<DEST, SRC>::source);
+
+      const unsigned int width = Transformation<DEST, SRC>::source->getWidth();
+      const unsigned int height = Transformation<DEST, SRC>::source->getHeight();
+      if ((width == 0) || (height == 0)) {
+        return;
+      }
+      const MemorySize size = static_cast<MemorySize>(width) * height;
+      Allocator<float> plane(size);
+
+      for (unsigned int channel = 0; channel < ConvolutionPixel<SourcePixel>::CHANNELS; ++channel) {
+        {
+          typename SourceImage::ReadableRows::RowIterator row = Transformation<DEST, SRC>::source->getRows().getFirst();
+          float* dest = plane.getElements();
+          for (unsigned int y = 0; y < height; ++y, ++row) {
+            typename SourceImage::ReadableRows::RowIterator::ElementIterator src = row.getFirst();
+            for (unsigned int x = 0; x < width; ++x) {
+              *dest++ = ConvolutionPixel<SourcePixel>::template get<float>(*src++, channel);
+            }
+          }
+        }
+
+        GaussianBlurEngine::filter(plane.getElements(), width, height, coefficients);
+
+        {
+          typename DestinationImage::Rows::RowIterator row = Transformation<DEST, SRC>::destination->getRows().getFirst();
+          const float* src = plane.getElements();
+          for (unsigned int y = 0; y < height; ++y, ++row) {
+            typename DestinationImage::Rows::RowIterator::ElementIterator dest = row.getFirst();
+            for (unsigned int x = 0; x < width; ++x) {
+              ConvolutionPixel<DestinationPixel>::set(*dest++, channel, *src++);
+            }
+          }
+        }
+      }
+    }
+  };
+
+}; // end of gip namespace
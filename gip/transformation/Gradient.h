@@ -14,8 +14,11 @@
 #pragma once
 
 #include <gip/transformation/Transformation.h>
+#include <gip/Border.h>
 #include <gip/ArrayImage.h>
 #include <gip/ImageException.h>
+#include <base/math/Constants.h>
+#include <base/math/Math.h>
 
 namespace gip {
 
@@ -27,7 +30,57 @@ namespace gip {
     @version 1.0
   */
   
-  class _COM_AZURE_DEV__GIP__API Gradient : public Transformation<GrayImage, GrayImage> {
+  template<class IMAGE>
+  class BasicGradient : public Transformation<IMAGE, IMAGE> {
+  public:
+
+    typedef typename Transformation<IMAGE, IMAGE>::DestinationImage DestinationImage;
+    typedef typename Transformation<IMAGE, IMAGE>::SourceImage SourceImage;
+  private:
+
+    /** The gradient of the 3x3 neighborhood. */
+    class ApplyKernel {
+    public:
+
+      typedef const typename SourceImage::Pixel* Iterator;
+
+      inline typename DestinationImage::Pixel operator()(Iterator previous, Iterator current, Iterator next) const noexcept {
+        double verticalGray = 0;
+        verticalGray += -constant::SQRT2 * previous[-1];
+        verticalGray += -2 * previous[0];
+        verticalGray += -constant::SQRT2 * previous[1];
+
+//      verticalGray += 0 * current[-1];
+//      verticalGray += 0 * current[0];
+//      verticalGray += 0 * current[1];
+
+        verticalGray += constant::SQRT2 * next[-1];
+        verticalGray += 2 * next[0];
+        verticalGray += constant::SQRT2 * next[1];
+
+        double horizontalGray = 0;
+        horizontalGray += -constant::SQRT2 * previous[-1];
+//      horizontalGray += 0 * previous[0];
+        horizontalGray += constant::SQRT2 * previous[1];
+
+        horizontalGray += -2 * current[-1];
+//      horizontalGray += 0 * current[0];
+        horizontalGray += 2 * current[1];
+
+        horizontalGray += -constant::SQRT2 * next[-1];
+//      horizontalGray += 0 * next[0];
+        horizontalGray += constant::SQRT2 * next[1];
+
+//      double gray = Math::abs(verticalGray) + Math::abs(horizontalGray);
+        double gray = Math::sqrt(verticalGray * verticalGray + horizontalGray * horizontalGray);
+        return static_cast<typename DestinationImage::Pixel>(minimum<double>(gray, 0xff)); // saturate
+      }
+    };
+
+    /** The border mode. */
+    Border::Mode border = Border::REPLICATE;
+    /** The value of the pixels outside the source image for Border::CONSTANT. */
+    typename SourceImage::Pixel constant;
   public:
 
     /**
@@ -35,13 +88,69 @@ namespace gip {
 
       @param destination The destination image.
       @param source The source image.
+      @param border The border mode. The default is Border::REPLICATE.
+      @param constant The value of the pixels outside the source image for Border::CONSTANT.
+    */
+    BasicGradient(
+      DestinationImage* destination,
+      const SourceImage* source,
+      Border::Mode border = Border::REPLICATE,
+      const typename SourceImage::Pixel& constant = typename SourceImage::Pixel());
+
+    /** The number of source rows above and below a row required to calculate the row. */
+    static constexpr unsigned int HALO = 1;
+
+    /**
+      Calculates the gradient for the specified region of the destination
+      image. The border pixels of the image are not modified for Border::NONE.
     */
-    Gradient(DestinationImage* destination, const SourceImage* source);
+    void operator()(const Region& region) const;
 
     /**
-      Duplicates the contents of the source image to the destination image.
+      Calculates the gradient of the source image.
     */
-    void operator()() noexcept;
+    void operator()() const;
   };
 
+  template<class IMAGE>
+  BasicGradient<IMAGE>::BasicGradient(
+    DestinationImage* destination,
+    const SourceImage* source,
+    Border::Mode _border,
+    const typename SourceImage::Pixel& _constant)
+    : Transformation<DestinationImage, SourceImage>(destination, source), border(_border), constant(_constant) {
+    bassert(
+      destination->getDimension() == source->getDimension(),
+      ImageException("Images must have identical dimensions", this)
+    );
+  }
+
+  template<class IMAGE>
+  void BasicGradient<IMAGE>::operator()(const Region& region) const {
+    bassert(
+      region.isWithin(Transformation<IMAGE, IMAGE>::destination->getDimension()),
+      ImageException("Region must be within image", this)
+    );
+    applyNeighborhood(
+      *Transformation<IMAGE, IMAGE>::destination,
+      *Transformation<IMAGE, IMAGE>::source,
+      region,
+      border,
+      constant,
+      ApplyKernel()
+    );
+  }
+
+  template<class IMAGE>
+  void BasicGradient<IMAGE>::operator()() const {
+    static Metrics::Counter counter("Gradient");
+    Metrics::Scope scope(counter, *Transformation<IMAGE, IMAGE>::destination, *Transformation<IMAGE, IMAGE>::source);
+    (*this)(Region(Point2D(0, 0), Transformation<IMAGE, IMAGE>::destination->getDimension()));
+  }
+
+  /** Gradient of gray images. */
+  typedef BasicGradient<GrayImage> Gradient;
+  /** Gradient of compact 8-bit gray images. */
+  typedef BasicGradient<Gray8Image> Gray8Gradient;
+
 }; // end of gip namespace
@@ -34,6 +34,8 @@ namespace gip {
   }
 
   void HaarTransformation<FloatImage>::operator()() noexcept {
+    static Metrics::Counter counter("HaarTransformation");
+    Metrics::Scope scope(counter, *destination);
     // Haar transformation row by row
     if (numberOfColumnIterations > 0) {
       PrimitiveArray<Pixel> buffer(static_cast<MemorySize>(1) << (numberOfColumnIterations - 1));
@@ -125,6 +127,8 @@ namespace gip {
   }
 
   void HaarTransformation<GrayImage>::operator()() noexcept {
+    static Metrics::Counter counter("HaarTransformation");
+    Metrics::Scope scope(counter, *destination);
     // Haar transformation row by row
     if (numberOfColumnIterations > 0) {
       PrimitiveArray<Pixel> buffer(static_cast<MemorySize>(1) << (numberOfColumnIterations - 1));
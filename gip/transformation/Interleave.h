@@ -0,0 +1,134 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#pragma once
+
+#include <gip/transformation/Transformation.h>
+#include <gip/PlanarRGBImage.h>
+
+namespace gip {
+
+  /**
+    Splits an interleaved RGB image into the planes of a planar RGB image.
+
+    @short Interleaved to planar conversion.
+    @ingroup transformations
+    @see Interleave
+    @version 1.0
+  */
+
+  template<class COMPONENT>
+  class Deinterleave : public Transformation<PlanarRGBImage<COMPONENT>, ArrayImage<RGBPixel<COMPONENT> > > {
+  public:
+
+    typedef Transformation<PlanarRGBImage<COMPONENT>, ArrayImage<RGBPixel<COMPONENT> > > Base;
+    typedef typename Base::DestinationImage DestinationImage;
+    typedef typename Base::SourceImage SourceImage;
+
+    /**
+      Initializes the transformation.
+
+      @param destination The destination image.
+      @param source The source image.
+    */
+    Deinterleave(DestinationImage* destination, const SourceImage* source)
+      : Base(destination, source) {
+      bassert(destination->getDimension() == source->getDimension(), ImageException(this));
+    }
+
+    void operator()() {
+      static Metrics::Counter counter("Deinterleave");
+      Metrics::Scope scope(counter, *Base::destination, *Base::source);
+      const unsigned int width = Base::source->getWidth();
+      const unsigned int height = Base::source->getHeight();
+      const MemorySize srcPitch = Base::source->getPitch();
+      const MemorySize destPitch = Base::destination->getPitch();
+
+      const RGBPixel<COMPONENT>* src = Base::source->getElements();
+      COMPONENT* red = Base::destination->getRed().getElements();
+      COMPONENT* green = Base::destination->getGreen().getElements();
+      COMPONENT* blue = Base::destination->getBlue().getElements();
+
+      for (unsigned int row = 0; row < height; ++row) {
+        for (unsigned int column = 0; column < width; ++column) { // contiguous loads and stores
+          const RGBPixel<COMPONENT> value = src[column];
+          red[column] = value.red;
+          green[column] = value.green;
+          blue[column] = value.blue;
+        }
+        src += srcPitch;
+        red += destPitch;
+        green += destPitch;
+        blue += destPitch;
+      }
+    }
+  };
+
+  /**
+    Merges the planes of a planar RGB image into an interleaved RGB image.
+
+    @short Planar to interleaved conversion.
+    @ingroup transformations
+    @see Deinterleave
+    @version 1.0
+  */
+
+  template<class COMPONENT>
+  class Interleave : public Transformation<ArrayImage<RGBPixel<COMPONENT> >, PlanarRGBImage<COMPONENT> > {
+  public:
+
+    typedef Transformation<ArrayImage<RGBPixel<COMPONENT> >, PlanarRGBImage<COMPONENT> > Base;
+    typedef typename Base::DestinationImage DestinationImage;
+    typedef typename Base::SourceImage SourceImage;
+
+    /**
+      Initializes the transformation.
+
+      @param destination The destination image.
+      @param source The source image.
+    */
+    Interleave(DestinationImage* destination, const SourceImage* source)
+      : Base(destination, source) {
+      bassert(destination->getDimension() == source->getDimension(), ImageException(this));
+    }
+
+    void operator()() {
+      static Metrics::Counter counter("Interleave");
+      Metrics::Scope scope(counter, *Base::destination, *Base::source);
+      const unsigned int width = Base::source->getWidth();
+      const unsigned int height = Base::source->getHeight();
+      const MemorySize srcPitch = Base::source->getPitch();
+      const MemorySize destPitch = Base::destination->getPitch();
+
+      const COMPONENT* red = Base::source->getRed().getElements();
+      const COMPONENT* green = Base::source->getGreen().getElements();
+      const COMPONENT* blue = Base::source->getBlue().getElements();
+      RGBPixel<COMPONENT>* dest = Base::destination->getElements();
+
+      for (unsigned int row = 0; row < height; ++row) {
+        for (unsigned int column = 0; column < width; ++column) { // contiguous loads and stores
+          RGBPixel<COMPONENT> value = RGBPixel<COMPONENT>(); // zeroes the unused byte of ColorPixel
+          value.red = red[column];
+          value.green = green[column];
+          value.blue = blue[column];
+          dest[column] = value;
+        }
+        red += srcPitch;
+        green += srcPitch;
+        blue += srcPitch;
+        dest += destPitch;
+      }
+    }
+  };
+
+}; // end of gip namespace
@@ -21,63 +21,60 @@ namespace gip {
     bassert(source->getDimension().isProper(), ImageException("Unable to scale image", this));
   }
 
-  void LinearScale::operator()() noexcept {
-    if (!destination->getDimension().isProper()) {
+  void LinearScale::operator()(const Region& region) const {
+    bassert(region.isWithin(destination->getDimension()), ImageException("Region must be within image", this));
+    if (!region.isProper()) {
       return;
     }
 
-    unsigned int rows = destination->getDimension().getHeight();
-    unsigned int columns = destination->getDimension().getWidth();
-    unsigned int srcRows = source->getDimension().getHeight();
-    unsigned int srcColumns = source->getDimension().getWidth();
-    double stepPerRow = static_cast<double>(srcRows - 1)/(rows - 1);
-    double stepPerColumn = static_cast<double>(srcColumns - 1)/(columns - 1);
+    const unsigned int rows = destination->getDimension().getHeight();
+    const unsigned int columns = destination->getDimension().getWidth();
+    const unsigned int srcRows = source->getDimension().getHeight();
+    const unsigned int srcColumns = source->getDimension().getWidth();
+    const double stepPerRow = (rows > 1) ? static_cast<double>(srcRows - 1)/(rows - 1) : 0;
+    const double stepPerColumn = (columns > 1) ? static_cast<double>(srcColumns - 1)/(columns - 1) : 0;
 
     DestinationImage::Rows rowsLookup = destination->getRows();
     SourceImage::ReadableRows srcRowsLookup = source->getRows();
 
-    --rows; // last row is a special case
-    --columns; // last column is a special case
-
     DestinationImage::Rows::RowIterator row = rowsLookup.getFirst();
-    double floatRow = 0;
-    for (unsigned int rowCount = rows; rowCount > 0; --rowCount) {
-      unsigned int srcRowIndex = static_cast<unsigned int>(floatRow); // round to zero
-      double weightRow = floatRow - srcRowIndex;
+    row += region.getOffset().getRow();
+    for (unsigned int rowIndex = region.getOffset().getRow(); rowIndex < region.getEndRow(); ++rowIndex) {
+      // last row maps exactly to the last source row
+      const double floatRow = (rowIndex == rows - 1) ? (srcRows - 1) : rowIndex * stepPerRow;
+      const unsigned int srcRowIndex = static_cast<unsigned int>(floatRow); // round to zero
+      const double weightRow = floatRow - srcRowIndex;
 
       SourceImage::ReadableRows::RowIterator srcCurrentRow = srcRowsLookup[srcRowIndex];
-      SourceImage::ReadableRows::RowIterator srcNextRow = srcCurrentRow;
-      ++srcNextRow;
+      SourceImage::ReadableRows::RowIterator srcNextRow = srcRowsLookup[minimum(srcRowIndex + 1, srcRows - 1)];
 
-      DestinationImage::Rows::RowIterator::ElementIterator column = row.getFirst();
-      double floatColumn = 0;
-      for (unsigned int columnCount = columns; columnCount > 0; --columnCount) {
-        unsigned int srcColumnIndex = static_cast<unsigned int>(floatColumn); // round to zero
-        double weightColumn = floatColumn - srcColumnIndex;
+      DestinationImage::Rows::RowIterator::ElementIterator column = row.getFirst() + region.getOffset().getColumn();
+      for (unsigned int columnIndex = region.getOffset().getColumn(); columnIndex < region.getEndColumn(); ++columnIndex) {
+        // last column maps exactly to the last source column
+        const double floatColumn = (columnIndex == columns - 1) ? (srcColumns - 1) : columnIndex * stepPerColumn;
+        const unsigned int srcColumnIndex = static_cast<unsigned int>(floatColumn); // round to zero
+        const unsigned int srcNextColumnIndex = minimum(srcColumnIndex + 1, srcColumns - 1);
+        const double weightColumn = floatColumn - srcColumnIndex;
 
-        SourceImage::ReadableRows::RowIterator::ElementIterator srcColumn = srcCurrentRow[srcColumnIndex];
-        ColorPixel temp = *srcColumn;
+        ColorPixel temp = srcCurrentRow[srcColumnIndex];
         double weight = (1 - weightRow) * (1 - weightColumn);
         double blue = temp.blue * weight;
         double green = temp.green * weight;
         double red = temp.red * weight;
 
-        ++srcColumn;
-        temp = *srcColumn;
+        temp = srcCurrentRow[srcNextColumnIndex];
         weight = (1 - weightRow) * weightColumn;
         blue += temp.blue * weight;
         green += temp.green * weight;
         red += temp.red * weight;
 
-        srcColumn = srcNextRow[srcColumnIndex];
-        temp = *srcColumn;
+        temp = srcNextRow[srcColumnIndex];
         weight = weightRow * (1 - weightColumn);
         blue += temp.blue * weight;
         green += temp.green * weight;
         red += temp.red * weight;
 
-        ++srcColumn;
-        temp = *srcColumn;
+        temp = srcNextRow[srcNextColumnIndex];
         weight = weightRow * weightColumn;
         blue += temp.blue * weight;
         green += temp.green * weight;
@@ -89,50 +86,15 @@ namespace gip {
         result.red = static_cast<unsigned char>(red); // overflow not possible
         *column = result;
         ++column;
-
-        floatColumn += stepPerColumn;
       }
-
-      {
-        // initialize last column
-        unsigned int srcColumnIndex = srcColumns - 1;
-        double weight = (1 - weightRow);
-
-        ColorPixel current = srcCurrentRow[srcColumnIndex];
-        ColorPixel next = srcNextRow[srcColumnIndex];
-        ColorPixel result;
-        result.blue = static_cast<unsigned char>(current.blue * weight + next.blue * weightRow);
-        result.green = static_cast<unsigned char>(current.green * weight + next.green * weightRow);
-        result.red = static_cast<unsigned char>(current.red * weight + next.red * weightRow);
-        *column = result; // no need to increment column
-      }
-
-      floatRow += stepPerRow;
       ++row;
     }
+  }
 
-    // initialize last row
-    SourceImage::ReadableRows::RowIterator srcCurrentRow = srcRowsLookup[srcRows - 1];
-    DestinationImage::Rows::RowIterator::ElementIterator column = row.getFirst();
-    double floatColumn = 0;
-    for (unsigned int columnCount = columns + 1; columnCount > 0; --columnCount) { // also the last pixel of the row
-      unsigned int srcColumnIndex = static_cast<unsigned int>(floatColumn); // round to zero
-      double weightColumn = floatColumn - srcColumnIndex;
-      double weight = 1 - weightColumn;
-
-      SourceImage::ReadableRows::RowIterator::ElementIterator srcColumn = srcCurrentRow[srcColumnIndex];
-      ColorPixel current = *srcColumn;
-      ++srcColumn;
-      ColorPixel next = *srcColumn;
-      ColorPixel result;
-      result.blue = static_cast<unsigned char>(current.blue * weight + next.blue * weightColumn);
-      result.green = static_cast<unsigned char>(current.green * weight + next.green * weightColumn);
-      result.red = static_cast<unsigned char>(current.red * weight + next.red * weightColumn);
-      *column = result;
-      ++column;
-
-      floatColumn += stepPerColumn;
-    }
+  void LinearScale::operator()() const noexcept {
+    static Metrics::Counter counter("LinearScale");
+    Metrics::Scope scope(counter, *destination, *source);
+    (*this)(Region(Point2D(0, 0), destination->getDimension()));
   }
 
 }; // end of gip namespace
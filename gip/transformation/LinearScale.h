@@ -39,10 +39,15 @@ namespace gip {
     */
     LinearScale(DestinationImage* destination, const SourceImage* source);
 
+    /**
+      Scales the source image to the specified region of the destination image.
+    */
+    void operator()(const Region& region) const;
+
     /**
       Scale the source image to the destination image.
     */
-    void operator()() noexcept;
+    void operator()() const noexcept;
   };
 
 }; // end of gip namespace
@@ -15,6 +15,7 @@
 
 #include <gip/gip.h>
 #include <gip/transformation/Transformation.h>
+#include <gip/Border.h>
 #include <base/mem/Allocator.h>
 
 namespace gip {
@@ -28,15 +29,15 @@ namespace gip {
     @version 1.0
   */
   
-  class _COM_AZURE_DEV__GIP__API MedianFilter3x3 : public Transformation<GrayImage, GrayImage> {
+  template<class IMAGE>
+  class BasicMedianFilter3x3 : public Transformation<IMAGE, IMAGE> {
+  public:
+
+    typedef typename Transformation<IMAGE, IMAGE>::DestinationImage DestinationImage;
+    typedef typename Transformation<IMAGE, IMAGE>::SourceImage SourceImage;
   private:
     
-    typedef PixelTraits<SourceImage::Pixel>::Component Component;
-
-    struct Elements2 {
-      Component left;
-      Component right;
-    };
+    typedef typename PixelTraits<typename SourceImage::Pixel>::Component Component;
 
     struct Elements {
       Component left;
@@ -58,32 +59,6 @@ namespace gip {
       }
     }
 
-    static inline Elements2 sort(Component left, Component right) noexcept {
-      if (left <= right) {
-        return Elements2{left, right};
-      } else {
-        return Elements2{right, left};
-      }
-    }
-    
-    static inline Component getMedian4(Component a, Component b, Component c, Component d) noexcept {
-      Elements2 left0 = sort(a, b);
-      Elements2 right0 = sort(c, d);
-      Elements2 left1 = sort(left0.left, right0.left);
-      Elements2 right1 = sort(left0.right, right0.right);
-      return sort(left1.right, right1.left).left;
-    }
-    
-    static inline Component getMedian6(Component a, Component b, Component c, Component d, Component e, Component f) noexcept {
-      Elements left0 = sort(a, b, c);
-      Elements right0 = sort(d, e, f);
-      return sort(
-        maximum(left0.left, right0.left),
-        minimum(left0.middle, right0.middle),
-        minimum(left0.right, right0.right)
-      ).middle;
-    }
-
     static inline Component getMedian9(Component a, Component b, Component c, Component d, Component e, Component f, Component g, Component h, Component i) noexcept {
       Elements left0 = sort(a, b, c);
       Elements middle0 = sort(d, e, f);
@@ -94,6 +69,26 @@ namespace gip {
         minimum(left0.right, middle0.right, right0.right)
       ).middle;
     }
+
+    /** The median of the 3x3 neighborhood. */
+    class ApplyKernel {
+    public:
+
+      typedef const typename SourceImage::Pixel* Iterator;
+
+      inline Component operator()(Iterator previous, Iterator current, Iterator next) const noexcept {
+        return getMedian9(
+          previous[-1], previous[0], previous[1],
+          current[-1], current[0], current[1],
+          next[-1], next[0], next[1]
+        );
+      }
+    };
+
+    /** The border mode. */
+    Border::Mode border = Border::REPLICATE;
+    /** The value of the pixels outside the source image for Border::CONSTANT. */
+    typename SourceImage::Pixel constant;
   public:
     
     /**
@@ -101,116 +96,51 @@ namespace gip {
       
       @param destination The destination image.
       @param source The source image.
+      @param border The border mode. The default is Border::REPLICATE.
+      @param constant The value of the pixels outside the source image for Border::CONSTANT.
     */
-    MedianFilter3x3(DestinationImage* destination, const SourceImage* source) 
-      : Transformation<DestinationImage, SourceImage>(destination, source) {
+    BasicMedianFilter3x3(
+      DestinationImage* destination,
+      const SourceImage* source,
+      Border::Mode _border = Border::REPLICATE,
+      const typename SourceImage::Pixel& _constant = typename SourceImage::Pixel())
+      : Transformation<DestinationImage, SourceImage>(destination, source), border(_border), constant(_constant) {
       
       bassert(destination->getDimension() == source->getDimension(), ImageException(this));
     }
 
+    /** The number of source rows above and below a row required to calculate the row. */
+    static constexpr unsigned int HALO = 1;
+
+    /**
+      Calculates the transformation for the specified region of the destination
+      image. The border pixels of the image are not modified for Border::NONE.
+    */
+    void operator()(const Region& region) const {
+      bassert(region.isWithin(Transformation<IMAGE, IMAGE>::destination->getDimension()), ImageException(this));
+      applyNeighborhood(
+        *Transformation<IMAGE, IMAGE>::destination,
+        *Transformation<IMAGE, IMAGE>::source,
+        region,
+        border,
+        constant,
+        ApplyKernel()
+      );
+    }
+
     /**
       Calculate transformation.
     */
-    void operator()() noexcept {
-      /*typename*/ SourceImage::ReadableRows rowLookup = source->getRows();
-      /*typename*/ SourceImage::ReadableRows::RowIterator endRow = rowLookup.getEnd();
-      /*typename*/ SourceImage::ReadableRows::RowIterator currentRow = rowLookup.getFirst();
-      /*typename*/ SourceImage::ReadableRows::RowIterator nextRow = currentRow + 1;
-      
-      /*typename*/ DestinationImage::Rows::RowIterator destRow = destination->getRows().getFirst();
-      
-      // handle first row
-      {
-        /*typename*/ SourceImage::ReadableRows::RowIterator::ElementIterator currentRowColumn = currentRow.getFirst();
-        /*typename*/ SourceImage::ReadableRows::RowIterator::ElementIterator nextRowColumn = nextRow.getFirst();
-        /*typename*/ SourceImage::ReadableRows::RowIterator::ElementIterator endCurrentRowColumn = currentRow.getEnd() - 1;
-        /*typename*/ DestinationImage::Rows::RowIterator::ElementIterator dest = destRow.getFirst();
-        
-        // handle left corner
-        *dest++ = getMedian4(currentRowColumn[0], currentRowColumn[1], nextRowColumn[0], nextRowColumn[1]);
-        ++currentRowColumn;
-        ++nextRowColumn;
-        
-        while (currentRowColumn < endCurrentRowColumn) {
-          *dest++ = getMedian6(
-            currentRowColumn[-1], currentRowColumn[0], currentRowColumn[1],
-            nextRowColumn[-1], nextRowColumn[0], nextRowColumn[1]
-          );
-          ++currentRowColumn;
-          ++nextRowColumn;
-        }
-        
-        // handle right corner
-        *dest++ = getMedian4(currentRowColumn[-1], currentRowColumn[0], nextRowColumn[-1], nextRowColumn[0]);
-      }
-      
-      /*typename*/ SourceImage::ReadableRows::RowIterator previousRow = currentRow;
-      currentRow = nextRow;
-      ++nextRow;
-      ++destRow;
-      
-      while (nextRow < endRow) {
-        /*typename*/ SourceImage::ReadableRows::RowIterator::ElementIterator previousRowColumn = previousRow.getFirst();
-        /*typename*/ SourceImage::ReadableRows::RowIterator::ElementIterator currentRowColumn = currentRow.getFirst();
-        /*typename*/ SourceImage::ReadableRows::RowIterator::ElementIterator nextRowColumn = nextRow.getFirst();
-        /*typename*/ SourceImage::ReadableRows::RowIterator::ElementIterator endCurrentRowColumn = currentRow.getEnd() - 1;
-        /*typename*/ DestinationImage::Rows::RowIterator::ElementIterator dest = destRow.getFirst();
-        
-        // first column
-        *dest++ = getMedian6(
-          previousRowColumn[0], previousRowColumn[1], currentRowColumn[0], currentRowColumn[1], nextRowColumn[0], nextRowColumn[1]
-        );
-        ++previousRowColumn;
-        ++currentRowColumn;
-        ++nextRowColumn;
-        
-        while (currentRowColumn < endCurrentRowColumn) {
-          *dest++ = getMedian9(
-            previousRowColumn[-1], previousRowColumn[0], previousRowColumn[1],
-            currentRowColumn[-1], currentRowColumn[0], currentRowColumn[1],
-            nextRowColumn[-1], nextRowColumn[0], nextRowColumn[1]
-          );
-          ++previousRowColumn;
-          ++currentRowColumn;
-          ++nextRowColumn;
-        }
-        
-        // last column
-        *dest++ = getMedian6(
-          previousRowColumn[-1], previousRowColumn[0], currentRowColumn[-1], currentRowColumn[0], nextRowColumn[-1], nextRowColumn[0]
-        );
-        
-        previousRow = currentRow;
-        currentRow = nextRow;
-        ++nextRow;
-        ++destRow;
-      }
-      
-      // handle second row
-      {
-        /*typename*/ SourceImage::ReadableRows::RowIterator::ElementIterator previousRowColumn = previousRow.getFirst();
-        /*typename*/ SourceImage::ReadableRows::RowIterator::ElementIterator currentRowColumn = currentRow.getFirst();
-        /*typename*/ SourceImage::ReadableRows::RowIterator::ElementIterator endCurrentRowColumn = currentRow.getEnd() - 1;
-        /*typename*/ DestinationImage::Rows::RowIterator::ElementIterator dest = destRow.getFirst();
-        
-        // handle left corner
-        *dest++ = getMedian4(previousRowColumn[0], previousRowColumn[1], currentRowColumn[0], currentRowColumn[1]);
-        ++previousRowColumn;
-        ++currentRowColumn;
-        
-        while (currentRowColumn < endCurrentRowColumn) {
-          *dest++ = getMedian6(
-            previousRowColumn[-1], previousRowColumn[0], previousRowColumn[1],
-            currentRowColumn[-1], currentRowColumn[0], currentRowColumn[1]
-          );
-          ++previousRowColumn;
-          ++currentRowColumn;
-        }
-        
-        // handle right corner
-        *dest++ = getMedian4(previousRowColumn[0], previousRowColumn[1], currentRowColumn[-1], currentRowColumn[0]);
-      }
+    void operator()() const {
+      static Metrics::Counter counter("MedianFilter3x3");
+      Metrics::Scope scope(counter, *Transformation<IMAGE, IMAGE>::destination, *Transformation<IMAGE, IMAGE>::source);
+      (*this)(Region(Point2D(0, 0), Transformation<IMAGE, IMAGE>::destination->getDimension()));
     }
   };
+
+  /** Median filter for gray images. */
+  typedef BasicMedianFilter3x3<GrayImage> MedianFilter3x3;
+  /** Median filter for compact 8-bit gray images. */
+  typedef BasicMedianFilter3x3<Gray8Image> Gray8MedianFilter3x3;
   
 }; // end of gip namespace
@@ -48,6 +48,8 @@ namespace gip {
 
   template<class DEST>
   void Mirror<DEST>::operator()() noexcept {
+    static Metrics::Counter counter("Mirror");
+    Metrics::Scope scope(counter, *UnaryTransformation<DestinationImage>::destination);
     unsigned int elementsPerRowToSwap = UnaryTransformation<DestinationImage>::destination->getWidth()/2;
     typename DestinationImage::Rows rowLookup = UnaryTransformation<DestinationImage>::destination->getRows();
     typename DestinationImage::Rows::RowIterator row = rowLookup.getFirst();
@@ -83,9 +83,12 @@ namespace gip {
       Fills the destination image with noise.
     */
     void operator()() noexcept {
+      static Metrics::Counter counter("Noise");
+      Metrics::Scope scope(counter, *UnaryTransformation<DEST>::destination);
       forEach(
         UnaryTransformation<DEST>::destination->getElements(),
-        UnaryTransformation<DEST>::destination->getDimension().getSize(),
+        static_cast<MemorySize>(UnaryTransformation<DEST>::destination->getPitch()) *
+          UnaryTransformation<DEST>::destination->getHeight(), // padding is filled too
         NoiseOperation<Pixel>()
       );
     }
@@ -0,0 +1,98 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#include <gip/transformation/Pipeline.h>
+#include <gip/Metrics.h>
+#include <base/mem/Allocator.h>
+
+namespace gip {
+
+  Pipeline::Pipeline() noexcept {
+  }
+
+  void Pipeline::add(Stage* stage) {
+    if (stages.getSize() > 0) {
+      if (!(stage->getDimension() == stages.getElements()[0]->getDimension())) {
+        delete stage;
+        throw ImageException("Stages must have identical dimension", this);
+      }
+    }
+    try {
+      stages.append(stage);
+    } catch (...) {
+      delete stage;
+      throw;
+    }
+  }
+
+  unsigned int Pipeline::getBandHeight() const noexcept {
+    if (bandHeight > 0) {
+      return bandHeight;
+    }
+    MemorySize rowSize = 0;
+    const MemorySize count = stages.getSize();
+    for (MemorySize i = 0; i < count; ++i) {
+      rowSize += stages[i]->getRowSize();
+    }
+    const MemorySize result = (rowSize > 0) ? (cacheSize/rowSize) : 0;
+    return (result > 0) ? static_cast<unsigned int>(minimum<MemorySize>(result, 0xffffffff)) : 1;
+  }
+
+  void Pipeline::operator()() {
+    const MemorySize count = stages.getSize();
+    if (count == 0) {
+      return;
+    }
+    Stage** stage = stages.getElements();
+    const Dimension dimension = stage[0]->getDimension();
+    const unsigned int height = dimension.getHeight();
+    const unsigned int band = getBandHeight();
+
+    static Metrics::Counter counter("Pipeline");
+    Metrics::Scope scope(counter);
+    MemorySize rowSize = 0;
+    for (MemorySize i = 0; i < count; ++i) {
+      rowSize += stage[i]->getRowSize();
+    }
+    scope.setProcessed(static_cast<uint64>(dimension.getWidth()) * height, static_cast<uint64>(rowSize) * height);
+
+    // rows required ahead by the later stages and rows calculated so far
+    Allocator<unsigned int> ahead(count);
+    Allocator<unsigned int> done(count);
+    ahead.getElements()[count - 1] = 0;
+    for (MemorySize i = count - 1; i > 0; --i) {
+      ahead.getElements()[i - 1] = ahead.getElements()[i] + stage[i]->getHalo();
+    }
+    fill<unsigned int>(done.getElements(), count, 0);
+
+    for (unsigned int begin = 0; begin < height; begin += minimum(band, height - begin)) {
+      const unsigned int end = begin + minimum(band, height - begin);
+      for (MemorySize i = 0; i < count; ++i) {
+        const unsigned int first = done.getElements()[i];
+        const unsigned int last = minimum(end + minimum(ahead.getElements()[i], height - end), height);
+        if (last > first) {
+          stage[i]->execute(Region(Point2D(first, 0), Dimension(dimension.getWidth(), last - first)));
+          done.getElements()[i] = last;
+        }
+      }
+    }
+  }
+
+  Pipeline::~Pipeline() noexcept {
+    const MemorySize count = stages.getSize();
+    for (MemorySize i = 0; i < count; ++i) {
+      delete stages[i];
+    }
+  }
+
+}; // end of gip namespace
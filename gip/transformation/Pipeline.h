@@ -0,0 +1,278 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#pragma once
+
+#include <gip/transformation/Transformation.h>
+#include <gip/Region.h>
+#include <gip/ImageException.h>
+#include <base/collection/Array.h>
+
+namespace gip {
+
+  /**
+    Executes a chain of transformations in horizontal bands. Each stage reads
+    the destination of the previous stage. Instead of executing each stage for
+    the whole image, the stages are executed band after band so that the rows
+    written by a stage are still in the cache when read by the next stage.
+
+    A stage which requires neighboring rows of its source (e.g.
+    Convolution3x3 and MedianFilter3x3) declares the number of rows required
+    above and below (the halo). The earlier stages are executed ahead by the
+    accumulated halo of the later stages. Every row is calculated exactly once
+    so the result is identical to executing the stages one after the other.
+
+    <pre>
+    Pipeline pipeline;
+    pipeline.add(median); // MedianFilter3x3 from source to temporary
+    pipeline.add(convolution); // Convolution3x3 from temporary to destination
+    pipeline();
+    </pre>
+
+    All the stages must have the same dimension and must not operate in place.
+    The transformations and images must outlive the pipeline.
+
+    @short Band-streaming transformation pipeline.
+    @ingroup transformations
+    @version 1.0
+  */
+  class _COM_AZURE_DEV__GIP__API Pipeline : public Object {
+  public:
+
+    /** The default cache size used to select the band height (L2 cache). */
+    static constexpr MemorySize DEFAULT_CACHE_SIZE = 256 * 1024;
+
+    /**
+      A stage of a pipeline.
+    */
+    class _COM_AZURE_DEV__GIP__API Stage {
+    public:
+
+      /**
+        Returns the dimension of the destination.
+      */
+      virtual Dimension getDimension() const noexcept = 0;
+
+      /**
+        Returns the number of source rows required above and below a
+        destination row.
+      */
+      virtual unsigned int getHalo() const noexcept = 0;
+
+      /**
+        Returns the number of bytes read and written per row.
+      */
+      virtual MemorySize getRowSize() const noexcept = 0;
+
+      /**
+        Calculates the specified region of the destination.
+      */
+      virtual void execute(const Region& region) = 0;
+
+      virtual ~Stage() noexcept {
+      }
+    };
+
+    /**
+      Stage executing a transformation which provides operator()(const Region&).
+    */
+    template<class TRANSFORMATION>
+    class TransformationStage : public Stage {
+    private:
+
+      typedef typename TRANSFORMATION::DestinationImage DestinationImage;
+      typedef typename TRANSFORMATION::SourceImage SourceImage;
+
+      TRANSFORMATION& transformation;
+      const unsigned int halo = 0;
+    public:
+
+      TransformationStage(TRANSFORMATION& _transformation, unsigned int _halo) noexcept
+        : transformation(_transformation), halo(_halo) {
+      }
+
+      Dimension getDimension() const noexcept {
+        return transformation.getDestination()->getDimension();
+      }
+
+      unsigned int getHalo() const noexcept {
+        return halo;
+      }
+
+      MemorySize getRowSize() const noexcept {
+        return static_cast<MemorySize>(transformation.getDestination()->getWidth()) *
+          (sizeof(typename DestinationImage::Pixel) + sizeof(typename SourceImage::Pixel));
+      }
+
+      void execute(const Region& region) {
+        transformation(region);
+      }
+    };
+
+    /**
+      Stage applying a unary operation to each pixel (see fillWithUnary()).
+    */
+    template<class DEST, class SRC, class UNOPR>
+    class PointStage : public Stage {
+    private:
+
+      DEST& destination;
+      const SRC& source;
+      UNOPR function;
+    public:
+
+      PointStage(DEST& _destination, const SRC& _source, const UNOPR& _function)
+        : destination(_destination), source(_source), function(_function) {
+        bassert(
+          destination.getDimension() == source.getDimension(),
+          ImageException("Images must have identical dimension")
+        );
+      }
+
+      Dimension getDimension() const noexcept {
+        return destination.getDimension();
+      }
+
+      unsigned int getHalo() const noexcept {
+        return 0;
+      }
+
+      MemorySize getRowSize() const noexcept {
+        return static_cast<MemorySize>(destination.getWidth()) *
+          (sizeof(typename DEST::Pixel) + sizeof(typename SRC::Pixel));
+      }
+
+      void execute(const Region& region) {
+        typename DEST::Rows::RowIterator row = destination.getRows().getFirst();
+        typename SRC::ReadableRows::RowIterator srcRow = source.getRows().getFirst();
+        row += region.getOffset().getRow();
+        srcRow += region.getOffset().getRow();
+        for (unsigned int count = region.getDimension().getHeight(); count > 0; --count, ++row, ++srcRow) {
+          typename DEST::Rows::RowIterator::ElementIterator column = row.getFirst() + region.getOffset().getColumn();
+          typename SRC::ReadableRows::RowIterator::ElementIterator srcColumn =
+            srcRow.getFirst() + region.getOffset().getColumn();
+          const typename SRC::ReadableRows::RowIterator::ElementIterator end =
+            srcRow.getFirst() + region.getEndColumn();
+          for (; srcColumn != end; ++column, ++srcColumn) {
+            *column = function(*srcColumn);
+          }
+        }
+      }
+    };
+  private:
+
+    /** The stages in order of execution. */
+    Array<Stage*> stages;
+    /** The cache size used to select the band height. */
+    MemorySize cacheSize = DEFAULT_CACHE_SIZE;
+    /** The band height. 0 selects automatically. */
+    unsigned int bandHeight = 0;
+
+    /** Returns the halo of a transformation which calculates it (e.g. Convolution). */
+    template<class TRANSFORMATION>
+    static inline auto getHalo(const TRANSFORMATION& transformation, int) noexcept
+      -> decltype(transformation.getHalo()) {
+      return transformation.getHalo();
+    }
+
+    /** Returns the HALO declared by the transformation. */
+    template<class TRANSFORMATION>
+    static inline unsigned int getHalo(const TRANSFORMATION&, long) noexcept {
+      return TRANSFORMATION::HALO;
+    }
+
+    Pipeline(const Pipeline& copy) = delete;
+    Pipeline& operator=(const Pipeline& assign) = delete;
+  public:
+
+    /**
+      Initializes an empty pipeline.
+    */
+    Pipeline() noexcept;
+
+    /**
+      Appends the specified stage. The pipeline takes ownership of the stage.
+      Raises ImageException if the dimension differs from the dimension of
+      the previous stages.
+    */
+    void add(Stage* stage);
+
+    /**
+      Appends the specified transformation as a stage. The halo is given by
+      getHalo() of the transformation if available (e.g. Convolution) and
+      by the HALO of the transformation otherwise. Does not compile for a
+      transformation with neither.
+    */
+    template<class TRANSFORMATION>
+    inline void add(TRANSFORMATION& transformation) {
+      add(transformation, getHalo(transformation, 0));
+    }
+
+    /**
+      Appends the specified transformation as a stage.
+
+      @param transformation The transformation.
+      @param halo The number of source rows required above and below a row.
+    */
+    template<class TRANSFORMATION>
+    inline void add(TRANSFORMATION& transformation, unsigned int halo) {
+      add(new TransformationStage<TRANSFORMATION>(transformation, halo));
+    }
+
+    /**
+      Appends a stage which applies the specified operation to each pixel of
+      the source image and stores the result in the destination image.
+    */
+    template<class DEST, class SRC, class UNOPR>
+    inline void add(DEST& destination, const SRC& source, const UNOPR& function) {
+      add(new PointStage<DEST, SRC, UNOPR>(destination, source, function));
+    }
+
+    /**
+      Returns the number of stages.
+    */
+    inline MemorySize getNumberOfStages() const noexcept {
+      return stages.getSize();
+    }
+
+    /**
+      Sets the cache size used to select the band height automatically.
+    */
+    inline void setCacheSize(MemorySize cacheSize) noexcept {
+      this->cacheSize = cacheSize;
+    }
+
+    /**
+      Sets the band height. 0 selects the band height from the cache size.
+    */
+    inline void setBandHeight(unsigned int bandHeight) noexcept {
+      this->bandHeight = bandHeight;
+    }
+
+    /**
+      Returns the band height used for execution.
+    */
+    unsigned int getBandHeight() const noexcept;
+
+    /**
+      Executes the stages for the whole image.
+    */
+    void operator()();
+
+    /**
+      Releases the stages.
+    */
+    ~Pipeline() noexcept;
+  };
+
+}; // end of gip namespace
@@ -28,12 +28,19 @@ namespace gip {
   }
   
   template<class DEST, class SRC>
-  void Scale<DEST, SRC>::operator()() noexcept
-  {    
+  void Scale<DEST, SRC>::operator()(const Region& region) const
+  {
+    bassert(
+      region.isWithin(Transformation<DEST, SRC>::destination->getDimension()),
+      ImageException("Region must be within image", this)
+    );
     unsigned int rows = Transformation<DEST, SRC>::destination->getDimension().getHeight();
     unsigned int columns = Transformation<DEST, SRC>::destination->getDimension().getWidth();
     unsigned int srcRows = Transformation<DEST, SRC>::source->getDimension().getHeight();
     unsigned int srcColumns = Transformation<DEST, SRC>::source->getDimension().getWidth();
+    if (!region.isProper()) {
+      return;
+    }
     double rowRatio = static_cast<double>(srcRows)/rows;
     double columnRatio = static_cast<double>(srcColumns)/columns;
     
@@ -41,16 +48,25 @@ namespace gip {
     typename SourceImage::ReadableRows srcRowsLookup = Transformation<DEST, SRC>::source->getRows();
     
     typename DestinationImage::Rows::RowIterator row = rowsLookup.getFirst();
-    for (unsigned int rowIndex = 0; rowIndex < rows; ++rowIndex) {
+    row += region.getOffset().getRow();
+    for (unsigned int rowIndex = region.getOffset().getRow(); rowIndex < region.getEndRow(); ++rowIndex) {
       typename SourceImage::ReadableRows::RowIterator srcRow = srcRowsLookup[static_cast<unsigned int>(rowIndex * rowRatio)];
       
-      typename DestinationImage::Rows::RowIterator::ElementIterator column = row.getFirst();
-      for (unsigned int columnIndex = 0; columnIndex < columns; ++columnIndex) {
+      typename DestinationImage::Rows::RowIterator::ElementIterator column = row.getFirst() + region.getOffset().getColumn();
+      for (unsigned int columnIndex = region.getOffset().getColumn(); columnIndex < region.getEndColumn(); ++columnIndex) {
         *column = srcRow[static_cast<unsigned int>(columnIndex * columnRatio)];
         ++column;
       }
       ++row;
     }
   }
+
+  template<class DEST, class SRC>
+  void Scale<DEST, SRC>::operator()() const noexcept
+  {
+    static Metrics::Counter counter("Scale");
+    Metrics::Scope scope(counter, *Transformation<DEST, SRC>::destination, *Transformation<DEST, SRC>::source);
+    (*this)(Region(Point2D(0, 0), Transformation<DEST, SRC>::destination->getDimension()));
+  }
   
 }; // end of gip namespace
@@ -16,6 +16,8 @@
 #include <gip/gip.h>
 #include <gip/transformation/Transformation.h>
 #include <base/mem/Allocator.h>
+#include <base/math/Constants.h>
+#include <base/math/Math.h>
 
 namespace gip {
 
@@ -28,7 +30,12 @@ namespace gip {
     @version 1.0
   */
 
-  class _COM_AZURE_DEV__GIP__API StraightLineHoughTransformation : public Transformation<FloatImage, GrayImage> {
+  template<class SRC>
+  class BasicStraightLineHoughTransformation : public Transformation<FloatImage, SRC> {
+  public:
+
+    typedef typename Transformation<FloatImage, SRC>::DestinationImage DestinationImage;
+    typedef typename Transformation<FloatImage, SRC>::SourceImage SourceImage;
   private:
 
     struct Entry {
@@ -46,7 +53,7 @@ namespace gip {
       @param destination The destination image.
       @param source The source image.
     */
-    StraightLineHoughTransformation(DestinationImage* destination, const SourceImage* source);
+    BasicStraightLineHoughTransformation(DestinationImage* destination, const SourceImage* source);
 
     /**
       Calculate transformation.
@@ -54,4 +61,79 @@ namespace gip {
     void operator()() noexcept;
   };
 
+  template<class SRC>
+  BasicStraightLineHoughTransformation<SRC>::BasicStraightLineHoughTransformation(DestinationImage* destination, const SourceImage* source) 
+    : Transformation<DestinationImage, SourceImage>(destination, source) {
+    
+    bassert(
+      source->getDimension().isProper(),
+      ImageException("Source image has inproper dimension", this)
+    );
+    bassert(
+      destination->getDimension().isProper(),
+      ImageException("Destination image has inproper dimension", this)
+    );
+    
+    Dimension dimension = destination->getDimension();
+    lookup.setSize(dimension.getHeight());
+// TAG: relocateable ???
+// TAG: width % 2 == 1 ???
+    double deltaTheta = constant::PI/dimension.getHeight();
+    double inverseOfDeltaRho = dimension.getWidth() *
+      1/Math::sqrt(static_cast<double>(
+        static_cast<unsigned long long>(dimension.getHeight()) * dimension.getHeight() +
+        static_cast<unsigned long long>(dimension.getWidth()) * dimension.getWidth()
+      ));
+    Entry* dest = lookup.getElements();
+    const Entry* end = dest + dimension.getHeight();
+    unsigned int i = 0;
+    while (dest < end) {
+      double inner = i++ * deltaTheta;
+      dest->cosine = Math::cos(inner) * inverseOfDeltaRho;
+      dest->sine = Math::sin(inner) * inverseOfDeltaRho;
+      ++dest;
+    }
+  }
+
+  template<class SRC>
+  void BasicStraightLineHoughTransformation<SRC>::operator()() noexcept {
+    static Metrics::Counter counter("StraightLineHoughTransformation");
+    Metrics::Scope scope(counter, *Transformation<FloatImage, SRC>::destination, *Transformation<FloatImage, SRC>::source);
+    const unsigned int height = Transformation<FloatImage, SRC>::destination->getDimension().getHeight();
+    const unsigned int width = Transformation<FloatImage, SRC>::destination->getDimension().getWidth();
+    const double halfWidth = width * 0.5;
+    const Entry* endOfTrigo = lookup.getElements() + height;
+    const int halfSrcHeight = Transformation<FloatImage, SRC>::source->getDimension().getHeight()/2;
+    const int halfSrcWidth = Transformation<FloatImage, SRC>::source->getDimension().getWidth()/2;
+
+    const MemorySize pitch = Transformation<FloatImage, SRC>::destination->getPitch();
+    typename DestinationImage::Pixel* dest = Transformation<FloatImage, SRC>::destination->getElements();
+    fill<typename DestinationImage::Pixel>(dest, pitch * height, 0); // reset (including padding)
+    
+    typename SourceImage::ReadableRows srcRowLookup = Transformation<FloatImage, SRC>::source->getRows();
+    typename SourceImage::ReadableRows::RowIterator srcRow = srcRowLookup.getFirst();
+    for (int y = -halfSrcHeight; srcRow != srcRowLookup.getEnd(); ++srcRow, ++y) { // traverse all rows
+      typename SourceImage::ReadableRows::RowIterator::ElementIterator srcColumn = srcRow.getFirst();
+      // TAG: we can precalc y * src->sine here for all theta
+      for (int x = -halfSrcWidth; srcColumn != srcRow.getEnd(); ++srcColumn, ++x) { // traverse all columns of current row
+        // TAG: need predicate support - see functor header
+        if (*srcColumn) {
+          const Entry* trigo = lookup.getElements();
+          typename DestinationImage::Pixel* destRow = dest;
+          for (int theta = 0; trigo < endOfTrigo; ++trigo, ++theta, destRow += pitch) { // vote for lines
+            int rho = static_cast<int>(x * trigo->cosine + y * trigo->sine + halfWidth);
+            BASSERT(static_cast<unsigned int>(rho) < width);
+            BASSERT(rho >= 0);
+            ++destRow[rho]; // TAG: alternatively use gradient as weight
+          }
+        }
+      }
+    }
+  }
+
+  /** Straight line Hough transformation of gray images. */
+  typedef BasicStraightLineHoughTransformation<GrayImage> StraightLineHoughTransformation;
+  /** Straight line Hough transformation of compact 8-bit gray images. */
+  typedef BasicStraightLineHoughTransformation<Gray8Image> Gray8StraightLineHoughTransformation;
+
 }; // end of gip namespace
@@ -16,6 +16,7 @@
 #include <gip/transformation/Transformation.h>
 #include <gip/ArrayImage.h>
 #include <gip/operation/Interpolate.h>
+#include <gip/ImageException.h>
 
 namespace gip {
 
@@ -105,10 +106,22 @@ namespace gip {
       matrix[1][2] += dy;
     }
 
-    void operator()() noexcept {
-      const unsigned int height = Transformation<DestinationImage, SourceImage>::destination->getDimension().getHeight();
-      const unsigned int width = Transformation<DestinationImage, SourceImage>::destination->getDimension().getWidth();
-      Pixel* dest = Transformation<DestinationImage, SourceImage>::destination->getElements();
+    /**
+      Calculates the specified region of the destination image. Any row of
+      the source image may be read. Thus the transformation has no HALO and
+      may only be added to a Pipeline as the first stage with an explicit
+      halo of 0.
+    */
+    void operator()(const Region& region) const {
+      bassert(region.isWithin(Transformation<DestinationImage, SourceImage>::destination->getDimension()), ImageException(this));
+      if (!region.isProper()) {
+        return;
+      }
+      const unsigned int pitch = Transformation<DestinationImage, SourceImage>::destination->getPitch();
+      const unsigned int firstColumn = region.getOffset().getColumn();
+      const unsigned int width = region.getDimension().getWidth();
+      Pixel* dest = Transformation<DestinationImage, SourceImage>::destination->getElements() +
+        static_cast<MemorySize>(region.getOffset().getRow()) * pitch + firstColumn;
       Interpolate<Pixel> interpolate(*Transformation<DestinationImage, SourceImage>::source);
     
       // inverse of matrix (only x and y row)
@@ -122,17 +135,25 @@ namespace gip {
       inverse[1][1] = matrix[0][0] * factor;
       inverse[1][2] = (matrix[0][2] * matrix[1][0] - matrix[0][0] * matrix[1][2]) * factor;
     
-      for (unsigned int y = 0; y < height; ++y) {
-        double srcX = inverse[0][1] * y + inverse[0][2];
-        double srcY = inverse[1][1] * y + inverse[1][2];
+      for (unsigned int y = region.getOffset().getRow(); y < region.getEndRow(); ++y) {
+        double srcX = inverse[0][1] * y + inverse[0][2] + inverse[0][0] * firstColumn;
+        double srcY = inverse[1][1] * y + inverse[1][2] + inverse[1][0] * firstColumn;
+        Pixel* column = dest;
         for (unsigned int x = 0; x < width; ++x) {
           srcX += inverse[0][0];
           srcY += inverse[1][0];
-          *dest++ = static_cast<Pixel>(interpolate(srcX, srcY)); // TAG: round to nearest
+          *column++ = static_cast<Pixel>(interpolate(srcX, srcY)); // TAG: round to nearest
         }
+        dest += pitch;
       }
     }
 
+    void operator()() const noexcept {
+      static Metrics::Counter counter("TSRTransformation");
+      Metrics::Scope scope(counter, *Transformation<DestinationImage, SourceImage>::destination, *Transformation<DestinationImage, SourceImage>::source);
+      (*this)(Region(Point2D(0, 0), Transformation<DestinationImage, SourceImage>::destination->getDimension()));
+    }
+
   };
 
 }; // end of gip namespace
@@ -20,7 +20,10 @@ namespace gip {
   }
 
   void Test::operator()() noexcept {
+    static Metrics::Counter counter("Test");
+    Metrics::Scope scope(counter, *destination);
     ColorPixel* element = destination->getElements();
+    const unsigned int padding = destination->getPitch() - destination->getDimension().getWidth();
 
     Canvas canvas(destination);
     canvas.rectangle(Point(0, 0), Point(destination->getDimension().getWidth() - 1, destination->getDimension().getHeight() - 1), makeColorPixel(48, 32, 128), Canvas::FILL);
@@ -33,6 +36,7 @@ namespace gip {
         temp.red = ((column + row) % 0xff);
         *element++ = temp;
       }
+      element += padding;
     }
   }
 
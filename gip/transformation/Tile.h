@@ -50,6 +50,8 @@ namespace gip {
 
   template<class DEST, class SRC>
   void Tile<DEST, SRC>::operator()() noexcept {
+    static Metrics::Counter counter("Tile");
+    Metrics::Scope scope(counter, *Transformation<DEST, SRC>::destination, *Transformation<DEST, SRC>::source);
     Dimension dimension = Transformation<DEST, SRC>::destination->getDimension();
     if (!dimension.isProper()) {
       return; // nothing to do
@@ -0,0 +1,123 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#pragma once
+
+#include <gip/transformation/Transformation.h>
+#include <gip/ArrayImage.h>
+#include <gip/TiledImage.h>
+
+namespace gip {
+
+  /**
+    Copies an array image into the tiles of a tiled image. The padding of the
+    edge tiles is not initialized.
+
+    @short Array to tiled image conversion.
+    @ingroup transformations
+    @see Untiling
+    @version 1.0
+  */
+
+  template<class PIXEL, unsigned int TILE_SIZE = 64>
+  class Tiling : public Transformation<TiledImage<PIXEL, TILE_SIZE>, ArrayImage<PIXEL> > {
+  public:
+
+    typedef Transformation<TiledImage<PIXEL, TILE_SIZE>, ArrayImage<PIXEL> > Base;
+    typedef typename Base::DestinationImage DestinationImage;
+    typedef typename Base::SourceImage SourceImage;
+
+    /**
+      Initializes the transformation.
+
+      @param destination The destination image.
+      @param source The source image.
+    */
+    Tiling(DestinationImage* destination, const SourceImage* source)
+      : Base(destination, source) {
+      bassert(destination->getDimension() == source->getDimension(), ImageException(this));
+    }
+
+    void operator()() {
+      static Metrics::Counter counter("Tiling");
+      Metrics::Scope scope(counter, *Base::destination, *Base::source);
+      const MemorySize pitch = Base::source->getPitch();
+      const PIXEL* elements = Base::source->getElements();
+      typename DestinationImage::TileIterator end = Base::destination->getEndOfTiles();
+      for (typename DestinationImage::TileIterator tile = Base::destination->getTiles(); tile != end; ++tile) {
+        const Point2D offset = tile.getOffset();
+        const Dimension dimension = tile.getDimension();
+        const PIXEL* src = elements + static_cast<MemorySize>(offset.getRow()) * pitch + offset.getColumn();
+        PIXEL* dest = tile.getElements();
+        for (unsigned int row = 0; row < dimension.getHeight(); ++row) {
+          for (unsigned int column = 0; column < dimension.getWidth(); ++column) {
+            dest[column] = src[column];
+          }
+          src += pitch;
+          dest += TILE_SIZE;
+        }
+      }
+    }
+  };
+
+  /**
+    Copies the tiles of a tiled image into an array image.
+
+    @short Tiled to array image conversion.
+    @ingroup transformations
+    @see Tiling
+    @version 1.0
+  */
+
+  template<class PIXEL, unsigned int TILE_SIZE = 64>
+  class Untiling : public Transformation<ArrayImage<PIXEL>, TiledImage<PIXEL, TILE_SIZE> > {
+  public:
+
+    typedef Transformation<ArrayImage<PIXEL>, TiledImage<PIXEL, TILE_SIZE> > Base;
+    typedef typename Base::DestinationImage DestinationImage;
+    typedef typename Base::SourceImage SourceImage;
+
+    /**
+      Initializes the transformation.
+
+      @param destination The destination image.
+      @param source The source image.
+    */
+    Untiling(DestinationImage* destination, const SourceImage* source)
+      : Base(destination, source) {
+      bassert(destination->getDimension() == source->getDimension(), ImageException(this));
+    }
+
+    void operator()() {
+      static Metrics::Counter counter("Untiling");
+      Metrics::Scope scope(counter, *Base::destination, *Base::source);
+      const MemorySize pitch = Base::destination->getPitch();
+      PIXEL* elements = Base::destination->getElements();
+      typename SourceImage::ReadableTileIterator end = Base::source->getEndOfTiles();
+      for (typename SourceImage::ReadableTileIterator tile = Base::source->getTiles(); tile != end; ++tile) {
+        const Point2D offset = tile.getOffset();
+        const Dimension dimension = tile.getDimension();
+        const PIXEL* src = tile.getElements();
+        PIXEL* dest = elements + static_cast<MemorySize>(offset.getRow()) * pitch + offset.getColumn();
+        for (unsigned int row = 0; row < dimension.getHeight(); ++row) {
+          for (unsigned int column = 0; column < dimension.getWidth(); ++column) {
+            dest[column] = src[column];
+          }
+          src += TILE_SIZE;
+          dest += pitch;
+        }
+      }
+    }
+  };
+
+}; // end of gip namespace
@@ -15,6 +15,8 @@
 
 #include <base/Object.h>
 #include <gip/ArrayImage.h>
+#include <gip/Region.h>
+#include <gip/Metrics.h>
 
 namespace gip {
 
@@ -52,6 +54,20 @@ namespace gip {
     Transformation(
       DestinationImage* destination,
       const SourceImage* source) noexcept;
+
+    /**
+      Returns the destination image.
+    */
+    inline DestinationImage* getDestination() const noexcept {
+      return destination;
+    }
+
+    /**
+      Returns the source image.
+    */
+    inline const SourceImage* getSource() const noexcept {
+      return source;
+    }
   };
 
   template<class DEST, class SRC>
@@ -15,6 +15,7 @@
 
 #include <gip/transformation/Transformation.h>
 #include <gip/Functor.h>
+#include <gip/TiledImage.h>
 
 namespace gip {
 
@@ -56,6 +57,8 @@ namespace gip {
 
   template<class DEST, class SRC>
   void Transpose<DEST, SRC>::operator()() noexcept {
+    static Metrics::Counter counter("Transpose");
+    Metrics::Scope scope(counter, *Transformation<DEST, SRC>::destination, *Transformation<DEST, SRC>::source);
     if (!Transformation<DEST, SRC>::destination->getDimension().isProper()) {
       return; // nothing to do
     }
@@ -71,4 +74,56 @@ namespace gip {
     }
   }
 
+  /**
+    Transposes a tiled image. Each tile is transposed into the mirrored tile
+    of the destination with both tiles held in cache. The source tiles are
+    read in storage order.
+
+    @short Transpose of tiled image.
+    @ingroup transformations geometric
+    @version 1.0
+  */
+
+  template<class PIXEL, unsigned int TILE_SIZE>
+  class Transpose<TiledImage<PIXEL, TILE_SIZE>, TiledImage<PIXEL, TILE_SIZE> >
+    : public Transformation<TiledImage<PIXEL, TILE_SIZE>, TiledImage<PIXEL, TILE_SIZE> > {
+  public:
+
+    typedef Transformation<TiledImage<PIXEL, TILE_SIZE>, TiledImage<PIXEL, TILE_SIZE> > Base;
+    typedef typename Base::DestinationImage DestinationImage;
+    typedef typename Base::SourceImage SourceImage;
+
+    /**
+      Initializes transformation object.
+    */
+    Transpose(DestinationImage* destination, const SourceImage* source)
+      : Base(destination, source) {
+      bassert(
+        (destination->getDimension().getWidth() == source->getDimension().getHeight()) &&
+        (destination->getDimension().getHeight() == source->getDimension().getWidth()),
+        ImageException("Incompatible dimensions", this)
+      );
+    }
+
+    /**
+      Transpose the image.
+    */
+    void operator()() {
+      static Metrics::Counter counter("Transpose");
+      Metrics::Scope scope(counter, *Base::destination, *Base::source);
+      typename SourceImage::ReadableTileIterator end = Base::source->getEndOfTiles();
+      for (typename SourceImage::ReadableTileIterator tile = Base::source->getTiles(); tile != end; ++tile) {
+        const Point2D& position = tile.getTilePosition();
+        const Dimension dimension = tile.getDimension();
+        const PIXEL* src = tile.getElements();
+        PIXEL* dest = Base::destination->getTile(position.getColumn(), position.getRow());
+        for (unsigned int row = 0; row < dimension.getHeight(); ++row) {
+          for (unsigned int column = 0; column < dimension.getWidth(); ++column) {
+            dest[column * TILE_SIZE + row] = src[row * TILE_SIZE + column];
+          }
+        }
+      }
+    }
+  };
+
 }; // end of gip namespace
@@ -15,6 +15,7 @@
 
 #include <base/Object.h>
 #include <gip/gip.h>
+#include <gip/Metrics.h>
 
 namespace gip {
 
@@ -55,6 +55,8 @@ namespace gip {
   }
 
   void WalshTransformation::operator()() noexcept {
+    static Metrics::Counter counter("WalshTransformation");
+    Metrics::Scope scope(counter, *destination, *source);
 
     unsigned int rows = source->getHeight();
     unsigned int columns = source->getWidth();
@@ -104,15 +106,17 @@ namespace gip {
 
     // Walsh transformation column by column
     {
+      const MemorySize pitch = destination->getPitch();
+      const MemorySize size = pitch * rows;
       DestinationImage::Pixel* column = destination->getElements();
       const DestinationImage::Pixel* endColumn = column + columns;
-      const DestinationImage::Pixel* endPoint = column + columns * rows;
+      const DestinationImage::Pixel* endPoint = column + size;
       for (; column < endColumn; ++column) {
-        for (unsigned int halfStep = columns; halfStep < columns * rows; halfStep <<= 1) {
-          unsigned int fullStep = halfStep << 1;
+        for (MemorySize halfStep = pitch; halfStep < size; halfStep <<= 1) {
+          const MemorySize fullStep = halfStep << 1;
           DestinationImage::Pixel* offset = column;
           const DestinationImage::Pixel* endOffset = offset + halfStep;
-          for (; offset < endOffset; offset += columns) {
+          for (; offset < endOffset; offset += pitch) {
             DestinationImage::Pixel* evenBlockPoint = offset;
             DestinationImage::Pixel* oddBlockPoint = offset + halfStep;
             while (evenBlockPoint < endPoint) {
@@ -0,0 +1,118 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework (Test Suite)
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#pragma once
+
+#include <gip/ArrayImage.h>
+#include <gip/PlanarRGBImage.h>
+#include <gip/TiledImage.h>
+#include <gip/transformation/Interleave.h>
+#include <gip/transformation/Tiling.h>
+#include <base/math/Complex.h>
+
+/**
+  Reproducible images and comparisons shared by the test applications and
+  the benchmark. The noise is a multiplicative hash of the pixel index
+  (row * width + column) so the pixels do not depend on the row pitch.
+*/
+class Synthetic {
+public:
+
+  /** Returns the noise value of the specified pixel index. */
+  static inline gip::uint32 getValue(gip::MemorySize index) noexcept {
+    return static_cast<gip::uint32>(index * 2654435761U);
+  }
+
+  static inline void set(gip::Gray8Pixel& pixel, gip::uint32 value) noexcept {
+    pixel = static_cast<gip::Gray8Pixel>(value >> 24);
+  }
+
+  static inline void set(gip::GrayPixel& pixel, gip::uint32 value) noexcept {
+    pixel = static_cast<gip::GrayPixel>(value >> 24);
+  }
+
+  static inline void set(gip::ColorPixel& pixel, gip::uint32 value) noexcept {
+    pixel = gip::makeColorPixel(value >> 24, (value >> 16) & 0xff, (value >> 8) & 0xff);
+  }
+
+  static inline void set(float& pixel, gip::uint32 value) noexcept {
+    pixel = static_cast<float>(value >> 24)/255;
+  }
+
+  static inline void set(gip::Complex<float>& pixel, gip::uint32 value) noexcept {
+    pixel = gip::Complex<float>(static_cast<float>(value >> 24)/255, 0);
+  }
+
+  /** Fills the visible pixels of the image with noise. */
+  template<class PIXEL>
+  static void fill(gip::ArrayImage<PIXEL>& image) {
+    const unsigned int width = image.getWidth();
+    const gip::MemorySize pitch = image.getPitch();
+    PIXEL* elements = image.getElements();
+    for (unsigned int row = 0; row < image.getHeight(); ++row) {
+      PIXEL* dest = elements + row * pitch;
+      const gip::MemorySize first = static_cast<gip::MemorySize>(row) * width;
+      for (unsigned int column = 0; column < width; ++column) {
+        set(dest[column], getValue(first + column));
+      }
+    }
+  }
+
+  template<class PIXEL, unsigned int TILE_SIZE>
+  static void fill(gip::TiledImage<PIXEL, TILE_SIZE>& image) {
+    gip::ArrayImage<PIXEL> source(image.getDimension());
+    fill(source);
+    gip::Tiling<PIXEL, TILE_SIZE> tiling(&image, &source);
+    tiling();
+  }
+
+  template<class COMPONENT>
+  static void fill(gip::PlanarRGBImage<COMPONENT>& image) {
+    gip::ArrayImage<gip::RGBPixel<COMPONENT> > source(image.getDimension());
+    fill(source);
+    gip::Deinterleave<COMPONENT> deinterleave(&image, &source);
+    deinterleave();
+  }
+
+  template<class PIXEL>
+  static inline bool isEqual(const PIXEL& left, const PIXEL& right) noexcept {
+    return left == right;
+  }
+
+  template<class COMPONENT>
+  static inline bool isEqual(
+    const gip::RGBPixel<COMPONENT>& left,
+    const gip::RGBPixel<COMPONENT>& right) noexcept {
+    return (left.red == right.red) && (left.green == right.green) && (left.blue == right.blue);
+  }
+
+  /** Returns true if the images have the same dimension and identical visible pixels. */
+  template<class PIXEL>
+  static bool isEqual(
+    const gip::ArrayImage<PIXEL>& a,
+    const gip::ArrayImage<PIXEL>& b) noexcept {
+    if (!(a.getDimension() == b.getDimension())) {
+      return false;
+    }
+    for (unsigned int row = 0; row < a.getHeight(); ++row) {
+      const PIXEL* left = a.getElements() + static_cast<gip::MemorySize>(row) * a.getPitch();
+      const PIXEL* right = b.getElements() + static_cast<gip::MemorySize>(row) * b.getPitch();
+      for (unsigned int column = 0; column < a.getWidth(); ++column) {
+        if (!isEqual(left[column], right[column])) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+};
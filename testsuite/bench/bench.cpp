@@ -0,0 +1,786 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework (Benchmark)
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#include <gip/build.h>
+#include <gip/ArrayImage.h>
+#include <gip/PlanarRGBImage.h>
+#include <gip/TiledImage.h>
+#include <gip/io/BMPEncoder.h>
+#include <gip/io/JPEGEncoder.h>
+#include <gip/io/PCXEncoder.h>
+#include <gip/io/PGMEncoder.h>
+#include <gip/io/PNGEncoder.h>
+#include <gip/io/PPMEncoder.h>
+#include <gip/io/RASEncoder.h>
+#include <gip/io/TGAEncoder.h>
+#include <gip/transformation/BoxFilter.h>
+#include <gip/transformation/BresenhamScale.h>
+#include <gip/transformation/ContrastStretch.h>
+#include <gip/transformation/Convert.h>
+#include <gip/transformation/Convolution.h>
+#include <gip/transformation/Convolution3x3.h>
+#include <gip/transformation/Crop.h>
+#include <gip/transformation/Dilate.h>
+#include <gip/transformation/DiscreteCosineTransformation.h>
+#include <gip/transformation/Duplicate.h>
+#include <gip/transformation/EqualizeHistogram.h>
+#include <gip/transformation/Erode.h>
+#include <gip/transformation/Flip.h>
+#include <gip/transformation/FourierExchange.h>
+#include <gip/transformation/FourierTransformation.h>
+#include <gip/transformation/GaussianBlur.h>
+#include <gip/transformation/Gradient.h>
+#include <gip/transformation/HaarTransformation.h>
+#include <gip/transformation/Interleave.h>
+#include <gip/transformation/LinearScale.h>
+#include <gip/transformation/MedianFilter3x3.h>
+#include <gip/transformation/Mirror.h>
+#include <gip/transformation/Noise.h>
+#include <gip/transformation/Scale.h>
+#include <gip/transformation/StraightLineHoughTransformation.h>
+#include <gip/transformation/TSRTransformation.h>
+#include <gip/transformation/Test.h>
+#include <gip/transformation/Tile.h>
+#include <gip/transformation/Tiling.h>
+#include <gip/transformation/Transpose.h>
+#include <gip/transformation/WalshTransformation.h>
+#include <base/Application.h>
+#include <base/UnsignedInteger.h>
+#include <base/Timer.h>
+#include <base/collection/Array.h>
+#include <base/filesystem/FileSystem.h>
+#include <base/io/File.h>
+#include <base/string/FormatOutputStream.h>
+#include <testsuite/Synthetic.h>
+
+using namespace com::azure::dev::gip;
+
+/**
+  Benchmark of the transformations and the image encoders. The images are
+  synthetic (reproducible noise) so no input files are required. Each case
+  is run for a number of warmup iterations followed by the timed
+  repetitions. The results are written to the standard output as CSV or
+  JSON with the median and the 95th percentile of the elapsed time and the
+  throughput at the median.
+
+  Usage: gip_bench [--size vga|1080p|4k|8k]... [--warmup N]
+    [--repetitions N] [--filter TEXT] [--directory PATH] [--json]
+*/
+class BenchmarkApplication : public Application {
+private:
+
+  static const unsigned int MAJOR_VERSION = 1;
+  static const unsigned int MINOR_VERSION = 0;
+public:
+
+  /** Dimension of the images of a case relative to the benchmark size. */
+  enum Shape {
+    SAME, /**< Destination and source have the benchmark size. */
+    HALF_DESTINATION, /**< The destination has half the width and height. */
+    HALF_SOURCE, /**< The source has half the width and height. */
+    TRANSPOSED, /**< The destination is transposed. */
+    POWER_OF_TWO /**< Both are rounded down to powers of two. */
+  };
+
+  /** A benchmark case. The images are allocated by prepare() and are not timed. */
+  class Case {
+  public:
+
+    /** The name of the operation. */
+    const char* name = nullptr;
+    /** The pixel type. */
+    const char* type = nullptr;
+    /** The dimension of the images. */
+    Shape shape = SAME;
+    /** The maximum number of pixels to run the case for (0 for any). */
+    MemorySize maximumPixels = 0;
+
+    Case(const char* _name, const char* _type, Shape _shape, MemorySize _maximumPixels) noexcept
+      : name(_name), type(_type), shape(_shape), maximumPixels(_maximumPixels) {
+    }
+
+    /** Returns the dimension of the source image. */
+    Dimension getSourceDimension(const Dimension& dimension) const noexcept {
+      switch (shape) {
+      case HALF_SOURCE:
+        return Dimension(dimension.getWidth()/2, dimension.getHeight()/2);
+      case POWER_OF_TWO:
+        return Dimension(getPowerOf2(dimension.getWidth()), getPowerOf2(dimension.getHeight()));
+      default:
+        return dimension;
+      }
+    }
+
+    /** Returns the dimension of the destination image. */
+    Dimension getDestinationDimension(const Dimension& dimension) const noexcept {
+      switch (shape) {
+      case HALF_DESTINATION:
+        return Dimension(dimension.getWidth()/2, dimension.getHeight()/2);
+      case TRANSPOSED:
+        return Dimension(dimension.getHeight(), dimension.getWidth());
+      case POWER_OF_TWO:
+        return Dimension(getPowerOf2(dimension.getWidth()), getPowerOf2(dimension.getHeight()));
+      default:
+        return dimension;
+      }
+    }
+
+    /** Returns the largest power of 2 not exceeding the value. */
+    static unsigned int getPowerOf2(unsigned int value) noexcept {
+      unsigned int result = 1;
+      while ((result << 1) <= value) {
+        result <<= 1;
+      }
+      return result;
+    }
+
+    /** Allocates and fills the images. */
+    virtual void prepare(const Dimension& dimension) = 0;
+
+    /** Runs the operation once. */
+    virtual void run() = 0;
+
+    /** Returns the number of pixels processed per run. */
+    virtual uint64 getPixels() const noexcept = 0;
+
+    /** Returns the number of bytes read and written per run. */
+    virtual uint64 getBytes() const noexcept = 0;
+
+    /** Releases the images. */
+    virtual void release() noexcept = 0;
+
+    virtual ~Case() noexcept {
+    }
+  };
+
+  /** Transformation from a source image to a destination image. */
+  template<class DEST, class SRC, class FUNCTION>
+  class BinaryCase : public Case {
+  private:
+
+    FUNCTION function;
+    DEST* destination = nullptr;
+    SRC* source = nullptr;
+  public:
+
+    BinaryCase(const char* name, const char* type, Shape shape, MemorySize maximumPixels, FUNCTION _function)
+      : Case(name, type, shape, maximumPixels), function(_function) {
+    }
+
+    void prepare(const Dimension& dimension) {
+      release();
+      destination = new DEST(getDestinationDimension(dimension));
+      source = new SRC(getSourceDimension(dimension));
+      Synthetic::fill(*destination); // avoid first touch in timed runs
+      Synthetic::fill(*source);
+    }
+
+    void run() {
+      function(*destination, *source);
+    }
+
+    uint64 getPixels() const noexcept {
+      return destination->getNumberOfPixels();
+    }
+
+    uint64 getBytes() const noexcept {
+      return static_cast<uint64>(destination->getNumberOfPixels()) * sizeof(typename DEST::Pixel) +
+        static_cast<uint64>(source->getNumberOfPixels()) * sizeof(typename SRC::Pixel);
+    }
+
+    void release() noexcept {
+      delete destination;
+      destination = nullptr;
+      delete source;
+      source = nullptr;
+    }
+
+    ~BinaryCase() noexcept {
+      release();
+    }
+  };
+
+  /** Transformation which updates an image in place. */
+  template<class IMAGE, class FUNCTION>
+  class UnaryCase : public Case {
+  private:
+
+    FUNCTION function;
+    IMAGE* image = nullptr;
+  public:
+
+    UnaryCase(const char* name, const char* type, Shape shape, MemorySize maximumPixels, FUNCTION _function)
+      : Case(name, type, shape, maximumPixels), function(_function) {
+    }
+
+    void prepare(const Dimension& dimension) {
+      release();
+      image = new IMAGE(getDestinationDimension(dimension));
+      Synthetic::fill(*image);
+    }
+
+    void run() {
+      function(*image);
+    }
+
+    uint64 getPixels() const noexcept {
+      return image->getNumberOfPixels();
+    }
+
+    uint64 getBytes() const noexcept {
+      return 2 * static_cast<uint64>(image->getNumberOfPixels()) * sizeof(typename IMAGE::Pixel);
+    }
+
+    void release() noexcept {
+      delete image;
+      image = nullptr;
+    }
+
+    ~UnaryCase() noexcept {
+      release();
+    }
+  };
+
+  /** Encoding or decoding of a file. */
+  template<class ENCODER, class IMAGE>
+  class EncoderCase : public Case {
+  public:
+
+    enum Mode {READ, WRITE};
+  private:
+
+    ENCODER encoder;
+    Mode mode = READ;
+    String path;
+    IMAGE* image = nullptr;
+
+    inline void write(const ColorImage& image) {
+      encoder.write(path, &image);
+    }
+
+    inline void write(const GrayImage& image) {
+      encoder.writeGray(path, &image);
+    }
+  public:
+
+    EncoderCase(const char* name, const char* type, Mode _mode, const String& directory)
+      : Case(name, type, SAME, 0), mode(_mode) {
+      path = directory + MESSAGE("/gip_bench.") + encoder.getDefaultExtension();
+    }
+
+    void prepare(const Dimension& dimension) {
+      release();
+      image = new IMAGE(dimension);
+      Synthetic::fill(*image);
+      write(*image);
+      bassert(File(path, File::READ, 0).getSize() > 0, ImageException("Encoder did not write file"));
+      if (mode == READ) {
+        ColorImage* decoded = encoder.read(path);
+        bassert(decoded, ImageException("Encoder did not read file"));
+        delete decoded;
+      }
+    }
+
+    void run() {
+      if (mode == READ) {
+        delete encoder.read(path);
+      } else {
+        write(*image);
+      }
+    }
+
+    uint64 getPixels() const noexcept {
+      return image->getNumberOfPixels();
+    }
+
+    uint64 getBytes() const noexcept {
+      return static_cast<uint64>(image->getNumberOfPixels()) * sizeof(typename IMAGE::Pixel);
+    }
+
+    void release() noexcept {
+      if (image) {
+        delete image;
+        image = nullptr;
+        try {
+          FileSystem::removeFile(path);
+        } catch (...) {
+        }
+      }
+    }
+
+    ~EncoderCase() noexcept {
+      release();
+    }
+  };
+
+  /** Kernel of 3x3 ones. */
+  class Box3x3 {
+  public:
+
+    enum {
+      M00 = true, M01 = true, M02 = true,
+      M10 = true, M11 = true, M12 = true,
+      M20 = true, M21 = true, M22 = true
+    };
+  };
+
+  /** The result of a case for one size. */
+  class Result {
+  public:
+
+    const Case* benchmark = nullptr;
+    Dimension dimension;
+    unsigned int repetitions = 0;
+    uint64 median = 0;
+    uint64 p95 = 0;
+    double megapixelsPerSecond = 0;
+    double megabytesPerSecond = 0;
+  };
+private:
+
+  Array<Case*> cases;
+  Array<Dimension> dimensions;
+  unsigned int warmup = 2;
+  unsigned int repetitions = 11;
+  String filter;
+  String directory = MESSAGE(".");
+  bool json = false;
+
+  template<class DEST, class SRC, class FUNCTION>
+  void add(const char* name, const char* type, FUNCTION function, Shape shape = SAME, MemorySize maximumPixels = 0) {
+    cases.append(new BinaryCase<DEST, SRC, FUNCTION>(name, type, shape, maximumPixels, function));
+  }
+
+  template<class IMAGE, class FUNCTION>
+  void addUnary(const char* name, const char* type, FUNCTION function, Shape shape = SAME) {
+    cases.append(new UnaryCase<IMAGE, FUNCTION>(name, type, shape, 0, function));
+  }
+
+  template<class ENCODER, class IMAGE>
+  void addEncoder(const char* name, const char* type, typename EncoderCase<ENCODER, IMAGE>::Mode mode) {
+    cases.append(new EncoderCase<ENCODER, IMAGE>(name, type, mode, directory));
+  }
+
+  template<class ENCODER>
+  void addEncoder(const char* read, const char* write) {
+    if (read) {
+      addEncoder<ENCODER, ColorImage>(read, "color", EncoderCase<ENCODER, ColorImage>::READ);
+    }
+    addEncoder<ENCODER, ColorImage>(write, "color", EncoderCase<ENCODER, ColorImage>::WRITE);
+  }
+public:
+
+  BenchmarkApplication() noexcept
+    : Application(MESSAGE("gip_bench")) {
+  }
+
+  void registerTransformations() {
+    const MemorySize VGA = 640 * 480;
+
+    add<Gray8Image, Gray8Image>("BoxFilter", "gray8", [](Gray8Image& d, const Gray8Image& s) {
+      BoxFilter<Gray8Image> t(&d, &s, 8); t();
+    });
+    add<ColorImage, ColorImage>("BoxFilter", "color", [](ColorImage& d, const ColorImage& s) {
+      BoxFilter<ColorImage> t(&d, &s, 8); t();
+    });
+
+    add<ColorImage, ColorImage>("BresenhamScale", "color", [](ColorImage& d, const ColorImage& s) {
+      BresenhamScale<ColorImage, ColorImage> t(&d, &s); t();
+    }, HALF_DESTINATION);
+    add<GrayImage, GrayImage>("BresenhamScale", "gray", [](GrayImage& d, const GrayImage& s) {
+      BresenhamScale<GrayImage, GrayImage> t(&d, &s); t();
+    }, HALF_DESTINATION);
+
+    add<Gray8Image, Gray8Image>("ContrastStretch", "gray8", [](Gray8Image& d, const Gray8Image& s) {
+      ContrastStretch<Gray8Image, Gray8Image> t(&d, &s); t();
+    });
+    add<GrayImage, GrayImage>("ContrastStretch", "gray", [](GrayImage& d, const GrayImage& s) {
+      ContrastStretch<GrayImage, GrayImage> t(&d, &s); t();
+    });
+    add<ColorImage, ColorImage>("ContrastStretch", "color", [](ColorImage& d, const ColorImage& s) {
+      ContrastStretch<ColorImage, ColorImage> t(&d, &s); t();
+    });
+
+    add<GrayImage, ColorImage>("Convert/RGBToGray", "color", [](GrayImage& d, const ColorImage& s) {
+      Convert<GrayImage, ColorImage, RGBToGray> t(&d, &s, RGBToGray()); t();
+    });
+    add<FloatImage, ColorImage>("Convert/RGBToFloat", "color", [](FloatImage& d, const ColorImage& s) {
+      Convert<FloatImage, ColorImage, RGBToFloat> t(&d, &s, RGBToFloat()); t();
+    });
+    add<FloatImage, GrayImage>("Convert/GrayToFloat", "gray", [](FloatImage& d, const GrayImage& s) {
+      Convert<FloatImage, GrayImage, GrayToFloat> t(&d, &s, GrayToFloat()); t();
+    });
+    add<GrayImage, FloatImage>("Convert/FloatToGray", "float", [](GrayImage& d, const FloatImage& s) {
+      Convert<GrayImage, FloatImage, FloatToGray> t(&d, &s, FloatToGray()); t();
+    });
+    add<ComplexImage, ColorImage>("Convert/RGBToComplex", "color", [](ComplexImage& d, const ColorImage& s) {
+      Convert<ComplexImage, ColorImage, RGBToComplex> t(&d, &s, RGBToComplex()); t();
+    });
+
+    add<Gray8Image, Gray8Image>("Convolution3x3", "gray8", [](Gray8Image& d, const Gray8Image& s) {
+      Convolution3x3<Gray8Image, Gray8Image, SmoothUniformRectangular3x3> t(&d, &s); t();
+    });
+    add<GrayImage, GrayImage>("Convolution3x3", "gray", [](GrayImage& d, const GrayImage& s) {
+      Convolution3x3<GrayImage, GrayImage, SmoothUniformRectangular3x3> t(&d, &s); t();
+    });
+    add<GrayImage, GrayImage>("Convolution3x3/Sobel", "gray", [](GrayImage& d, const GrayImage& s) {
+      Convolution3x3<GrayImage, GrayImage, VerticalSobel> t(&d, &s); t();
+    });
+    add<Gray8Image, Gray8Image>("ConvolutionNxN/Pyramid5x5", "gray8", [](Gray8Image& d, const Gray8Image& s) {
+      ConvolutionNxN<Gray8Image, Gray8Image, SmoothPyramid5x5, 5> t(&d, &s); t(); // separable
+    });
+    add<ColorImage, ColorImage>("ConvolutionNxN/Pyramid5x5", "color", [](ColorImage& d, const ColorImage& s) {
+      ConvolutionNxN<ColorImage, ColorImage, SmoothPyramid5x5, 5> t(&d, &s); t();
+    });
+    add<Gray8Image, Gray8Image>("ConvolutionNxN/Cone5x5", "gray8", [](Gray8Image& d, const Gray8Image& s) {
+      ConvolutionNxN<Gray8Image, Gray8Image, SmoothCone5x5, 5> t(&d, &s); t(); // direct
+    });
+
+    add<ColorImage, ColorImage>("Crop", "color", [](ColorImage& d, ColorImage& s) {
+      Crop<ColorImage, ColorImage> t(&d, &s); t();
+    }, HALF_DESTINATION);
+
+    add<Gray8Image, Gray8Image>("Dilate", "gray8", [](Gray8Image& d, const Gray8Image& s) {
+      Dilate<Box3x3, Gray8Image> t(&d, &s); t();
+    });
+    add<GrayImage, GrayImage>("Dilate", "gray", [](GrayImage& d, const GrayImage& s) {
+      Dilate<Box3x3, GrayImage> t(&d, &s); t();
+    });
+
+    add<FloatImage, FloatImage>("DiscreteCosineTransformation", "float", [](FloatImage& d, const FloatImage& s) {
+      DiscreteCosineTransformation t(&d, &s); t();
+    }, POWER_OF_TWO);
+
+    add<ColorImage, ColorImage>("Duplicate", "color", [](ColorImage& d, const ColorImage& s) {
+      Duplicate t(&d, &s); t();
+    });
+
+    add<Gray8Image, Gray8Image>("EqualizeHistogram", "gray8", [](Gray8Image& d, const Gray8Image& s) {
+      EqualizeHistogram<Gray8Image, Gray8Image> t(&d, &s); t();
+    });
+    add<GrayImage, GrayImage>("EqualizeHistogram", "gray", [](GrayImage& d, const GrayImage& s) {
+      EqualizeHistogram<GrayImage, GrayImage> t(&d, &s); t();
+    });
+    add<ColorImage, ColorImage>("EqualizeHistogram", "color", [](ColorImage& d, const ColorImage& s) {
+      EqualizeHistogram<ColorImage, ColorImage> t(&d, &s); t();
+    });
+
+    add<GrayImage, GrayImage>("Erode3x3", "gray", [](GrayImage& d, const GrayImage& s) {
+      Erode3x3<GrayImage, GrayImage, Box3x3> t(&d, &s); t();
+    });
+
+    addUnary<Gray8Image>("Flip", "gray8", [](Gray8Image& d) {
+      Flip<Gray8Image> t(&d); t();
+    });
+    addUnary<ColorImage>("Flip", "color", [](ColorImage& d) {
+      Flip<ColorImage> t(&d); t();
+    });
+
+    addUnary<ComplexImage>("FourierExchange", "complex", [](ComplexImage& d) {
+      FourierExchange<ComplexImage> t(&d); t();
+    }, POWER_OF_TWO);
+    add<ComplexImage, ComplexImage>("FourierTransformation", "complex", [](ComplexImage& d, const ComplexImage& s) {
+      FourierTransformation t(&d, &s); t();
+    }, POWER_OF_TWO);
+
+    add<Gray8Image, Gray8Image>("GaussianBlur", "gray8", [](Gray8Image& d, const Gray8Image& s) {
+      GaussianBlur<Gray8Image> t(&d, &s, 4.0); t();
+    });
+    add<FloatImage, FloatImage>("GaussianBlur", "float", [](FloatImage& d, const FloatImage& s) {
+      GaussianBlur<FloatImage> t(&d, &s, 4.0); t();
+    });
+    add<ColorImage, ColorImage>("GaussianBlur", "color", [](ColorImage& d, const ColorImage& s) {
+      GaussianBlur<ColorImage> t(&d, &s, 4.0); t();
+    });
+
+    add<Gray8Image, Gray8Image>("Gradient", "gray8", [](Gray8Image& d, const Gray8Image& s) {
+      Gray8Gradient t(&d, &s); t();
+    });
+    add<GrayImage, GrayImage>("Gradient", "gray", [](GrayImage& d, const GrayImage& s) {
+      Gradient t(&d, &s); t();
+    });
+
+    addUnary<FloatImage>("HaarTransformation", "float", [](FloatImage& d) {
+      HaarTransformation<FloatImage> t(&d); t();
+    }, POWER_OF_TWO);
+    addUnary<GrayImage>("HaarTransformation", "gray", [](GrayImage& d) {
+      HaarTransformation<GrayImage> t(&d); t();
+    }, POWER_OF_TWO);
+
+    add<PlanarRGBImage<uint8>, ColorImage>("Deinterleave", "color", [](PlanarRGBImage<uint8>& d, const ColorImage& s) {
+      Deinterleave<uint8> t(&d, &s); t();
+    });
+    add<ColorImage, PlanarRGBImage<uint8> >("Interleave", "color", [](ColorImage& d, const PlanarRGBImage<uint8>& s) {
+      Interleave<uint8> t(&d, &s); t();
+    });
+
+    add<ColorImage, ColorImage>("LinearScale", "color", [](ColorImage& d, const ColorImage& s) {
+      LinearScale t(&d, &s); t();
+    }, HALF_DESTINATION);
+
+    add<Gray8Image, Gray8Image>("MedianFilter3x3", "gray8", [](Gray8Image& d, const Gray8Image& s) {
+      Gray8MedianFilter3x3 t(&d, &s); t();
+    });
+    add<GrayImage, GrayImage>("MedianFilter3x3", "gray", [](GrayImage& d, const GrayImage& s) {
+      MedianFilter3x3 t(&d, &s); t();
+    });
+
+    addUnary<Gray8Image>("Mirror", "gray8", [](Gray8Image& d) {
+      Mirror<Gray8Image> t(&d); t();
+    });
+    addUnary<ColorImage>("Mirror", "color", [](ColorImage& d) {
+      Mirror<ColorImage> t(&d); t();
+    });
+
+    addUnary<ColorImage>("Noise", "color", [](ColorImage& d) {
+      Noise<ColorImage> t(&d); t();
+    });
+
+    add<GrayImage, GrayImage>("Scale", "gray", [](GrayImage& d, const GrayImage& s) {
+      Scale<GrayImage, GrayImage> t(&d, &s); t();
+    }, HALF_DESTINATION);
+    add<ColorImage, ColorImage>("Scale", "color", [](ColorImage& d, const ColorImage& s) {
+      Scale<ColorImage, ColorImage> t(&d, &s); t();
+    }, HALF_DESTINATION);
+
+    // votes for every angle per pixel so only run for small images
+    add<FloatImage, Gray8Image>("StraightLineHoughTransformation", "gray8", [](FloatImage& d, const Gray8Image& s) {
+      Gray8StraightLineHoughTransformation t(&d, &s); t();
+    }, SAME, VGA);
+
+    add<ColorImage, ColorImage>("TSRTransformation", "color", [](ColorImage& d, const ColorImage& s) {
+      TSRTransformation<ColorImage, ColorImage> t(&d, &s);
+      t.rotate(0.5);
+      t();
+    });
+
+    addUnary<ColorImage>("Test", "color", [](ColorImage& d) {
+      Test t(&d); t();
+    });
+
+    add<ColorImage, ColorImage>("Tile", "color", [](ColorImage& d, ColorImage& s) {
+      Tile<ColorImage, ColorImage> t(&d, &s); t();
+    }, HALF_SOURCE);
+    add<TiledImage<ColorPixel>, ColorImage>("Tiling", "color", [](TiledImage<ColorPixel>& d, const ColorImage& s) {
+      Tiling<ColorPixel> t(&d, &s); t();
+    });
+    add<ColorImage, TiledImage<ColorPixel> >("Untiling", "color", [](ColorImage& d, const TiledImage<ColorPixel>& s) {
+      Untiling<ColorPixel> t(&d, &s); t();
+    });
+
+    add<ColorImage, ColorImage>("Transpose", "color", [](ColorImage& d, ColorImage& s) {
+      Transpose<ColorImage, ColorImage> t(&d, &s); t();
+    }, TRANSPOSED);
+    add<TiledImage<ColorPixel>, TiledImage<ColorPixel> >("Transpose/Tiled", "color",
+      [](TiledImage<ColorPixel>& d, const TiledImage<ColorPixel>& s) {
+        Transpose<TiledImage<ColorPixel>, TiledImage<ColorPixel> > t(&d, &s); t();
+      },
+      TRANSPOSED
+    );
+
+    add<FloatImage, FloatImage>("WalshTransformation", "float", [](FloatImage& d, const FloatImage& s) {
+      WalshTransformation t(&d, &s); t();
+    }, POWER_OF_TWO);
+  }
+
+  void registerEncoders() {
+    addEncoder<BMPEncoder>("BMPEncoder::read", "BMPEncoder::write");
+    addEncoder<BMPEncoder, GrayImage>("BMPEncoder::writeGray", "gray", EncoderCase<BMPEncoder, GrayImage>::WRITE);
+#if defined(_COM_AZURE_DEV__GIP__USE_JPEG)
+    addEncoder<JPEGEncoder>("JPEGEncoder::read", "JPEGEncoder::write");
+#endif
+    addEncoder<PCXEncoder>("PCXEncoder::read", "PCXEncoder::write");
+    addEncoder<PCXEncoder, GrayImage>("PCXEncoder::writeGray", "gray", EncoderCase<PCXEncoder, GrayImage>::WRITE);
+    addEncoder<PGMEncoder, GrayImage>("PGMEncoder::writeGray", "gray", EncoderCase<PGMEncoder, GrayImage>::WRITE);
+#if defined(_COM_AZURE_DEV__GIP__USE_PNG)
+    addEncoder<PNGEncoder>("PNGEncoder::read", "PNGEncoder::write");
+#endif
+    addEncoder<PPMEncoder>(nullptr, "PPMEncoder::write"); // no decoder
+    addEncoder<RASEncoder>("RASEncoder::read", "RASEncoder::write");
+    addEncoder<RASEncoder, GrayImage>("RASEncoder::writeGray", "gray", EncoderCase<RASEncoder, GrayImage>::WRITE);
+    addEncoder<TGAEncoder>("TGAEncoder::read", "TGAEncoder::write");
+    addEncoder<TGAEncoder, GrayImage>("TGAEncoder::writeGray", "gray", EncoderCase<TGAEncoder, GrayImage>::WRITE);
+  }
+
+  /** Sorts the samples in ascending order. */
+  static void sort(uint64* samples, unsigned int size) noexcept {
+    for (unsigned int i = 1; i < size; ++i) {
+      const uint64 value = samples[i];
+      unsigned int j = i;
+      for (; (j > 0) && (samples[j - 1] > value); --j) {
+        samples[j] = samples[j - 1];
+      }
+      samples[j] = value;
+    }
+  }
+
+  /** Runs the case for the specified dimension. */
+  Result measure(Case& benchmark, const Dimension& dimension) {
+    benchmark.prepare(dimension);
+    for (unsigned int i = 0; i < warmup; ++i) {
+      benchmark.run();
+    }
+    Allocator<uint64> samples(repetitions);
+    uint64* sample = samples.getElements();
+    for (unsigned int i = 0; i < repetitions; ++i) {
+      Timer timer;
+      benchmark.run();
+      sample[i] = timer.getLiveMicroseconds();
+    }
+    sort(sample, repetitions);
+
+    Result result;
+    result.benchmark = &benchmark;
+    result.dimension = dimension;
+    result.repetitions = repetitions;
+    result.median = (repetitions % 2) ?
+      sample[repetitions/2] : (sample[repetitions/2 - 1] + sample[repetitions/2])/2;
+    result.p95 = sample[minimum<unsigned int>((repetitions * 95 + 99)/100, repetitions) - 1];
+    const double elapsed = (result.median > 0) ? static_cast<double>(result.median) : 1.0;
+    result.megapixelsPerSecond = static_cast<double>(benchmark.getPixels())/elapsed;
+    result.megabytesPerSecond = static_cast<double>(benchmark.getBytes())/elapsed;
+    benchmark.release();
+    return result;
+  }
+
+  void writeHeader() {
+    if (json) {
+      fout << '[' << EOL;
+    } else {
+      fout << MESSAGE("name,type,width,height,repetitions,median_us,p95_us,mpix_per_s,mb_per_s") << EOL;
+    }
+  }
+
+  void writeResult(const Result& result, bool first) {
+    if (json) {
+      if (!first) {
+        fout << ',' << EOL;
+      }
+      fout << MESSAGE("  {\"name\":\"") << result.benchmark->name
+           << MESSAGE("\",\"type\":\"") << result.benchmark->type
+           << MESSAGE("\",\"width\":") << result.dimension.getWidth()
+           << MESSAGE(",\"height\":") << result.dimension.getHeight()
+           << MESSAGE(",\"repetitions\":") << result.repetitions
+           << MESSAGE(",\"median_us\":") << result.median
+           << MESSAGE(",\"p95_us\":") << result.p95
+           << MESSAGE(",\"mpix_per_s\":") << setPrecision(3) << result.megapixelsPerSecond
+           << MESSAGE(",\"mb_per_s\":") << setPrecision(3) << result.megabytesPerSecond << '}';
+    } else {
+      fout << result.benchmark->name << ',' << result.benchmark->type << ','
+           << result.dimension.getWidth() << ',' << result.dimension.getHeight() << ','
+           << result.repetitions << ',' << result.median << ',' << result.p95 << ','
+           << setPrecision(3) << result.megapixelsPerSecond << ','
+           << setPrecision(3) << result.megabytesPerSecond << EOL;
+    }
+    fout << FLUSH;
+  }
+
+  void writeFooter() {
+    if (json) {
+      fout << EOL << ']' << EOL;
+    }
+    fout << FLUSH;
+  }
+
+  /** Returns false if the arguments are invalid. */
+  bool parseArguments() {
+    const Array<String> arguments = getArguments();
+    for (MemorySize i = 0; i < arguments.getSize(); ++i) {
+      const String& argument = arguments[i];
+      const bool hasValue = (i + 1) < arguments.getSize();
+      if (argument == "--json") {
+        json = true;
+      } else if ((argument == "--size") && hasValue) {
+        const String& size = arguments[++i];
+        if (size == "vga") {
+          dimensions.append(Dimension(640, 480));
+        } else if (size == "1080p") {
+          dimensions.append(Dimension(1920, 1080));
+        } else if (size == "4k") {
+          dimensions.append(Dimension(3840, 2160));
+        } else if (size == "8k") {
+          dimensions.append(Dimension(7680, 4320));
+        } else {
+          return false;
+        }
+      } else if ((argument == "--warmup") && hasValue) {
+        warmup = UnsignedInteger::parse(arguments[++i], UnsignedInteger::DEC);
+      } else if ((argument == "--repetitions") && hasValue) {
+        repetitions = UnsignedInteger::parse(arguments[++i], UnsignedInteger::DEC);
+        if (repetitions == 0) {
+          return false;
+        }
+      } else if ((argument == "--filter") && hasValue) {
+        filter = arguments[++i];
+      } else if ((argument == "--directory") && hasValue) {
+        directory = arguments[++i];
+      } else {
+        return false;
+      }
+    }
+    if (dimensions.getSize() == 0) {
+      dimensions.append(Dimension(640, 480));
+      dimensions.append(Dimension(1920, 1080));
+      dimensions.append(Dimension(3840, 2160));
+      dimensions.append(Dimension(7680, 4320));
+    }
+    return true;
+  }
+
+  void main() noexcept {
+    if (!parseArguments()) {
+      ferr << MESSAGE("Usage: ") << getFormalName()
+           << MESSAGE(" [--size vga|1080p|4k|8k]... [--warmup N] [--repetitions N]")
+           << MESSAGE(" [--filter TEXT] [--directory PATH] [--json]") << ENDL;
+      setExitCode(EXIT_CODE_ERROR);
+      return; // stop
+    }
+
+    registerTransformations();
+    registerEncoders();
+
+    writeHeader();
+    bool first = true;
+    for (MemorySize i = 0; i < cases.getSize(); ++i) {
+      Case& benchmark = *cases[i];
+      if (!filter.isEmpty() && (String(benchmark.name).indexOf(filter) < 0)) {
+        continue;
+      }
+      for (MemorySize j = 0; j < dimensions.getSize(); ++j) {
+        const Dimension dimension = dimensions[j];
+        if ((benchmark.maximumPixels > 0) && (dimension.getSize() > benchmark.maximumPixels)) {
+          continue;
+        }
+        try {
+          const Result result = measure(benchmark, dimension);
+          writeResult(result, first);
+          first = false;
+        } catch (Exception& e) {
+          benchmark.release();
+          ferr << MESSAGE("Skipped ") << benchmark.name << ' ' << benchmark.type << ' '
+               << dimension.getWidth() << 'x' << dimension.getHeight() << MESSAGE(": ")
+               << e.getMessage() << ENDL;
+        }
+      }
+    }
+    writeFooter();
+  }
+
+  ~BenchmarkApplication() noexcept {
+    for (MemorySize i = 0; i < cases.getSize(); ++i) {
+      delete cases[i];
+    }
+  }
+};
+
+APPLICATION_STUB(BenchmarkApplication);
@@ -0,0 +1,159 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework (Test Suite)
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#include <gip/ArrayImage.h>
+#include <gip/Border.h>
+#include <gip/transformation/Erode.h>
+#include <gip/transformation/Convolution.h>
+#include <base/Application.h>
+#include <base/string/FormatOutputStream.h>
+#include <testsuite/Synthetic.h>
+
+using namespace com::azure::dev::gip;
+
+class BorderApplication : public Application {
+private:
+
+  static const unsigned int MAJOR_VERSION = 1;
+  static const unsigned int MINOR_VERSION = 0;
+  static const Gray8Pixel UNTOUCHED = 77;
+public:
+
+  class Kernel {
+  public:
+
+    enum {
+      M00 = true, M01 = true, M02 = true,
+      M10 = true, M11 = true, M12 = true,
+      M20 = true, M21 = true, M22 = true
+    };
+  };
+
+  BorderApplication() noexcept
+    : Application(MESSAGE("Border")) {
+  }
+
+  /** Returns the source pixel for the specified row and column which may be outside the image. */
+  static Gray8Pixel getPixel(const Gray8Image& image, int column, int row, Border::Mode mode, Gray8Pixel constant) noexcept {
+    const int width = image.getWidth();
+    const int height = image.getHeight();
+    if ((mode == Border::CONSTANT) && ((column < 0) || (row < 0) || (column >= width) || (row >= height))) {
+      return constant;
+    }
+    if ((mode == Border::CONSTANT) || (mode == Border::NONE)) {
+      mode = Border::REPLICATE;
+    }
+    return image.getElements()[Border::map(row, height, mode) * width + Border::map(column, width, mode)];
+  }
+
+  /** Returns true if every pixel matches the minimum of its 3x3 neighborhood. */
+  static bool verifyErode(const Gray8Image& destination, const Gray8Image& source, Border::Mode mode, Gray8Pixel constant) noexcept {
+    const int width = source.getWidth();
+    const int height = source.getHeight();
+    for (int row = 0; row < height; ++row) {
+      for (int column = 0; column < width; ++column) {
+        const bool border = (row == 0) || (column == 0) || (row == (height - 1)) || (column == (width - 1));
+        int expected = 255;
+        for (int i = -1; i <= 1; ++i) {
+          for (int j = -1; j <= 1; ++j) {
+            expected = minimum<int>(expected, getPixel(source, column + j, row + i, mode, constant));
+          }
+        }
+        if ((mode == Border::NONE) && border) {
+          expected = UNTOUCHED;
+        }
+        if (destination.getElements()[row * width + column] != expected) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  /** Calculates the transformation tile by tile (the tiles do not divide the dimension). */
+  template<class TRANSFORMATION>
+  static void applyTiles(const TRANSFORMATION& transform, const Dimension& dimension) {
+    const unsigned int TILE_WIDTH = 8;
+    const unsigned int TILE_HEIGHT = 6;
+    for (unsigned int row = 0; row < dimension.getHeight(); row += TILE_HEIGHT) {
+      for (unsigned int column = 0; column < dimension.getWidth(); column += TILE_WIDTH) {
+        transform(
+          Region(
+            Point2D(row, column),
+            Dimension(
+              minimum(TILE_WIDTH, dimension.getWidth() - column),
+              minimum(TILE_HEIGHT, dimension.getHeight() - row)
+            )
+          )
+        );
+      }
+    }
+  }
+
+  /** Returns true if the convolution tile by tile is identical to the convolution of the whole image. */
+  template<class KERNEL>
+  static bool verifyConvolutionTiles(const Gray8Image& source, Border::Mode mode, Gray8Pixel constant) {
+    Gray8Image whole(source.getDimension());
+    Gray8Image tiled(source.getDimension());
+    fill(whole.getElements(), whole.getNumberOfPixels(), UNTOUCHED);
+    fill(tiled.getElements(), tiled.getNumberOfPixels(), UNTOUCHED);
+    ConvolutionNxN<Gray8Image, Gray8Image, KERNEL, 5>(&whole, &source, mode, constant)();
+    applyTiles(ConvolutionNxN<Gray8Image, Gray8Image, KERNEL, 5>(&tiled, &source, mode, constant), source.getDimension());
+    return Synthetic::isEqual(whole, tiled);
+  }
+
+  void main() noexcept {
+    fout << getFormalName() << MESSAGE(" version ") << MAJOR_VERSION << '.' << MINOR_VERSION << EOL
+         << MESSAGE("Generic Image Processing Framework (Test Suite)") << EOL << ENDL;
+
+    fout << MESSAGE("Reflect:");
+    for (int i = -4; i < 8; ++i) {
+      fout << ' ' << Border::map(i, 4, Border::REFLECT);
+    }
+    fout << EOL << MESSAGE("Wrap:");
+    for (int i = -4; i < 8; ++i) {
+      fout << ' ' << Border::map(i, 4, Border::WRAP);
+    }
+    fout << ENDL;
+
+    const Border::Mode modes[] = {Border::NONE, Border::CONSTANT, Border::REPLICATE, Border::REFLECT, Border::WRAP};
+    const Literal names[] = {MESSAGE("NONE"), MESSAGE("CONSTANT"), MESSAGE("REPLICATE"), MESSAGE("REFLECT"), MESSAGE("WRAP")};
+    const Gray8Pixel constant = 200;
+
+    const Dimension dimension(37, 23);
+    Gray8Image source(dimension);
+    Synthetic::fill(source);
+
+    for (unsigned int i = 0; i < getArraySize(modes); ++i) {
+      Gray8Image destination(dimension);
+      fill(destination.getElements(), destination.getNumberOfPixels(), UNTOUCHED);
+      Erode3x3<Gray8Image, Gray8Image, Kernel> transform(&destination, &source, modes[i], constant);
+      transform();
+      fout << names[i] << MESSAGE(": ") << verifyErode(destination, source, modes[i], constant) << ENDL;
+    }
+
+    // tiles copy the columns of the tile and the halo only
+    for (unsigned int i = 0; i < getArraySize(modes); ++i) {
+      Gray8Image destination(dimension);
+      fill(destination.getElements(), destination.getNumberOfPixels(), UNTOUCHED);
+      applyTiles(Erode3x3<Gray8Image, Gray8Image, Kernel>(&destination, &source, modes[i], constant), dimension);
+      fout << names[i] << MESSAGE(" (tiles): ") << verifyErode(destination, source, modes[i], constant) << EOL
+           << MESSAGE("  Convolution (separable): ")
+           << verifyConvolutionTiles<SmoothPyramid5x5>(source, modes[i], constant) << EOL
+           << MESSAGE("  Convolution (direct): ")
+           << verifyConvolutionTiles<SmoothCone5x5>(source, modes[i], constant) << ENDL;
+    }
+  }
+};
+
+APPLICATION_STUB(BorderApplication);
@@ -41,9 +41,7 @@ public:
     fout << information << ENDL;
 
     fout << MESSAGE("Importing image with encoder: ") << encoder.getDescription() << ENDL;
-    ColorImage* image = encoder.read(inputFile);
-    ColorImage originalImage(*image);
-    delete image;
+    ColorImage originalImage = encoder.readImage(inputFile);
 
 //    GrayImage grayOriginalImage(originalImage.getDimension());
 //    {
@@ -0,0 +1,164 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework (Test Suite)
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#include <gip/ArrayImage.h>
+#include <gip/CPUDispatch.h>
+#include <gip/transformation/Convolution3x3.h>
+#include <base/Application.h>
+#include <base/string/FormatOutputStream.h>
+#include <base/Timer.h>
+#include <testsuite/Synthetic.h>
+
+using namespace com::azure::dev::gip;
+
+/** Normalized 3x3 binomial kernel. */
+class SmoothBinomial3x3 : public Kernel {
+public:
+
+  enum {
+    NORMALIZE = true,
+    M00 = 1, M01 = 2, M02 = 1,
+    M10 = 2, M11 = 4, M12 = 2,
+    M20 = 1, M21 = 2, M22 = 1
+  };
+};
+
+class Convolution3x3Application : public Application {
+private:
+
+  static const unsigned int MAJOR_VERSION = 1;
+  static const unsigned int MINOR_VERSION = 0;
+public:
+
+  Convolution3x3Application() noexcept
+    : Application(MESSAGE("Convolution3x3")) {
+  }
+
+  static inline uint8 getComponent(Gray8Pixel pixel, unsigned int) noexcept {
+    return pixel;
+  }
+
+  static inline uint8 getComponent(const ColorPixel& pixel, unsigned int channel) noexcept {
+    return (channel == 0) ? pixel.red : ((channel == 1) ? pixel.green : pixel.blue);
+  }
+
+  static inline void setComponent(Gray8Pixel& pixel, unsigned int, uint8 value) noexcept {
+    pixel = value;
+  }
+
+  static inline void setComponent(ColorPixel& pixel, unsigned int channel, uint8 value) noexcept {
+    if (channel == 0) {
+      pixel.red = value;
+    } else if (channel == 1) {
+      pixel.green = value;
+    } else {
+      pixel.blue = value;
+    }
+  }
+
+  /**
+    Evaluates the kernel directly with replicated border pixels. The result
+    is the low 8 bits of the truncated quotient.
+  */
+  template<class KERNEL, class PIXEL>
+  static void convolve(ArrayImage<PIXEL>& destination, const ArrayImage<PIXEL>& source, unsigned int channels) noexcept {
+    const int coefficients[9] = {
+      KERNEL::M00, KERNEL::M01, KERNEL::M02,
+      KERNEL::M10, KERNEL::M11, KERNEL::M12,
+      KERNEL::M20, KERNEL::M21, KERNEL::M22
+    };
+    int divisor = 1;
+    if (KERNEL::NORMALIZE) {
+      divisor = 0;
+      for (unsigned int i = 0; i < 9; ++i) {
+        divisor += coefficients[i];
+      }
+    }
+    const int width = source.getWidth();
+    const int height = source.getHeight();
+    const PIXEL* src = source.getElements();
+    PIXEL* dest = destination.getElements();
+    for (int row = 0; row < height; ++row) {
+      for (int column = 0; column < width; ++column) {
+        for (unsigned int channel = 0; channel < channels; ++channel) {
+          int sum = 0;
+          for (int i = -1; i <= 1; ++i) {
+            const int y = (row + i < 0) ? 0 : ((row + i >= height) ? (height - 1) : (row + i));
+            for (int j = -1; j <= 1; ++j) {
+              const int x = (column + j < 0) ? 0 : ((column + j >= width) ? (width - 1) : (column + j));
+              sum += coefficients[(i + 1) * 3 + j + 1] *
+                getComponent(src[static_cast<MemorySize>(y) * source.getPitch() + x], channel);
+            }
+          }
+          setComponent(
+            dest[static_cast<MemorySize>(row) * destination.getPitch() + column], channel, static_cast<uint8>(sum/divisor)
+          );
+        }
+      }
+    }
+  }
+
+  /** Compares every level against the direct evaluation of the kernel. */
+  template<class KERNEL>
+  void test(const Literal& name, const Gray8Image& gray, const ColorImage& color) noexcept {
+    const CPUDispatch::Level automatic = CPUDispatch::getLevel();
+    Gray8Image grayReference(gray.getDimension(), 64);
+    ColorImage colorReference(color.getDimension());
+    convolve<KERNEL>(grayReference, gray, 1);
+    convolve<KERNEL>(colorReference, color, 3);
+
+    fout << name << EOL;
+    for (unsigned int level = 0; level < CPUDispatch::LEVELS; ++level) {
+      if (level > CPUDispatch::getSupportedLevel()) {
+        fout << MESSAGE("  ") << CPUDispatch::getLevelName(static_cast<CPUDispatch::Level>(level))
+             << MESSAGE(": not supported") << EOL;
+        continue;
+      }
+      CPUDispatch::setLevel(static_cast<CPUDispatch::Level>(level));
+      Gray8Image grayResult(gray.getDimension(), 64);
+      ColorImage colorResult(color.getDimension());
+      Timer timer;
+      Convolution3x3<Gray8Image, Gray8Image, KERNEL>(&grayResult, &gray)();
+      const uint64 grayTime = timer.getLiveMicroseconds();
+      timer.start();
+      Convolution3x3<ColorImage, ColorImage, KERNEL>(&colorResult, &color)();
+      const uint64 colorTime = timer.getLiveMicroseconds();
+      fout << MESSAGE("  ") << CPUDispatch::getLevelName(static_cast<CPUDispatch::Level>(level))
+           << MESSAGE(": gray ") << grayTime << MESSAGE(" us (")
+           << (Synthetic::isEqual(grayReference, grayResult) ? MESSAGE("identical") : MESSAGE("DIFFERENT"))
+           << MESSAGE("), color ") << colorTime << MESSAGE(" us (")
+           << (Synthetic::isEqual(colorReference, colorResult) ? MESSAGE("identical") : MESSAGE("DIFFERENT"))
+           << ')' << EOL;
+    }
+    CPUDispatch::setLevel(automatic);
+  }
+
+  void main() noexcept {
+    fout << getFormalName() << MESSAGE(" version ") << MAJOR_VERSION << '.' << MINOR_VERSION << EOL
+         << MESSAGE("Generic Image Processing Framework (Test Suite)") << EOL << ENDL;
+
+    const Dimension dimension(3840, 2160);
+    Gray8Image gray(Dimension(3839, 2160), 64); // padded rows
+    Synthetic::fill(gray);
+    ColorImage color(dimension);
+    Synthetic::fill(color);
+
+    test<VerticalSobel>(MESSAGE("VerticalSobel"), gray, color);
+    test<HorizontalPrewitt>(MESSAGE("HorizontalPrewitt"), gray, color);
+    test<SmoothUniformRectangular3x3>(MESSAGE("SmoothUniformRectangular3x3"), gray, color);
+    test<SmoothBinomial3x3>(MESSAGE("SmoothBinomial3x3"), gray, color);
+    fout << ENDL;
+  }
+};
+
+APPLICATION_STUB(Convolution3x3Application);
@@ -0,0 +1,134 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework (Test Suite)
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#include <gip/ArrayImage.h>
+#include <gip/transformation/Convolution.h>
+#include <gip/transformation/Pipeline.h>
+#include <base/Application.h>
+#include <base/string/FormatOutputStream.h>
+#include <base/Timer.h>
+#include <testsuite/Synthetic.h>
+#include <math.h>
+
+using namespace com::azure::dev::gip;
+
+class ConvolutionNxNApplication : public Application {
+private:
+
+  static const unsigned int MAJOR_VERSION = 1;
+  static const unsigned int MINOR_VERSION = 0;
+public:
+
+  ConvolutionNxNApplication() noexcept
+    : Application(MESSAGE("ConvolutionNxN")) {
+  }
+
+  /**
+    Returns true if the interior matches the direct evaluation of the
+    normalized integer kernel rounded to the nearest integer.
+  */
+  static bool verify(const Gray8Image& destination, const Gray8Image& source, const ConvolutionKernel<int>& kernel) noexcept {
+    const unsigned int size = kernel.getSize();
+    const unsigned int radius = kernel.getRadius();
+    const unsigned int width = source.getWidth();
+    const int* coefficients = kernel.getCoefficients();
+    long long divisor = 0;
+    for (unsigned int i = 0; i < size * size; ++i) {
+      divisor += coefficients[i];
+    }
+    for (unsigned int row = radius; row < (source.getHeight() - radius); ++row) {
+      for (unsigned int column = radius; column < (width - radius); ++column) {
+        long long sum = 0;
+        for (unsigned int i = 0; i < size; ++i) {
+          const Gray8Pixel* src = source.getElements() + (row - radius + i) * width + column - radius;
+          for (unsigned int j = 0; j < size; ++j) {
+            sum += static_cast<long long>(coefficients[i * size + j]) * src[j];
+          }
+        }
+        long long expected = static_cast<long long>(::floor(static_cast<double>(sum)/divisor + 0.5));
+        expected = (expected < 0) ? 0 : ((expected > 255) ? 255 : expected);
+        if (destination.getElements()[row * width + column] != expected) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  template<class KERNEL>
+  void test(const Literal& name, const Gray8Image& source) noexcept {
+    Gray8Image destination(source.getDimension());
+    ConvolutionNxN<Gray8Image, Gray8Image, KERNEL, 5> transform(&destination, &source);
+    Timer timer;
+    transform();
+    const uint64 elapsed = timer.getLiveMicroseconds();
+    const ConvolutionKernel<int> kernel = makeConvolutionKernel<KERNEL, 5>();
+    fout << name << MESSAGE(": ") << elapsed << MESSAGE(" us") << EOL
+         << MESSAGE("  Separable: ") << kernel.isSeparable() << EOL
+         << MESSAGE("  Identical: ") << verify(destination, source, kernel) << EOL;
+
+    // the halo of the stage is given by the transformation
+    Gray8Image intermediate(source.getDimension());
+    Gray8Image streamed(source.getDimension());
+    ConvolutionNxN<Gray8Image, Gray8Image, KERNEL, 5> first(&intermediate, &source);
+    Convolution<Gray8Image, Gray8Image> second(&streamed, &intermediate, kernel);
+    Pipeline pipeline;
+    pipeline.add(first);
+    pipeline.add(second);
+    pipeline();
+    Gray8Image expected(source.getDimension());
+    Convolution<Gray8Image, Gray8Image> twice(&expected, &destination, kernel);
+    twice();
+    fout << MESSAGE("  Identical pipeline: ") << Synthetic::isEqual(streamed, expected) << ENDL;
+  }
+
+  void main() noexcept {
+    fout << getFormalName() << MESSAGE(" version ") << MAJOR_VERSION << '.' << MINOR_VERSION << EOL
+         << MESSAGE("Generic Image Processing Framework (Test Suite)") << EOL << ENDL;
+
+    const Dimension dimension(1920, 1080);
+    Gray8Image source(dimension);
+    Synthetic::fill(source);
+
+    test<SmoothPyramid5x5>(MESSAGE("SmoothPyramid5x5"), source);
+    test<SmoothCone5x5>(MESSAGE("SmoothCone5x5"), source);
+    test<SmoothUniformRectangular5x5>(MESSAGE("SmoothUniformRectangular5x5"), source);
+
+    // large runtime kernel
+    const unsigned int SIZE = 31;
+    float gaussian[SIZE];
+    for (unsigned int i = 0; i < SIZE; ++i) {
+      const float x = static_cast<float>(static_cast<int>(i) - static_cast<int>(SIZE/2));
+      gaussian[i] = ::expf(-x * x/(2 * 5.0f * 5.0f));
+    }
+    Array<float> coefficients;
+    coefficients.setSize(SIZE * SIZE);
+    for (unsigned int i = 0; i < SIZE; ++i) {
+      for (unsigned int j = 0; j < SIZE; ++j) {
+        coefficients.getElements()[i * SIZE + j] = gaussian[i] * gaussian[j];
+      }
+    }
+    const ConvolutionKernel<float> kernel(SIZE, coefficients.getElements(), true);
+
+    ColorImage color(dimension);
+    Synthetic::fill(color);
+    ColorImage blurred(dimension);
+    Convolution<ColorImage, ColorImage, float> transform(&blurred, &color, kernel);
+    Timer timer;
+    transform();
+    fout << MESSAGE("Gaussian 31x31 (ColorImage): ") << timer.getLiveMicroseconds() << MESSAGE(" us") << EOL
+         << MESSAGE("  Separable: ") << kernel.isSeparable() << ENDL;
+  }
+};
+
+APPLICATION_STUB(ConvolutionNxNApplication);
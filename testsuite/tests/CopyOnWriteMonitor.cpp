@@ -0,0 +1,102 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework (Test Suite)
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#include <gip/ArrayImage.h>
+#include <gip/CopyOnWriteMonitor.h>
+#include <gip/transformation/Flip.h>
+#include <base/Application.h>
+#include <base/string/FormatOutputStream.h>
+#include <testsuite/Synthetic.h>
+
+using namespace com::azure::dev::gip;
+
+class CopyOnWriteMonitorApplication : public Application {
+private:
+
+  static const unsigned int MAJOR_VERSION = 1;
+  static const unsigned int MINOR_VERSION = 0;
+
+  /** The number of copies seen by the listener. */
+  static unsigned int events;
+public:
+
+  CopyOnWriteMonitorApplication() noexcept
+    : Application(MESSAGE("CopyOnWriteMonitor")) {
+  }
+
+  static void onCopy(const CopyOnWriteMonitor::Event& event) noexcept {
+    ++events;
+  }
+
+  /** Returns true if verifying the object raises ImageException. */
+  static bool raises(const CopyOnWriteMonitor::Forbid& forbid) noexcept {
+    try {
+      forbid.verify();
+    } catch (ImageException&) {
+      return true;
+    }
+    return false;
+  }
+
+  void main() noexcept {
+    fout << getFormalName() << MESSAGE(" version ") << MAJOR_VERSION << '.' << MINOR_VERSION << EOL
+         << MESSAGE("Generic Image Processing Framework (Test Suite)") << EOL << ENDL;
+
+    const Dimension dimension(640, 480);
+    Gray8Image image(dimension);
+    Synthetic::fill(image);
+    const MemorySize bytes = static_cast<MemorySize>(image.getPitch()) * image.getHeight();
+
+    // counters
+    CopyOnWriteMonitor::resetStatistics();
+    CopyOnWriteMonitor::setListener(onCopy);
+    image.getElements(); // not shared
+    const Gray8Image shared(image);
+    shared.getElements(); // non-modifying access
+    CopyOnWriteMonitor::Statistics statistics = CopyOnWriteMonitor::getStatistics();
+    fout << MESSAGE("No copy without sharing: ") << (statistics.copies == 0) << EOL;
+
+    image.getElements(); // detaches from the shared image
+    statistics = CopyOnWriteMonitor::getStatistics();
+    fout << MESSAGE("Copy on modifying access: ")
+         << ((statistics.copies == 1) && (statistics.bytes == bytes) && (events == 1)) << EOL
+         << MESSAGE("  Site: ") << statistics.lastSite << EOL;
+    image.getElements(); // no longer shared
+    statistics = CopyOnWriteMonitor::getStatistics();
+    fout << MESSAGE("No copy after detach: ") << (statistics.copies == 1) << EOL;
+
+    // forbidden copies are reported by verify() after the transformation
+    {
+      CopyOnWriteMonitor::Forbid forbid;
+      Flip<Gray8Image> flip(&image); // not shared
+      flip();
+      fout << MESSAGE("Forbid without copies: ") << ((forbid.getCopies() == 0) && !raises(forbid)) << EOL;
+
+      Gray8Image copy(image);
+      Flip<Gray8Image> flipCopy(&copy); // detaches from image within the noexcept transformation
+      flipCopy();
+      fout << MESSAGE("Forbid with copy: ") << ((forbid.getCopies() == 1) && raises(forbid)) << EOL;
+    }
+    {
+      CopyOnWriteMonitor::Forbid forbid;
+      fout << MESSAGE("Forbid counts from creation: ") << ((forbid.getCopies() == 0) && !raises(forbid)) << EOL;
+    }
+    CopyOnWriteMonitor::setListener(nullptr);
+    statistics = CopyOnWriteMonitor::getStatistics();
+    fout << MESSAGE("Total: ") << statistics.copies << MESSAGE(" copies (") << statistics.bytes << MESSAGE(" bytes)") << ENDL;
+  }
+};
+
+unsigned int CopyOnWriteMonitorApplication::events = 0;
+
+APPLICATION_STUB(CopyOnWriteMonitorApplication);
@@ -37,9 +37,7 @@ public:
     BMPEncoder encoder;
     
     fout << MESSAGE("Importing image with encoder: ") << encoder.getDescription() << ENDL;
-    ColorImage* image = encoder.read(inputFile);
-    ColorImage originalImage(*image);
-    delete image;
+    ColorImage originalImage = encoder.readImage(inputFile);
 
     ColorImage finalImage(originalImage.getDimension());
     {
@@ -0,0 +1,110 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework (Test Suite)
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#include <gip/ArrayImage.h>
+#include <gip/operation/Expression.h>
+#include <gip/operation/Slice.h>
+#include <gip/operation/Blend.h>
+#include <gip/operation/HeatColorMap.h>
+#include <base/Application.h>
+#include <base/string/FormatOutputStream.h>
+#include <base/Timer.h>
+#include <testsuite/Synthetic.h>
+
+using namespace com::azure::dev::gip;
+
+class ExpressionApplication : public Application {
+private:
+
+  static const unsigned int MAJOR_VERSION = 1;
+  static const unsigned int MINOR_VERSION = 0;
+public:
+
+  /** Converts a color with components in [0; 1] to a color pixel. */
+  class ToColor : public UnaryOperation<RGBPixel<double>, ColorPixel> {
+  public:
+
+    inline ColorPixel operator()(const RGBPixel<double>& value) const noexcept {
+      return makeColorPixel(
+        static_cast<uint8>(value.red * 255 + 0.5),
+        static_cast<uint8>(value.green * 255 + 0.5),
+        static_cast<uint8>(value.blue * 255 + 0.5)
+      );
+    }
+  };
+
+  /** Heat color map producing color pixels. */
+  class HeatColor : public UnaryOperation<float, ColorPixel> {
+  private:
+
+    HeatColorMap map;
+    ToColor toColor;
+  public:
+
+    inline ColorPixel operator()(const float value) const noexcept {
+      return toColor(map(value));
+    }
+  };
+
+  ExpressionApplication() noexcept
+    : Application(MESSAGE("Expression")) {
+  }
+
+  void main() noexcept {
+    fout << getFormalName() << MESSAGE(" version ") << MAJOR_VERSION << '.' << MINOR_VERSION << EOL
+         << MESSAGE("Generic Image Processing Framework (Test Suite)") << EOL << ENDL;
+
+    const Dimension dimension(1920, 1080);
+    FloatImage source(dimension);
+    ColorImage background(dimension);
+    {
+      float* src = source.getElements();
+      for (MemorySize i = 0; i < source.getNumberOfPixels(); ++i) {
+        src[i] = static_cast<float>(i % dimension.getWidth())/dimension.getWidth();
+      }
+      fill(background.getElements(), background.getNumberOfPixels(), makeColorPixel(0x20, 0x40, 0x80));
+    }
+
+    Slice<float> slice(0.25f, 0.75f);
+    HeatColor heat;
+    Blend<ColorPixel> blend(3, 4);
+
+    // one pass and one temporary image per step
+    Timer timer;
+    FloatImage sliced(dimension);
+    fillWithUnary(sliced, source, slice);
+    ColorImage stepwise(dimension);
+    fillWithUnary(stepwise, sliced, heat);
+    transform(stepwise, background, blend);
+    const uint64 stepwiseTime = timer.getLiveMicroseconds();
+
+    // single fused pass
+    ColorImage fused(dimension);
+    timer.start();
+    assign(fused, combine(apply(apply(source, slice), heat), background, blend));
+    const uint64 fusedTime = timer.getLiveMicroseconds();
+
+    ColorImage parallel(dimension);
+    timer.start();
+    parallelAssign(parallel, combine(apply(apply(source, slice), heat), background, blend));
+    const uint64 parallelTime = timer.getLiveMicroseconds();
+
+    const bool identical = Synthetic::isEqual(stepwise, fused) && Synthetic::isEqual(fused, parallel);
+    fout << MESSAGE("Stepwise: ") << stepwiseTime << MESSAGE(" us") << EOL
+         << MESSAGE("Fused: ") << fusedTime << MESSAGE(" us") << EOL
+         << MESSAGE("Fused parallel: ") << parallelTime << MESSAGE(" us") << EOL
+         << MESSAGE("Identical: ") << identical << ENDL;
+  }
+};
+
+APPLICATION_STUB(ExpressionApplication);
@@ -12,199 +12,224 @@
  ***************************************************************************/
 
 #include <gip/io/BMPEncoder.h>
-#include <gip/transformation/LinearScale.h>
-#include <gip/transformation/FourierTransformation.h>
-#include <gip/transformation/Convert.h>
-#include <gip/operation/HeatColorMap.h>
+#include <gip/transformation/GaussianBlur.h>
 #include <gip/ArrayImage.h>
-#include <gip/analysis/traverse.h>
-#include <gip/Functor.h>
+#include <gip/CPUDispatch.h>
 #include <base/Application.h>
 #include <base/string/FormatOutputStream.h>
-#include <base/string/StringOutputStream.h>
-#include <base/Functor.h>
+#include <base/UnsignedInteger.h>
 #include <base/Timer.h>
 #include <base/TypeInfo.h>
+#include <testsuite/Synthetic.h>
+#include <math.h>
 
 using namespace com::azure::dev::gip;
 
-class Gaussian : public BinaryOperation<double, double, double> {
+class GaussianBlurApplication : public Application {
 private:
-  
-  const double denomX = 0;
-  const double denomY = 0;
-public:
-  
-  inline Gaussian(double deviationX, double deviationY) noexcept
-    : denomX(-1/(2 * deviationX * deviationX)),
-      denomY(-1/(2 * deviationY * deviationY)) {
-  }
-  
-  inline double operator()(double x, double y) const noexcept {
-    return Math::exp(x * x * denomX + y * y * denomY);
-  }
-};
 
-class RealToGray : public UnaryOperation<Complex<float>, GrayPixel> {
-private:
-
-   const double scale = 0;
+  static const unsigned int MAJOR_VERSION = 1;
+  static const unsigned int MINOR_VERSION = 0;
 public:
 
-  inline RealToGray(const Dimension& dimension) noexcept
-    : scale(1.0/dimension.getSize())
+  GaussianBlurApplication() noexcept
+    : Application(MESSAGE("GaussianBlur"))
   {
   }
-  
-  //inline RealToGray(const Dimension& dimension) noexcept : scale(255) {
-  //}
 
-  inline GrayPixel operator()(const Complex<float>& value) const noexcept
-  {
-    return clamp(0, static_cast<GrayPixel>(value.getReal() * scale), 255);
+  /** Returns true if all the pixels are within the tolerance of the value. */
+  static bool isConstant(const FloatImage& image, float value, float tolerance) noexcept {
+    for (unsigned int row = 0; row < image.getHeight(); ++row) {
+      const float* src = image.getElements() + static_cast<MemorySize>(row) * image.getPitch();
+      for (unsigned int column = 0; column < image.getWidth(); ++column) {
+        if (!(::fabs(src[column] - value) <= tolerance)) {
+          return false;
+        }
+      }
+    }
+    return true;
   }
-};
 
-class GaussianBlur : public Application {
-private:
+  /**
+    Returns the largest difference from the separable convolution with the
+    sampled and normalized Gaussian (radius 4 deviations) with replicated
+    edges.
+  */
+  static double getDirectError(const FloatImage& blurred, const FloatImage& source, double deviation) noexcept {
+    const int width = source.getWidth();
+    const int height = source.getHeight();
+    const int radius = static_cast<int>(::ceil(4 * deviation));
+    Allocator<double> kernel(2 * radius + 1);
+    double sum = 0;
+    for (int i = -radius; i <= radius; ++i) {
+      kernel.getElements()[i + radius] = ::exp(-i * i/(2 * deviation * deviation));
+      sum += kernel.getElements()[i + radius];
+    }
+    for (int i = -radius; i <= radius; ++i) {
+      kernel.getElements()[i + radius] /= sum;
+    }
+    const double* g = kernel.getElements() + radius;
 
-  static const unsigned int MAJOR_VERSION = 1;
-  static const unsigned int MINOR_VERSION = 0;
-public:
-  
-  GaussianBlur() noexcept
-    : Application(MESSAGE("GaussianBlur"))
-  {
+    Allocator<double> rows(static_cast<MemorySize>(width) * height); // horizontal pass
+    for (int row = 0; row < height; ++row) {
+      const float* src = source.getElements() + static_cast<MemorySize>(row) * source.getPitch();
+      for (int column = 0; column < width; ++column) {
+        double value = 0;
+        for (int i = -radius; i <= radius; ++i) {
+          value += g[i] * src[Border::map(column + i, width, Border::REPLICATE)];
+        }
+        rows.getElements()[static_cast<MemorySize>(row) * width + column] = value;
+      }
+    }
+    double error = 0;
+    for (int row = 0; row < height; ++row) {
+      const float* dest = blurred.getElements() + static_cast<MemorySize>(row) * blurred.getPitch();
+      for (int column = 0; column < width; ++column) {
+        double value = 0;
+        for (int i = -radius; i <= radius; ++i) {
+          value += g[i] * rows.getElements()[static_cast<MemorySize>(Border::map(row + i, height, Border::REPLICATE)) * width + column];
+        }
+        error = maximum(error, ::fabs(value - dest[column]));
+      }
+    }
+    return error;
   }
-  
-  void blur(const String& inputFile, const String& outputFile) noexcept
-  {
-    BMPEncoder encoder;
-    
-    ColorImage* image = encoder.read(inputFile);
-    ColorImage originalImage(*image);
-    delete image;
-    
-    Dimension dimension(
-      Math::getPowerOf2(originalImage.getDimension().getWidth()),
-      Math::getPowerOf2(originalImage.getDimension().getHeight())
-    );
-    
-    ColorImage scaledImage(dimension);
+
+  /** Verifies the blur of synthetic images. */
+  void verify() {
+    const double DEVIATION = 4;
+
+    // a constant image stays constant
     {
-      LinearScale transform(&scaledImage, &originalImage);
-      fout << MESSAGE("Scaling image: ") << originalImage.getDimension()
-           << MESSAGE("->") << scaledImage.getDimension() << ' '
-           << '(' << TypeInfo::getTypename(transform) << ')' << ENDL;
-      transform();
+      FloatImage constant(Dimension(97, 71));
+      fill(constant.getElements(), constant.getNumberOfPixels(), 0.4f);
+      FloatImage blurred(constant.getDimension());
+      GaussianBlur<FloatImage>(&blurred, &constant, DEVIATION)();
+      Gray8Image gray(Dimension(97, 71));
+      fill(gray.getElements(), gray.getNumberOfPixels(), static_cast<Gray8Pixel>(100));
+      Gray8Image grayBlurred(gray.getDimension());
+      GaussianBlur<Gray8Image>(&grayBlurred, &gray, DEVIATION)();
+      fout << MESSAGE("Constant: ") << (isConstant(blurred, 0.4f, 1e-4f) && Synthetic::isEqual(gray, grayBlurred)) << EOL;
     }
-    
-    ComplexImage spatialImage(scaledImage.getDimension());
+
+    // the impulse response is normalized and has the deviation
     {
-      Convert<ComplexImage, ColorImage, RGBToFloat> transform(
-        &spatialImage,
-        &scaledImage,
-        RGBToFloat()
-      );
-      fout << MESSAGE("Converting image: ColorImage->ComplexImage") << ' '
-           << '(' << TypeInfo::getTypename(transform) << ')' << ENDL;
-      transform();
+      const unsigned int SIZE = 161;
+      const unsigned int CENTER = SIZE/2;
+      FloatImage impulse(Dimension(SIZE, SIZE));
+      fill(impulse.getElements(), impulse.getNumberOfPixels(), 0.0f);
+      impulse.getElements()[static_cast<MemorySize>(CENTER) * impulse.getPitch() + CENTER] = 1;
+      FloatImage response(impulse.getDimension());
+      GaussianBlur<FloatImage>(&response, &impulse, DEVIATION)();
+      double sum = 0;
+      double variance = 0;
+      for (unsigned int row = 0; row < SIZE; ++row) {
+        const float* src = response.getElements() + static_cast<MemorySize>(row) * response.getPitch();
+        for (unsigned int column = 0; column < SIZE; ++column) {
+          const double offset = static_cast<double>(column) - CENTER;
+          sum += src[column];
+          variance += src[column] * offset * offset;
+        }
+      }
+      variance /= sum;
+      // the recursion fits the Gaussian in least squares and its exponential
+      // tails raise the second moment (by about 23% for a deviation of 4)
+      fout << MESSAGE("Impulse response: sum ") << sum << MESSAGE(" variance ") << variance << EOL
+           << MESSAGE("  Normalized: ") << (::fabs(sum - 1) < 1e-3) << EOL
+           << MESSAGE("  Deviation: ") << (::fabs(variance/(DEVIATION * DEVIATION) - 1) < 0.25) << EOL;
     }
-    
-    ComplexImage fourierImage(spatialImage.getDimension());
+
+    // close to the direct convolution with the sampled Gaussian
+    FloatImage noise(Dimension(97, 71));
+    Synthetic::fill(noise);
     {
-      FourierTransformation transform(&fourierImage, &spatialImage);
-      fout << MESSAGE("Transforming image: Spatial->Fourier") << ' '
-           << '(' << TypeInfo::getTypename(transform) << ')' << ENDL;
-      Timer timer;
-      transform();
-      fout << MESSAGE("Time elapsed for transformation: ")
-           << timer.getLiveMicroseconds() << MESSAGE(" microseconds") << EOL;
+      FloatImage blurred(noise.getDimension());
+      GaussianBlur<FloatImage>(&blurred, &noise, DEVIATION)();
+      const double error = getDirectError(blurred, noise, DEVIATION);
+      fout << MESSAGE("Direct convolution: error ") << error << EOL
+           << MESSAGE("  Within tolerance: ") << (error < 0.01) << EOL;
     }
-    
-    /*ArrayImage<double>*/ ComplexImage filterImage(fourierImage.getDimension());
-    {
-      Gaussian gaussian(
-        8192/512*filterImage.getDimension().getWidth(),
-        8192/512*filterImage.getDimension().getHeight()
-      );
-      //typedef ArrayImage<double> DestinationImage;
-      typedef ComplexImage DestinationImage;
-      
-      const unsigned int rows = filterImage.getDimension().getHeight()/2;
-      const unsigned int columns = filterImage.getDimension().getWidth()/2;
-      DestinationImage::Rows rowsLookup = filterImage.getRows();
-      DestinationImage::Rows::RowIterator top = rowsLookup.getFirst();
-      DestinationImage::Rows::RowIterator bottom = rowsLookup.getEnd();
-      unsigned int y = 0;
-      while (top < bottom) {
-        --bottom;
-        DestinationImage::Rows::RowIterator::ElementIterator c0 = top.getFirst();
-        DestinationImage::Rows::RowIterator::ElementIterator c1 = top.getEnd();
-        DestinationImage::Rows::RowIterator::ElementIterator c2 = bottom.getFirst();
-        DestinationImage::Rows::RowIterator::ElementIterator c3 = bottom.getEnd();
-        unsigned int x = 0;
-        while (c0 < c1) {
-          double temp = gaussian(x++, y++);
-          *c0++ = temp;
-          *--c1 = temp;
-          *c2++ = temp;
-          *--c3 = temp;
-        }
-        ++top;
+
+    // all the instruction sets give identical results
+    const CPUDispatch::Level automatic = CPUDispatch::getLevel();
+    CPUDispatch::setLevel(CPUDispatch::LEVEL_SCALAR);
+    ColorImage color(Dimension(97, 71));
+    Synthetic::fill(color);
+    ColorImage colorReference(color.getDimension());
+    FloatImage floatReference(noise.getDimension());
+    GaussianBlur<ColorImage>(&colorReference, &color, DEVIATION)();
+    GaussianBlur<FloatImage>(&floatReference, &noise, DEVIATION)();
+    for (unsigned int level = CPUDispatch::LEVEL_SSE2; level < CPUDispatch::LEVELS; ++level) {
+      const char* name = CPUDispatch::getLevelName(static_cast<CPUDispatch::Level>(level));
+      if (level > CPUDispatch::getSupportedLevel()) {
+        fout << name << MESSAGE(": not supported") << EOL;
+        continue;
       }
+      CPUDispatch::setLevel(static_cast<CPUDispatch::Level>(level));
+      ColorImage colorResult(color.getDimension());
+      FloatImage floatResult(noise.getDimension());
+      GaussianBlur<ColorImage>(&colorResult, &color, DEVIATION)();
+      GaussianBlur<FloatImage>(&floatResult, &noise, DEVIATION)();
+      fout << name << MESSAGE(": ")
+           << (Synthetic::isEqual(colorReference, colorResult) && Synthetic::isEqual(floatReference, floatResult)) << EOL;
     }
-    
-    // multiply images
-    Multiply<Complex<float> > multiply;
-    transform(fourierImage, filterImage, multiply);
-    
+    CPUDispatch::setLevel(automatic);
+    fout << ENDL;
+  }
+
+  void blur(const String& inputFile, const String& outputFile, unsigned int deviation)
+  {
+    BMPEncoder encoder;
+
+    ColorImage originalImage = encoder.readImage(inputFile);
+
+    ColorImage blurredImage(originalImage.getDimension());
     {
-      FourierTransformation transform(&spatialImage, &fourierImage, false);
-      fout << MESSAGE("Transforming image: Fourier->Spatial") << ' '
+      GaussianBlur<ColorImage> transform(&blurredImage, &originalImage, deviation);
+      fout << MESSAGE("Blurring image: ") << originalImage.getDimension()
+           << MESSAGE(" deviation ") << deviation << ' '
            << '(' << TypeInfo::getTypename(transform) << ')' << ENDL;
       Timer timer;
       transform();
       fout << MESSAGE("Time elapsed for transformation: ")
-           << timer.getLiveMicroseconds() << MESSAGE(" microseconds") << EOL;
-    }
-    
-    GrayImage grayImage(spatialImage.getDimension());
-    {
-      Convert<GrayImage, ComplexImage, RealToGray> transform(
-        &grayImage,
-        &spatialImage,
-        RealToGray(spatialImage.getDimension())
-      );
-      fout << MESSAGE("Converting image: ComplexImage->GrayImage") << ' '
-           << '(' << TypeInfo::getTypename(transform) << ')' << ENDL;
-      transform();
+           << timer.getLiveMicroseconds() << MESSAGE(" microseconds") << ENDL;
     }
-    
-    encoder.writeGray(outputFile, &grayImage);
+
+    encoder.write(outputFile, &blurredImage);
   }
-  
+
   void main() noexcept {
     fout << getFormalName() << MESSAGE(" version ") << MAJOR_VERSION << '.' << MINOR_VERSION << EOL
          << MESSAGE("Generic Image Processing Framework (Test Suite)") << EOL
          << ENDL;
-    
+
     String inputFile;
     String outputFile;
-    
+    unsigned int deviation = 8;
+
     const Array<String> arguments = getArguments();
     switch (arguments.getSize()) {
+    case 0:
+      verify();
+      return;
+    case 3:
+      deviation = UnsignedInteger::parse(arguments[2], UnsignedInteger::DEC); // the standard deviation in pixels
+      // fall through
     case 2:
       inputFile = arguments[0]; // the file name of the source image
       outputFile = arguments[1]; // the file name of the destination image
       break;
     default:
-      fout << MESSAGE("Usage: ") << getFormalName() << MESSAGE(" input output") << ENDL;
+      fout << MESSAGE("Usage: ") << getFormalName() << MESSAGE(" [input output [deviation]]") << ENDL;
+      return; // stop
+    }
+
+    if (deviation == 0) {
+      fout << MESSAGE("Deviation must be at least 1") << ENDL;
       return; // stop
     }
-    
-    blur(inputFile, outputFile);
+    blur(inputFile, outputFile, deviation);
   }
 };
 
-APPLICATION_STUB(GaussianBlur);
+APPLICATION_STUB(GaussianBlurApplication);
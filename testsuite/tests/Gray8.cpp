@@ -0,0 +1,132 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework (Test Suite)
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#include <gip/ArrayImage.h>
+#include <gip/analysis/Histogram.h>
+#include <gip/transformation/MedianFilter3x3.h>
+#include <gip/transformation/Dilate.h>
+#include <gip/transformation/Gradient.h>
+#include <base/Application.h>
+#include <base/string/FormatOutputStream.h>
+#include <base/Timer.h>
+#include <base/UnsignedInteger.h>
+
+using namespace com::azure::dev::gip;
+
+class Gray8Application : public Application {
+private:
+
+  static const unsigned int MAJOR_VERSION = 1;
+  static const unsigned int MINOR_VERSION = 0;
+public:
+
+  class Kernel {
+  public:
+
+    enum {
+      M00 = true, M01 = true, M02 = true,
+      M10 = true, M11 = true, M12 = true,
+      M20 = true, M21 = true, M22 = true
+    };
+  };
+
+  Gray8Application() noexcept
+    : Application(MESSAGE("Gray8")) {
+  }
+
+  /**
+    Fills the image with a deterministic pattern.
+  */
+  template<class IMAGE>
+  static void fillPattern(IMAGE& image) {
+    typename IMAGE::Rows rows = image.getRows();
+    unsigned int seed = 0x12345678;
+    for (typename IMAGE::Rows::RowIterator row = rows.getFirst(); row != rows.getEnd(); ++row) {
+      for (typename IMAGE::Rows::RowIterator::ElementIterator column = row.getFirst(); column != row.getEnd(); ++column) {
+        seed = seed * 1103515245 + 12345;
+        *column = (seed >> 16) & 0xff;
+      }
+    }
+  }
+
+  /**
+    Writes the elapsed time and the bandwidth of the source image.
+  */
+  void report(const String& name, uint64 microseconds, MemorySize bytes) {
+    fout << MESSAGE("  ") << name << MESSAGE(": ") << microseconds << MESSAGE(" us")
+         << MESSAGE(" (") << static_cast<uint64>(bytes/maximum<double>(microseconds, 1)) << MESSAGE(" MB/s)") << ENDL;
+  }
+
+  template<class IMAGE>
+  void benchmark(const String& name, const Dimension& dimension) {
+    typedef typename IMAGE::Pixel Pixel;
+    const MemorySize bytes = static_cast<MemorySize>(dimension.getWidth()) * dimension.getHeight() * sizeof(Pixel);
+    fout << name << MESSAGE(" (") << sizeof(Pixel) << MESSAGE(" bytes per pixel)") << ENDL;
+
+    IMAGE source(dimension);
+    IMAGE destination(dimension);
+    fillPattern(source);
+
+    {
+      Histogram<Pixel> histogram;
+      Timer timer;
+      forEach(source, histogram);
+      report(MESSAGE("Histogram"), timer.getLiveMicroseconds(), bytes);
+    }
+    {
+      BasicMedianFilter3x3<IMAGE> transform(&destination, &source);
+      Timer timer;
+      transform();
+      report(MESSAGE("MedianFilter3x3"), timer.getLiveMicroseconds(), bytes);
+    }
+    {
+      Dilate<Kernel, IMAGE> transform(&destination, &source);
+      Timer timer;
+      transform();
+      report(MESSAGE("Dilate"), timer.getLiveMicroseconds(), bytes);
+    }
+    {
+      BasicGradient<IMAGE> transform(&destination, &source);
+      Timer timer;
+      transform();
+      report(MESSAGE("Gradient"), timer.getLiveMicroseconds(), bytes);
+    }
+  }
+
+  void main() noexcept {
+    fout << getFormalName() << MESSAGE(" version ") << MAJOR_VERSION << '.' << MINOR_VERSION << EOL
+         << MESSAGE("Generic Image Processing Framework (Test Suite)") << EOL << ENDL;
+
+    unsigned int width = 1920;
+    unsigned int height = 1080;
+
+    const Array<String> arguments = getArguments();
+    switch (arguments.getSize()) {
+    case 0:
+      break;
+    case 2:
+      width = UnsignedInteger::parse(arguments[0], UnsignedInteger::DEC);
+      height = UnsignedInteger::parse(arguments[1], UnsignedInteger::DEC);
+      break;
+    default:
+      fout << MESSAGE("Usage: ") << getFormalName() << MESSAGE(" [width height]") << ENDL;
+      return; // stop
+    }
+
+    const Dimension dimension(width, height);
+    benchmark<GrayImage>(MESSAGE("GrayImage"), dimension);
+    benchmark<Gray8Image>(MESSAGE("Gray8Image"), dimension);
+  }
+};
+
+APPLICATION_STUB(Gray8Application);
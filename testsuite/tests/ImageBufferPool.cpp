@@ -0,0 +1,96 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework (Test Suite)
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#include <gip/ArrayImage.h>
+#include <gip/ImageBufferPool.h>
+#include <base/Application.h>
+#include <base/string/FormatOutputStream.h>
+
+using namespace com::azure::dev::gip;
+
+class ImageBufferPoolApplication : public Application {
+private:
+
+  static const unsigned int MAJOR_VERSION = 1;
+  static const unsigned int MINOR_VERSION = 0;
+public:
+
+  ImageBufferPoolApplication() noexcept
+    : Application(MESSAGE("ImageBufferPool")) {
+  }
+
+  void dumpStatistics(ImageBufferPool& pool) {
+    const ImageBufferPool::Statistics statistics = pool.getStatistics();
+    fout << MESSAGE("  hits=") << statistics.hits
+         << MESSAGE(" misses=") << statistics.misses
+         << MESSAGE(" releases=") << statistics.releases
+         << MESSAGE(" discards=") << statistics.discards
+         << MESSAGE(" blocksInUse=") << statistics.blocksInUse
+         << MESSAGE(" pooledBytes=") << statistics.pooledBytes << EOL;
+  }
+
+  void main() noexcept {
+    fout << getFormalName() << MESSAGE(" version ") << MAJOR_VERSION << '.' << MINOR_VERSION << EOL
+         << MESSAGE("Generic Image Processing Framework (Test Suite)") << EOL << ENDL;
+
+    Reference<ImageBufferPool> pool = new ImageBufferPool();
+
+    // blocks
+    ImageBufferPool::Block* block = pool->acquire(4096);
+    uint8* elements = block->getElements();
+    ImageBufferPool::Statistics statistics = pool->getStatistics();
+    const bool firstMiss = (statistics.hits == 0) && (statistics.misses == 1) && (statistics.blocksInUse == 1);
+    pool->release(block);
+    statistics = pool->getStatistics();
+    const bool released = (statistics.releases == 1) && (statistics.blocksInUse == 0) && (statistics.pooledBytes == 4096);
+    block = pool->acquire(4096);
+    statistics = pool->getStatistics();
+    const bool hit = (statistics.hits == 1) && (statistics.misses == 1) && (statistics.pooledBytes == 0) &&
+      (block->getElements() == elements);
+    ImageBufferPool::Block* other = pool->acquire(8192);
+    statistics = pool->getStatistics();
+    const bool otherMiss = (statistics.hits == 1) && (statistics.misses == 2);
+    pool->release(other);
+    pool->release(block);
+    fout << MESSAGE("Miss on first acquire: ") << firstMiss << EOL
+         << MESSAGE("Release: ") << released << EOL
+         << MESSAGE("Hit after release: ") << hit << EOL
+         << MESSAGE("Miss for other size: ") << otherMiss << EOL;
+    dumpStatistics(*pool);
+
+    // images
+    pool->clear();
+    pool->resetStatistics();
+    const Dimension dimension(1920, 1080);
+    {
+      ColorImage frame(dimension, ColorImage::ROW_ALIGNMENT, pool);
+      fill(frame.getElements(), frame.getNumberOfPixels(), makeColorPixel(0, 0, 0));
+    }
+    {
+      ColorImage frame(dimension, ColorImage::ROW_ALIGNMENT, pool);
+      statistics = pool->getStatistics();
+      fout << MESSAGE("Image hit after release: ")
+           << ((statistics.hits == 1) && (statistics.misses == 1) && (statistics.blocksInUse == 1)) << EOL;
+    }
+    dumpStatistics(*pool);
+
+    // returned blocks beyond the capacity are freed
+    Reference<ImageBufferPool> small = new ImageBufferPool(0);
+    small->release(small->acquire(4096));
+    statistics = small->getStatistics();
+    fout << MESSAGE("Discard beyond capacity: ")
+         << ((statistics.discards == 1) && (statistics.pooledBytes == 0)) << ENDL;
+  }
+};
+
+APPLICATION_STUB(ImageBufferPoolApplication);
@@ -0,0 +1,119 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework (Test Suite)
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#include <gip/ArrayImage.h>
+#include <gip/ImageView.h>
+#include <base/Application.h>
+#include <base/string/FormatOutputStream.h>
+#include <testsuite/Synthetic.h>
+
+using namespace com::azure::dev::gip;
+
+class ImageViewApplication : public Application {
+private:
+
+  static const unsigned int MAJOR_VERSION = 1;
+  static const unsigned int MINOR_VERSION = 0;
+public:
+
+  ImageViewApplication() noexcept
+    : Application(MESSAGE("ImageView")) {
+  }
+
+  /** Returns true if the rows of the view are the rows of the region of the image. */
+  static bool verifyRows(const ImageView<Gray8Pixel>& view, const Gray8Image& image) noexcept {
+    const Gray8Pixel* elements = image.getElements();
+    const MemorySize pitch = image.getPitch();
+    const unsigned int row = view.getOffset().getRow();
+    const unsigned int column = view.getOffset().getColumn();
+    if (view.getElements() != (elements + row * pitch + column)) {
+      return false;
+    }
+
+    ImageView<Gray8Pixel>::ReadableRows rows = view.getRows();
+    ImageView<Gray8Pixel>::ReadableRows::RowIterator current = rows.getFirst();
+    for (unsigned int y = 0; y < view.getHeight(); ++y, ++current) {
+      const Gray8Pixel* expected = elements + (row + y) * pitch + column;
+      if (&*current.getFirst() != expected) {
+        return false;
+      }
+      unsigned int columns = 0;
+      for (ImageView<Gray8Pixel>::ReadableRows::RowIterator::ElementIterator i = current.getFirst(); i != current.getEnd(); ++i) {
+        ++columns;
+      }
+      if (columns != view.getWidth()) {
+        return false;
+      }
+      for (unsigned int x = 0; x < view.getWidth(); ++x) {
+        if ((rows[y][x] != expected[x]) || (view.getElements()[y * view.getPitch() + x] != expected[x])) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  void main() noexcept {
+    fout << getFormalName() << MESSAGE(" version ") << MAJOR_VERSION << '.' << MINOR_VERSION << EOL
+         << MESSAGE("Generic Image Processing Framework (Test Suite)") << EOL << ENDL;
+
+    Gray8Image image(Dimension(37, 23), ArrayImage<Gray8Pixel>::ROW_ALIGNMENT); // padded rows
+    Synthetic::fill(image);
+    Gray8Image reference(image.getDimension(), ArrayImage<Gray8Pixel>::ROW_ALIGNMENT);
+    Synthetic::fill(reference);
+    const Gray8Image original(image); // shares the elements until the image is modified
+
+    const Region region(Point2D(5, 3), Dimension(20, 10)); // rows 5 to 14 and columns 3 to 22
+    const ImageView<Gray8Pixel> readable(&original, region);
+    fout << MESSAGE("Pitch: ") << image.getPitch() << MESSAGE(" (width ") << image.getWidth() << ')' << EOL
+         << MESSAGE("Pitch of view: ") << (readable.getPitch() == original.getPitch()) << EOL
+         << MESSAGE("Rows of view: ") << verifyRows(readable, original) << EOL;
+
+    const ImageView<Gray8Pixel> nested(readable, Region(Point2D(2, 1), Dimension(4, 3)));
+    fout << MESSAGE("Offset of nested view: ")
+         << ((nested.getOffset().getRow() == 7) && (nested.getOffset().getColumn() == 4)) << EOL
+         << MESSAGE("Rows of nested view: ") << verifyRows(nested, original) << EOL;
+
+    // writing through the view touches the region of the image only
+    ImageView<Gray8Pixel> writable(&image, region);
+    ImageView<Gray8Pixel>::Rows rows = writable.getRows();
+    for (unsigned int y = 0; y < writable.getHeight(); ++y) {
+      for (unsigned int x = 0; x < writable.getWidth(); ++x) {
+        rows[y][x] = 0;
+      }
+    }
+    bool written = true;
+    const Gray8Pixel* left = image.getElements();
+    const Gray8Pixel* right = reference.getElements();
+    for (unsigned int y = 0; y < image.getHeight(); ++y) {
+      for (unsigned int x = 0; x < image.getWidth(); ++x) {
+        const bool inside = (y >= 5) && (y < 15) && (x >= 3) && (x < 23);
+        const MemorySize index = static_cast<MemorySize>(y) * image.getPitch() + x;
+        written = written && (left[index] == (inside ? 0 : right[index]));
+      }
+    }
+    fout << MESSAGE("Written through view: ") << written << EOL
+         << MESSAGE("Original untouched: ") << Synthetic::isEqual(original, reference) << EOL;
+
+    ImageView<Gray8Pixel> readOnly(&original, region);
+    bool raised = false;
+    try {
+      readOnly.getElements();
+    } catch (ImageException&) {
+      raised = true;
+    }
+    fout << MESSAGE("Read-only view raises: ") << raised << ENDL;
+  }
+};
+
+APPLICATION_STUB(ImageViewApplication);
@@ -0,0 +1,217 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework (Test Suite)
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#include <gip/ArrayImage.h>
+#include <gip/Border.h>
+#include <gip/analysis/IntegralImage.h>
+#include <gip/transformation/BoxFilter.h>
+#include <gip/transformation/Convolution.h>
+#include <base/Application.h>
+#include <base/string/FormatOutputStream.h>
+#include <base/Timer.h>
+#include <testsuite/Synthetic.h>
+
+using namespace com::azure::dev::gip;
+
+class IntegralImageApplication : public Application {
+private:
+
+  static const unsigned int MAJOR_VERSION = 1;
+  static const unsigned int MINOR_VERSION = 0;
+public:
+
+  IntegralImageApplication() noexcept
+    : Application(MESSAGE("IntegralImage")) {
+  }
+
+  /** Returns true if the values agree (exactly for integer sums). */
+  static inline bool isClose(long long a, long long b, double) noexcept {
+    return a == b;
+  }
+
+  static inline bool isClose(double a, double b, double tolerance) noexcept {
+    return absolute(a - b) <= tolerance * (1 + absolute(b));
+  }
+
+  /** Returns true if the sums and variances of the table match the pixels of every channel for a set of regions. */
+  template<class IMAGE>
+  static bool verifyTable(const IMAGE& image) {
+    typedef typename IMAGE::Pixel Pixel;
+    typedef typename IntegralImage<IMAGE>::Sum Sum;
+    const IntegralImage<IMAGE> table(image, true);
+    const unsigned int width = image.getWidth();
+    const unsigned int height = image.getHeight();
+    unsigned int seed = 1;
+    for (unsigned int i = 0; i < 1000; ++i) {
+      seed = seed * 1103515245 + 12345;
+      const unsigned int column = (seed >> 8) % width;
+      const unsigned int row = (seed >> 16) % height;
+      seed = seed * 1103515245 + 12345;
+      const Region region(
+        Point2D(row, column),
+        Dimension(1 + (seed >> 8) % (width - column), 1 + (seed >> 16) % (height - row))
+      );
+
+      for (unsigned int channel = 0; channel < IntegralImage<IMAGE>::CHANNELS; ++channel) {
+        Sum sum = 0;
+        Sum squares = 0;
+        for (unsigned int y = row; y < region.getEndRow(); ++y) {
+          for (unsigned int x = column; x < region.getEndColumn(); ++x) {
+            const Sum value = IntegralImageTraits<Pixel>::get(image.getElements()[y * width + x], channel);
+            sum += value;
+            squares += value * value;
+          }
+        }
+        const double size = static_cast<double>(region.getDimension().getWidth()) * region.getDimension().getHeight();
+        const double mean = sum/size;
+        const double variance = squares/size - mean * mean;
+        if (!isClose(table.getSum(region, channel), sum, 1e-9) ||
+            !isClose(table.getSquaredSum(region, channel), squares, 1e-9) ||
+            (absolute(table.getMean(region, channel) - mean) > 1e-6) ||
+            (absolute(table.getVariance(region, channel) - variance) > 1e-6)) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  /** Returns the mean of the window rounded like BoxFilter. */
+  static inline long long getMean(long long sum, long long area) noexcept {
+    return (2 * sum + area)/(2 * area); // the sums are not negative
+  }
+
+  static inline double getMean(double sum, long long area) noexcept {
+    return sum/area;
+  }
+
+  /**
+    Returns true if BoxFilter matches a direct mean of the window with the
+    pixels outside the image given by the border mode.
+  */
+  template<class IMAGE>
+  static bool verifyBox(const IMAGE& source, unsigned int radius, Border::Mode mode, double tolerance) {
+    typedef typename IMAGE::Pixel Pixel;
+    typedef typename IntegralImage<IMAGE>::Sum Sum;
+    const Dimension dimension = source.getDimension();
+    const int width = dimension.getWidth();
+    const int height = dimension.getHeight();
+    const int size = 2 * radius + 1;
+    Pixel constant;
+    Synthetic::set(constant, 0x80000000U);
+    IMAGE destination(dimension);
+    Synthetic::fill(destination); // same as the source for the pixels not modified for NONE
+    {
+      BoxFilter<IMAGE> transform(&destination, &source, radius, mode, constant);
+      transform();
+    }
+
+    const Pixel* src = source.getElements();
+    const Pixel* dest = destination.getElements();
+    for (int row = 0; row < height; ++row) {
+      for (int column = 0; column < width; ++column) {
+        const bool keep = (mode == Border::NONE) &&
+          ((row < static_cast<int>(radius)) || (row >= (height - static_cast<int>(radius))) ||
+           (column < static_cast<int>(radius)) || (column >= (width - static_cast<int>(radius))));
+        for (unsigned int channel = 0; channel < IntegralImage<IMAGE>::CHANNELS; ++channel) {
+          Sum expected = IntegralImageTraits<Pixel>::get(src[row * width + column], channel);
+          if (!keep) {
+            Sum sum = 0;
+            for (int y = row - static_cast<int>(radius); y <= (row + static_cast<int>(radius)); ++y) {
+              for (int x = column - static_cast<int>(radius); x <= (column + static_cast<int>(radius)); ++x) {
+                const int sy = Border::map(y, height, mode);
+                const int sx = Border::map(x, width, mode);
+                const bool outside = (mode == Border::CONSTANT) && ((y != sy) || (x != sx));
+                sum += IntegralImageTraits<Pixel>::get(outside ? constant : src[sy * width + sx], channel);
+              }
+            }
+            expected = getMean(sum, static_cast<long long>(size) * size);
+          }
+          const Sum value = IntegralImageTraits<Pixel>::get(dest[row * width + column], channel);
+          if (!isClose(value, expected, tolerance)) {
+            return false;
+          }
+        }
+      }
+    }
+    return true;
+  }
+
+  /** Returns true if BoxFilter matches the direct mean for radii up to beyond the image size and all border modes. */
+  template<class IMAGE>
+  static bool verifyBox(const Dimension& dimension, double tolerance) {
+    IMAGE source(dimension);
+    Synthetic::fill(source);
+    static const Border::Mode MODES[] = {Border::NONE, Border::CONSTANT, Border::REPLICATE, Border::REFLECT, Border::WRAP};
+    static const unsigned int RADII[] = {1, 3, 7, 40};
+    for (const Border::Mode mode : MODES) {
+      for (const unsigned int radius : RADII) {
+        if (!verifyBox(source, radius, mode, tolerance)) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  void main() noexcept {
+    fout << getFormalName() << MESSAGE(" version ") << MAJOR_VERSION << '.' << MINOR_VERSION << EOL
+         << MESSAGE("Generic Image Processing Framework (Test Suite)") << EOL << ENDL;
+
+    const Dimension dimension(1920, 1080);
+    Gray8Image source(dimension);
+    Synthetic::fill(source);
+
+    {
+      Timer timer;
+      const IntegralImage<Gray8Image> table(source, true);
+      fout << MESSAGE("Table: ") << timer.getLiveMicroseconds() << MESSAGE(" us") << EOL
+           << MESSAGE("  Mean: ") << table.getMean(Region(Point2D(0, 0), dimension)) << EOL
+           << MESSAGE("  Variance: ") << table.getVariance(Region(Point2D(0, 0), dimension)) << ENDL;
+    }
+    fout << MESSAGE("Identical sums and variances: ") << verifyTable(source) << ENDL;
+    {
+      const Dimension small(61, 47);
+      ColorImage color(small);
+      Synthetic::fill(color);
+      FloatImage real(small);
+      Synthetic::fill(real);
+      fout << MESSAGE("Identical sums and variances (color): ") << verifyTable(color) << EOL
+           << MESSAGE("Identical sums and variances (float): ") << verifyTable(real) << EOL
+           << MESSAGE("Identical box means (gray8): ") << verifyBox<Gray8Image>(small, 0) << EOL
+           << MESSAGE("Identical box means (color): ") << verifyBox<ColorImage>(small, 0) << EOL
+           << MESSAGE("Identical box means (float): ") << verifyBox<FloatImage>(small, 1e-5) << ENDL;
+    }
+
+    Gray8Image box(dimension);
+    Gray8Image convolved(dimension);
+    {
+      ConvolutionNxN<Gray8Image, Gray8Image, SmoothUniformRectangular5x5, 5> transform(&convolved, &source);
+      transform();
+    }
+    {
+      BoxFilter<Gray8Image> transform(&box, &source, 2);
+      transform();
+    }
+    fout << MESSAGE("Identical to SmoothUniformRectangular5x5: ") << Synthetic::isEqual(box, convolved) << ENDL;
+
+    for (unsigned int radius = 1; radius <= 64; radius *= 4) {
+      BoxFilter<Gray8Image> transform(&box, &source, radius);
+      Timer timer;
+      transform();
+      fout << MESSAGE("BoxFilter radius ") << radius << MESSAGE(": ") << timer.getLiveMicroseconds() << MESSAGE(" us") << ENDL;
+    }
+  }
+};
+
+APPLICATION_STUB(IntegralImageApplication);
@@ -0,0 +1,96 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework (Test Suite)
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#include <gip/ArrayImage.h>
+#include <gip/LookupTable.h>
+#include <gip/transformation/ContrastStretch.h>
+#include <base/Application.h>
+#include <base/string/FormatOutputStream.h>
+#include <base/Timer.h>
+#include <testsuite/Synthetic.h>
+
+using namespace com::azure::dev::gip;
+
+class LookupTableApplication : public Application {
+private:
+
+  static const unsigned int MAJOR_VERSION = 1;
+  static const unsigned int MINOR_VERSION = 0;
+public:
+
+  LookupTableApplication() noexcept
+    : Application(MESSAGE("LookupTable")) {
+  }
+
+  void main() noexcept {
+    fout << getFormalName() << MESSAGE(" version ") << MAJOR_VERSION << '.' << MINOR_VERSION << EOL
+         << MESSAGE("Generic Image Processing Framework (Test Suite)") << EOL << ENDL;
+
+    const Dimension dimension(3840, 2160);
+    Gray8Image gray(Dimension(3839, 2160), 64); // padded rows
+    Synthetic::fill(gray);
+    ColorImage color(dimension);
+    Synthetic::fill(color);
+
+    uint8 table[256];
+    uint8 inverse[256];
+    fillStretchLookup(table, 16, 235);
+    for (unsigned int i = 0; i < 256; ++i) {
+      inverse[i] = 255 - i;
+    }
+    const LookupTable::ColorTable colorTable(table, inverse, table);
+
+    // the portable implementation is the reference
+    const CPUDispatch::Level automatic = CPUDispatch::getLevel();
+    CPUDispatch::setLevel(CPUDispatch::LEVEL_SCALAR);
+    Gray8Image grayReference(gray.getDimension(), 64);
+    ColorImage colorReference(dimension);
+    applyLookup(grayReference, gray, table);
+    applyLookup(colorReference, color, colorTable);
+
+    fout << MESSAGE("Active level: ") << CPUDispatch::getLevelName(automatic) << EOL;
+    for (unsigned int level = 0; level < CPUDispatch::LEVELS; ++level) {
+      if (level > CPUDispatch::getSupportedLevel()) {
+        fout << CPUDispatch::getLevelName(static_cast<CPUDispatch::Level>(level)) << MESSAGE(": not supported") << EOL;
+        continue;
+      }
+      CPUDispatch::setLevel(static_cast<CPUDispatch::Level>(level));
+      Gray8Image grayResult(gray.getDimension(), 64);
+      ColorImage colorResult(dimension);
+      Timer timer;
+      applyLookup(grayResult, gray, table);
+      const uint64 grayTime = timer.getLiveMicroseconds();
+      timer.start();
+      applyLookup(colorResult, color, colorTable);
+      const uint64 colorTime = timer.getLiveMicroseconds();
+      fout << CPUDispatch::getLevelName(static_cast<CPUDispatch::Level>(level))
+           << MESSAGE(": gray ") << grayTime << MESSAGE(" us (")
+           << (Synthetic::isEqual(grayReference, grayResult) ? MESSAGE("identical") : MESSAGE("DIFFERENT"))
+           << MESSAGE("), color ") << colorTime << MESSAGE(" us (")
+           << (Synthetic::isEqual(colorReference, colorResult) ? MESSAGE("identical") : MESSAGE("DIFFERENT"))
+           << ')' << EOL;
+    }
+    CPUDispatch::setLevel(automatic);
+    CPUDispatch::forEachKernel([](const char* name, CPUDispatch::Level level) {
+      fout << MESSAGE("Kernel ") << name << MESSAGE(": ") << CPUDispatch::getLevelName(level) << EOL;
+    });
+
+    // in place
+    ColorImage stretched(color);
+    ContrastStretch<ColorImage, ColorImage> stretch(&stretched, &stretched);
+    stretch();
+    fout << MESSAGE("In place contrast stretch done") << ENDL;
+  }
+};
+
+APPLICATION_STUB(LookupTableApplication);
@@ -0,0 +1,145 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework (Test Suite)
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#include <gip/ArrayImage.h>
+#include <gip/io/MappedImageFile.h>
+#include <gip/io/PGMEncoder.h>
+#include <gip/CopyOnWriteMonitor.h>
+#include <gip/analysis/Histogram.h>
+#include <gip/transformation/Flip.h>
+#include <base/Application.h>
+#include <base/string/FormatOutputStream.h>
+#include <base/Timer.h>
+#include <base/filesystem/FileSystem.h>
+#include <base/io/File.h>
+#include <base/string/InvalidFormat.h>
+#include <testsuite/Synthetic.h>
+
+using namespace com::azure::dev::gip;
+
+class MappedImageApplication : public Application {
+private:
+
+  static const unsigned int MAJOR_VERSION = 1;
+  static const unsigned int MINOR_VERSION = 0;
+public:
+
+  MappedImageApplication() noexcept
+    : Application(MESSAGE("MappedImage")) {
+  }
+
+  void histogram(const String& inputFile) {
+    Timer timer;
+    Reference<MappedImageFile> file = new MappedImageFile(inputFile, MappedImageFile::COPY_ON_WRITE);
+    const RawImageLayout& layout = file->getLayout();
+    fout << MESSAGE("Mapped file: ") << timer.getLiveMicroseconds() << MESSAGE(" microseconds") << EOL
+         << MESSAGE("Dimension: ") << layout.dimension << EOL
+         << MESSAGE("Header size: ") << layout.offset << EOL
+         << MESSAGE("Bytes per pixel: ") << layout.bytesPerPixel << ENDL;
+
+    const Gray8Image image(file); // the pixels are loaded on demand
+    Histogram<Gray8Pixel> histogram;
+    timer.start();
+    forEach(image, histogram);
+    fout << MESSAGE("Histogram: ") << timer.getLiveMicroseconds() << MESSAGE(" microseconds") << ENDL;
+
+    Gray8Image copy(image); // shares the mapping until modified
+    timer.start();
+    copy.getElements(); // private copy of the pixels
+    fout << MESSAGE("Copy on write: ") << timer.getLiveMicroseconds() << MESSAGE(" microseconds") << ENDL;
+
+    const CopyOnWriteMonitor::Statistics statistics = CopyOnWriteMonitor::getStatistics();
+    fout << MESSAGE("Copies: ") << statistics.copies << MESSAGE(" (") << statistics.bytes << MESSAGE(" bytes)") << ENDL;
+  }
+
+  /** Returns true if row i of the first image is row height - 1 - i of the second image. */
+  static bool isFlipped(const Gray8Image& a, const Gray8Image& b) noexcept {
+    if (!(a.getDimension() == b.getDimension())) {
+      return false;
+    }
+    const unsigned int height = a.getHeight();
+    for (unsigned int row = 0; row < height; ++row) {
+      const Gray8Pixel* left = a.getElements() + static_cast<MemorySize>(row) * a.getPitch();
+      const Gray8Pixel* right = b.getElements() + static_cast<MemorySize>(height - 1 - row) * b.getPitch();
+      for (unsigned int column = 0; column < a.getWidth(); ++column) {
+        if (left[column] != right[column]) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  /** Returns true if mapping the file raises InvalidFormat. */
+  static bool rejects(const String& path) noexcept {
+    try {
+      MappedImageFile file(path);
+    } catch (InvalidFormat&) {
+      return true;
+    }
+    return false;
+  }
+
+  /** Maps a graymap written by PGMEncoder and compares the pixels with the written image. */
+  void verify(const String& path) {
+    Gray8Image image(Dimension(641, 479));
+    Synthetic::fill(image);
+    PGMEncoder encoder;
+    encoder.writeGray(path, &image);
+
+    {
+      // the rows are used in place in the order of the file so the image is upside down
+      Reference<MappedImageFile> file = new MappedImageFile(path);
+      const Gray8Image mapped(file);
+      fout << MESSAGE("Used in place: ") << (mapped.getElements() == file->getBytes()) << EOL
+           << MESSAGE("Upside down: ") << isFlipped(image, mapped) << EOL;
+
+      // a private copy restores the usual orientation
+      Reference<MappedImageFile> writeable = new MappedImageFile(path, MappedImageFile::COPY_ON_WRITE);
+      Gray8Image flipped(writeable);
+      Flip<Gray8Image> transform(&flipped);
+      transform();
+      fout << MESSAGE("Identical to written image after flip: ") << Synthetic::isEqual(image, flipped) << EOL
+           << MESSAGE("Mapping unchanged: ") << isFlipped(image, Gray8Image(writeable)) << ENDL;
+    }
+    FileSystem::removeFile(path);
+
+    // portable pixmaps have 3-byte pixels which do not match ColorPixel
+    {
+      static const char PIXMAP[] = "P6\n2 1\n255\n\x10\x20\x30\x40\x50\x60";
+      File file(path, File::WRITE, File::CREATE);
+      file.write(reinterpret_cast<const uint8*>(PIXMAP), sizeof(PIXMAP) - 1);
+    }
+    fout << MESSAGE("Pixmap rejected: ") << rejects(path) << ENDL;
+    FileSystem::removeFile(path);
+  }
+
+  void main() noexcept {
+    fout << getFormalName() << MESSAGE(" version ") << MAJOR_VERSION << '.' << MINOR_VERSION << EOL
+         << MESSAGE("Generic Image Processing Framework (Test Suite)") << EOL << ENDL;
+
+    const Array<String> arguments = getArguments();
+    switch (arguments.getSize()) {
+    case 0:
+      verify(MESSAGE("gip_mapped.pgm"));
+      break;
+    case 1:
+      histogram(arguments[0]); // binary PGM file
+      break;
+    default:
+      fout << MESSAGE("Usage: ") << getFormalName() << MESSAGE(" [input]") << ENDL;
+    }
+  }
+};
+
+APPLICATION_STUB(MappedImageApplication);
@@ -0,0 +1,67 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework (Test Suite)
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#include <gip/ArrayImage.h>
+#include <gip/Metrics.h>
+#include <gip/transformation/ContrastStretch.h>
+#include <gip/transformation/Flip.h>
+#include <gip/transformation/MedianFilter3x3.h>
+#include <base/Application.h>
+#include <base/string/FormatOutputStream.h>
+#include <testsuite/Synthetic.h>
+
+using namespace com::azure::dev::gip;
+
+class MetricsApplication : public Application {
+private:
+
+  static const unsigned int MAJOR_VERSION = 1;
+  static const unsigned int MINOR_VERSION = 0;
+public:
+
+  MetricsApplication() noexcept
+    : Application(MESSAGE("Metrics")) {
+  }
+
+  void main() noexcept {
+    fout << getFormalName() << MESSAGE(" version ") << MAJOR_VERSION << '.' << MINOR_VERSION << EOL
+         << MESSAGE("Generic Image Processing Framework (Test Suite)") << EOL << ENDL;
+
+    const Dimension dimension(1920, 1080);
+    Gray8Image source(dimension);
+    Synthetic::fill(source);
+    ColorImage color(dimension);
+    Synthetic::fill(color);
+
+    // not recorded
+    Metrics::setEnabled(false);
+    Gray8Image filtered(dimension);
+    Gray8MedianFilter3x3 median(&filtered, &source);
+    median();
+
+    Metrics::setEnabled(true);
+    Metrics::reset();
+    for (unsigned int i = 0; i < 4; ++i) {
+      median();
+    }
+    Flip<Gray8Image> flip(&filtered);
+    flip();
+    ContrastStretch<ColorImage, ColorImage> stretch(&color, &color);
+    stretch();
+
+    fout << MESSAGE("Text:") << EOL << Metrics::getText() << EOL
+         << MESSAGE("JSON:") << EOL << Metrics::getJSON() << ENDL;
+  }
+};
+
+APPLICATION_STUB(MetricsApplication);
@@ -0,0 +1,153 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework (Test Suite)
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#include <gip/ArrayImage.h>
+#include <gip/ThreadPool.h>
+#include <gip/ImageException.h>
+#include <gip/analysis/traverse.h>
+#include <gip/analysis/Histogram.h>
+#include <gip/analysis/MinimumMaximum.h>
+#include <base/Application.h>
+#include <base/string/FormatOutputStream.h>
+#include <base/Timer.h>
+#include <base/UnsignedInteger.h>
+
+using namespace com::azure::dev::gip;
+
+class ParallelApplication : public Application {
+private:
+
+  static const unsigned int MAJOR_VERSION = 1;
+  static const unsigned int MINOR_VERSION = 0;
+public:
+
+  /** Maps the pixels through a lookup table. */
+  class Lookup : public UnaryOperation<Gray8Pixel, Gray8Pixel> {
+  private:
+
+    Gray8Pixel table[256];
+  public:
+
+    Lookup() noexcept {
+      for (unsigned int i = 0; i < 256; ++i) {
+        table[i] = 255 - i;
+      }
+    }
+
+    inline Gray8Pixel operator()(const Gray8Pixel& value) const noexcept {
+      return table[value];
+    }
+  };
+
+  /** Raises an exception for one of the parts. */
+  class Failing : public ThreadPool::Task {
+  public:
+
+    void execute(unsigned int part) {
+      if (part == 0) {
+        throw Exception("Part failed");
+      }
+    }
+  };
+
+  /** Returns true if executing the failing task raises ImageException. */
+  static bool raises(ThreadPool& pool, unsigned int parts) noexcept {
+    Failing task;
+    try {
+      pool.execute(task, parts);
+    } catch (ImageException&) {
+      return true;
+    } catch (...) {
+    }
+    return false;
+  }
+
+  ParallelApplication() noexcept
+    : Application(MESSAGE("Parallel")) {
+  }
+
+  void main() noexcept {
+    fout << getFormalName() << MESSAGE(" version ") << MAJOR_VERSION << '.' << MINOR_VERSION << EOL
+         << MESSAGE("Generic Image Processing Framework (Test Suite)") << EOL << ENDL;
+
+    unsigned int threads = 0;
+    const Array<String> arguments = getArguments();
+    switch (arguments.getSize()) {
+    case 0:
+      break;
+    case 1:
+      threads = UnsignedInteger::parse(arguments[0], UnsignedInteger::DEC);
+      break;
+    default:
+      fout << MESSAGE("Usage: ") << getFormalName() << MESSAGE(" [threads]") << ENDL;
+      return; // stop
+    }
+
+    ThreadPool pool(threads);
+    const Dimension dimension(3840, 2160);
+    Gray8Image source(dimension);
+    Gray8Image serial(dimension);
+    Gray8Image parallel(dimension);
+    fill(source.getElements(), source.getNumberOfPixels(), static_cast<Gray8Pixel>(0x5a));
+    Lookup lookup;
+
+    Timer timer;
+    fillWithUnary(serial, source, lookup);
+    const uint64 serialTime = timer.getLiveMicroseconds();
+
+    timer.start();
+    parallelFillWithUnary(parallel, source, lookup, 0, pool);
+    const uint64 parallelTime = timer.getLiveMicroseconds();
+
+    bool identical = true;
+    const Gray8Pixel* left = serial.getElements();
+    const Gray8Pixel* right = parallel.getElements();
+    for (MemorySize i = 0; i < serial.getNumberOfPixels(); ++i) {
+      identical = identical && (left[i] == right[i]);
+    }
+    fout << MESSAGE("Threads: ") << pool.getNumberOfThreads() << EOL
+         << MESSAGE("Serial: ") << serialTime << MESSAGE(" us") << EOL
+         << MESSAGE("Parallel: ") << parallelTime << MESSAGE(" us") << EOL
+         << MESSAGE("Identical: ") << identical << ENDL;
+
+    Histogram<Gray8Pixel> serialHistogram;
+    timer.start();
+    forEach(serial, serialHistogram);
+    const uint64 serialHistogramTime = timer.getLiveMicroseconds();
+
+    Histogram<Gray8Pixel> parallelHistogram;
+    MinimumMaximum<Gray8Pixel> minmax;
+    timer.start();
+    reduce(parallel, parallelHistogram, 0, pool);
+    const uint64 parallelHistogramTime = timer.getLiveMicroseconds();
+    reduce(parallel, minmax, 0, pool);
+
+    bool identicalHistograms = true;
+    const MemorySize* serialBins = serialHistogram.getHistogram().getElements();
+    const MemorySize* parallelBins = parallelHistogram.getHistogram().getElements();
+    for (MemorySize i = 0; i < serialHistogram.getHistogram().getSize(); ++i) {
+      identicalHistograms = identicalHistograms && (serialBins[i] == parallelBins[i]);
+    }
+    fout << MESSAGE("Serial histogram: ") << serialHistogramTime << MESSAGE(" us") << EOL
+         << MESSAGE("Parallel histogram: ") << parallelHistogramTime << MESSAGE(" us") << EOL
+         << MESSAGE("Identical histograms: ") << identicalHistograms << EOL
+         << MESSAGE("Minimum: ") << minmax.getMinimum() << EOL
+         << MESSAGE("Maximum: ") << minmax.getMaximum() << EOL;
+
+    // the calling thread alone executes a single part
+    fout << MESSAGE("Failure of serial task: ") << raises(pool, 1) << EOL
+         << MESSAGE("Failure of parallel task: ") << raises(pool, 64) << ENDL;
+  }
+};
+
+APPLICATION_STUB(ParallelApplication);
@@ -0,0 +1,96 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework (Test Suite)
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#include <gip/ArrayImage.h>
+#include <gip/transformation/Pipeline.h>
+#include <gip/transformation/MedianFilter3x3.h>
+#include <gip/transformation/Gradient.h>
+#include <base/Application.h>
+#include <base/string/FormatOutputStream.h>
+#include <base/Timer.h>
+#include <testsuite/Synthetic.h>
+
+using namespace com::azure::dev::gip;
+
+class PipelineApplication : public Application {
+private:
+
+  static const unsigned int MAJOR_VERSION = 1;
+  static const unsigned int MINOR_VERSION = 0;
+public:
+
+  /** Inverts the pixels. */
+  class Invert : public UnaryOperation<Gray8Pixel, Gray8Pixel> {
+  public:
+
+    inline Gray8Pixel operator()(const Gray8Pixel& value) const noexcept {
+      return 255 - value;
+    }
+  };
+
+  PipelineApplication() noexcept
+    : Application(MESSAGE("Pipeline")) {
+  }
+
+  void main() noexcept {
+    fout << getFormalName() << MESSAGE(" version ") << MAJOR_VERSION << '.' << MINOR_VERSION << EOL
+         << MESSAGE("Generic Image Processing Framework (Test Suite)") << EOL << ENDL;
+
+    const Dimension dimension(3840, 2160);
+    Gray8Image source(dimension);
+    Synthetic::fill(source);
+
+    Gray8Image filtered(dimension);
+    Gray8Image inverted(dimension);
+    Gray8Image serial(dimension);
+    Invert invert;
+
+    // one full image pass per stage
+    Timer timer;
+    {
+      Gray8MedianFilter3x3 median(&filtered, &source);
+      median();
+      fillWithUnary(inverted, filtered, invert);
+      Gray8Gradient gradient(&serial, &inverted);
+      gradient();
+    }
+    const uint64 serialTime = timer.getLiveMicroseconds();
+
+    // the pipeline has its own intermediate images so it cannot pick up the results of the serial pass
+    const Gray8Pixel SENTINEL = 0x5a;
+    Gray8Image bandFiltered(dimension);
+    Gray8Image bandInverted(dimension);
+    Gray8Image banded(dimension);
+    fill(bandFiltered.getElements(), bandFiltered.getNumberOfPixels(), SENTINEL);
+    fill(bandInverted.getElements(), bandInverted.getNumberOfPixels(), SENTINEL);
+    fill(banded.getElements(), banded.getNumberOfPixels(), SENTINEL);
+    Gray8MedianFilter3x3 median(&bandFiltered, &source);
+    Gray8Gradient gradient(&banded, &bandInverted);
+    Pipeline pipeline;
+    pipeline.add(median);
+    pipeline.add(bandInverted, bandFiltered, invert);
+    pipeline.add(gradient);
+    timer.start();
+    pipeline();
+    const uint64 pipelineTime = timer.getLiveMicroseconds();
+
+    fout << MESSAGE("Band height: ") << pipeline.getBandHeight() << EOL
+         << MESSAGE("Stage by stage: ") << serialTime << MESSAGE(" us") << EOL
+         << MESSAGE("Pipeline: ") << pipelineTime << MESSAGE(" us") << EOL
+         << MESSAGE("Identical: ") << Synthetic::isEqual(serial, banded) << EOL
+         << MESSAGE("Identical intermediates: ")
+         << (Synthetic::isEqual(filtered, bandFiltered) && Synthetic::isEqual(inverted, bandInverted)) << ENDL;
+  }
+};
+
+APPLICATION_STUB(PipelineApplication);
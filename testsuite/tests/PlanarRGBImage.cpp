@@ -0,0 +1,82 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework (Test Suite)
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#include <gip/ArrayImage.h>
+#include <gip/PlanarRGBImage.h>
+#include <gip/transformation/Interleave.h>
+#include <base/Application.h>
+#include <base/string/FormatOutputStream.h>
+#include <base/Timer.h>
+#include <testsuite/Synthetic.h>
+
+using namespace com::azure::dev::gip;
+
+class PlanarRGBImageApplication : public Application {
+private:
+
+  static const unsigned int MAJOR_VERSION = 1;
+  static const unsigned int MINOR_VERSION = 0;
+public:
+
+  PlanarRGBImageApplication() noexcept
+    : Application(MESSAGE("PlanarRGBImage")) {
+  }
+
+  /** Returns true if the planes hold the components of the interleaved image. */
+  static bool verifyPlanes(const PlanarColorImage& planar, const ColorImage& image) noexcept {
+    const PlanarColorImage::Plane red = planar.getRed();
+    const PlanarColorImage::Plane green = planar.getGreen();
+    const PlanarColorImage::Plane blue = planar.getBlue();
+    for (unsigned int row = 0; row < image.getHeight(); ++row) {
+      const ColorPixel* src = image.getElements() + static_cast<MemorySize>(row) * image.getPitch();
+      const MemorySize offset = static_cast<MemorySize>(row) * planar.getPitch();
+      for (unsigned int column = 0; column < image.getWidth(); ++column) {
+        if ((red.getElements()[offset + column] != src[column].red) ||
+            (green.getElements()[offset + column] != src[column].green) ||
+            (blue.getElements()[offset + column] != src[column].blue)) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  void main() noexcept {
+    fout << getFormalName() << MESSAGE(" version ") << MAJOR_VERSION << '.' << MINOR_VERSION << EOL
+         << MESSAGE("Generic Image Processing Framework (Test Suite)") << EOL << ENDL;
+
+    const Dimension dimension(1921, 1081); // the planes have padded rows
+    ColorImage source(dimension);
+    Synthetic::fill(source);
+
+    PlanarColorImage planar(dimension);
+    ColorImage interleaved(dimension, ArrayImage<ColorPixel>::ROW_ALIGNMENT);
+    {
+      Deinterleave<PlanarColorImage::Component> transform(&planar, &source);
+      Timer timer;
+      transform();
+      fout << MESSAGE("Deinterleave: ") << timer.getLiveMicroseconds() << MESSAGE(" us") << EOL;
+    }
+    {
+      Interleave<PlanarColorImage::Component> transform(&interleaved, &planar);
+      Timer timer;
+      transform();
+      fout << MESSAGE("Interleave: ") << timer.getLiveMicroseconds() << MESSAGE(" us") << EOL;
+    }
+    fout << MESSAGE("Pitch of planes: ") << planar.getPitch() << MESSAGE(" (width ") << planar.getWidth() << ')' << EOL
+         << MESSAGE("Identical planes: ") << verifyPlanes(planar, source) << EOL
+         << MESSAGE("Identical round trip: ") << Synthetic::isEqual(source, interleaved) << ENDL;
+  }
+};
+
+APPLICATION_STUB(PlanarRGBImageApplication);
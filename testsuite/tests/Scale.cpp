@@ -40,9 +40,7 @@ public:
     BMPEncoder encoder;
     
     fout << MESSAGE("Importing image with encoder: ") << encoder.getDescription() << ENDL;
-    ColorImage* image = encoder.read(inputFile);
-    ColorImage originalImage(*image);
-    delete image;
+    ColorImage originalImage = encoder.readImage(inputFile);
     
     ColorImage finalImage(dimension);
     
@@ -52,6 +50,23 @@ public:
       Timer timer;
       transform();
       fout << MESSAGE("Time elapsed for scale: ") << timer.getLiveMicroseconds() << MESSAGE(" microseconds") << EOL;
+
+      // scale again in tiles of 64x64 pixels
+      ColorImage tiledImage(dimension);
+      LinearScale tiled(&tiledImage, &originalImage);
+      for (unsigned int row = 0; row < dimension.getHeight(); row += 64) {
+        for (unsigned int column = 0; column < dimension.getWidth(); column += 64) {
+          const Dimension tile(minimum(64U, dimension.getWidth() - column), minimum(64U, dimension.getHeight() - row));
+          tiled(Region(Point2D(row, column), tile));
+        }
+      }
+      bool identical = true;
+      const ColorPixel* left = finalImage.getElements();
+      const ColorPixel* right = tiledImage.getElements();
+      for (MemorySize i = 0; i < finalImage.getNumberOfPixels(); ++i) {
+        identical = identical && (left[i].red == right[i].red) && (left[i].green == right[i].green) && (left[i].blue == right[i].blue);
+      }
+      fout << MESSAGE("Identical in tiles: ") << identical << ENDL;
     }
 
     fout << MESSAGE("Exporting image with encoder: ") << encoder.getDescription() << ENDL;
@@ -0,0 +1,124 @@
+/***************************************************************************
+    Generic Image Processing (GIP) Framework (Test Suite)
+    A framework for developing image processing applications
+
+    See COPYRIGHT.txt for details.
+
+    This framework is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    For the licensing terms refer to the file 'LICENSE'.
+ ***************************************************************************/
+
+#include <gip/ArrayImage.h>
+#include <gip/TileScheduler.h>
+#include <gip/CopyOnWriteMonitor.h>
+#include <gip/transformation/MedianFilter3x3.h>
+#include <base/Application.h>
+#include <base/string/FormatOutputStream.h>
+#include <base/Timer.h>
+#include <base/UnsignedInteger.h>
+#include <testsuite/Synthetic.h>
+
+using namespace com::azure::dev::gip;
+
+class TileSchedulerApplication : public Application {
+private:
+
+  static const unsigned int MAJOR_VERSION = 1;
+  static const unsigned int MINOR_VERSION = 0;
+public:
+
+  TileSchedulerApplication() noexcept
+    : Application(MESSAGE("TileScheduler")) {
+  }
+
+  void dumpStatistics(const TileScheduler& scheduler) {
+    for (unsigned int i = 0; i < scheduler.getNumberOfWorkers(); ++i) {
+      const TileScheduler::WorkerStatistics statistics = scheduler.getStatistics(i);
+      fout << MESSAGE("  Worker ") << i << MESSAGE(": tiles=") << statistics.tiles
+           << MESSAGE(" steals=") << statistics.steals
+           << MESSAGE(" busy=") << statistics.busyMicroseconds << MESSAGE(" us")
+           << MESSAGE(" idle=") << statistics.idleMicroseconds << MESSAGE(" us") << EOL;
+    }
+    fout << FLUSH;
+  }
+
+  void main() noexcept {
+    fout << getFormalName() << MESSAGE(" version ") << MAJOR_VERSION << '.' << MINOR_VERSION << EOL
+         << MESSAGE("Generic Image Processing Framework (Test Suite)") << EOL << ENDL;
+
+    unsigned int threads = 0;
+    const Array<String> arguments = getArguments();
+    switch (arguments.getSize()) {
+    case 0:
+      break;
+    case 1:
+      threads = UnsignedInteger::parse(arguments[0], UnsignedInteger::DEC);
+      break;
+    default:
+      fout << MESSAGE("Usage: ") << getFormalName() << MESSAGE(" [threads]") << ENDL;
+      return; // stop
+    }
+
+    ThreadPool pool(threads);
+    TileScheduler scheduler(pool);
+    const Dimension dimension(3840, 2160);
+    Gray8Image source(dimension);
+    Synthetic::fill(source);
+
+    Gray8Image serial(dimension);
+    Gray8Image tiled(dimension);
+    Timer timer;
+    Gray8MedianFilter3x3 serialMedian(&serial, &source);
+    serialMedian();
+    const uint64 serialTime = timer.getLiveMicroseconds();
+
+    Gray8MedianFilter3x3 tiledMedian(&tiled, &source);
+    timer.start();
+    scheduler.apply(tiledMedian);
+    const uint64 tiledTime = timer.getLiveMicroseconds();
+
+    fout << MESSAGE("Workers: ") << scheduler.getNumberOfWorkers() << EOL
+         << MESSAGE("Serial median: ") << serialTime << MESSAGE(" us") << EOL
+         << MESSAGE("Tiled median: ") << tiledTime << MESSAGE(" us") << EOL
+         << MESSAGE("Identical: ") << Synthetic::isEqual(serial, tiled) << ENDL;
+    dumpStatistics(scheduler);
+
+    // the destination shares its elements so it must be copied exactly once
+    Gray8Image shared(dimension);
+    Synthetic::fill(shared);
+    const Gray8Image original(shared);
+    Gray8Image expected(dimension);
+    Synthetic::fill(expected);
+    Gray8MedianFilter3x3 sharedMedian(&shared, &source);
+    CopyOnWriteMonitor::resetStatistics();
+    scheduler.apply(sharedMedian);
+    fout << MESSAGE("Shared destination copied once: ") << (CopyOnWriteMonitor::getStatistics().copies == 1) << EOL
+         << MESSAGE("Shared destination identical: ") << Synthetic::isEqual(serial, shared) << EOL
+         << MESSAGE("Original unchanged: ") << Synthetic::isEqual(expected, original) << ENDL;
+
+    // cost grows with the row so static bands would be unbalanced
+    scheduler.resetStatistics();
+    Gray8Image skewed(dimension);
+    Gray8Pixel* elements = skewed.getElements(); // copy-on-write happens here
+    const Gray8Pixel* src = source.getElements();
+    timer.start();
+    scheduler.forEachTile(dimension, [&](const Region& tile) {
+      for (unsigned int row = tile.getOffset().getRow(); row < tile.getEndRow(); ++row) {
+        for (unsigned int column = tile.getOffset().getColumn(); column < tile.getEndColumn(); ++column) {
+          unsigned int value = src[row * source.getPitch() + column];
+          for (unsigned int i = row/64; i > 0; --i) {
+            value = (value * 75 + 74) % 257;
+          }
+          elements[row * skewed.getPitch() + column] = static_cast<Gray8Pixel>(value);
+        }
+      }
+    });
+    fout << MESSAGE("Skewed: ") << timer.getLiveMicroseconds() << MESSAGE(" us") << ENDL;
+    dumpStatistics(scheduler);
+  }
+};
+
+APPLICATION_STUB(TileSchedulerApplication);
@@ -13,6 +13,7 @@
 
 #include <gip/io/BMPEncoder.h>
 #include <gip/transformation/Transpose.h>
+#include <gip/transformation/Tiling.h>
 #include <gip/ArrayImage.h>
 #include <base/Application.h>
 #include <base/string/FormatOutputStream.h>
@@ -36,9 +37,7 @@ public:
     BMPEncoder encoder;
     
     fout << MESSAGE("Importing image with encoder: ") << encoder.getDescription() << ENDL;
-    ColorImage* image = encoder.read(inputFile);
-    ColorImage originalImage(*image);
-    delete image;
+    ColorImage originalImage = encoder.readImage(inputFile);
 
     ColorImage finalImage(Dimension(originalImage.getHeight(), originalImage.getWidth()));
     {
@@ -49,6 +48,20 @@ public:
       fout << MESSAGE("Time elapsed for transpose: ") << timer.getLiveMicroseconds() << MESSAGE(" microseconds") << EOL;
     }
 
+    {
+      TiledColorImage tiledImage(originalImage.getDimension());
+      Tiling<ColorPixel> tiling(&tiledImage, &originalImage);
+      tiling();
+      TiledColorImage tiledFinalImage(finalImage.getDimension());
+      Transpose<TiledColorImage, TiledColorImage> transform(&tiledFinalImage, &tiledImage);
+      fout << MESSAGE("Transforming image: ") << ' ' << '(' << TypeInfo::getTypename(transform) << ')' << ENDL;
+      Timer timer;
+      transform();
+      fout << MESSAGE("Time elapsed for tiled transpose: ") << timer.getLiveMicroseconds() << MESSAGE(" microseconds") << EOL;
+      Untiling<ColorPixel> untiling(&finalImage, &tiledFinalImage);
+      untiling();
+    }
+
     fout << MESSAGE("Exporting image with encoder: ") << encoder.getDescription() << ENDL;
     encoder.write(outputFile, &finalImage);
   }